@@ -0,0 +1,53 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BENCH_UTILS_HPP_
+#define BENCH_UTILS_HPP_
+
+// std
+#include <cmath>
+#include <vector>
+
+// romea
+#include "romea_core_path/PathWayPoint2D.hpp"
+#include "romea_core_common/geometry/PoseAndTwist2D.hpp"
+
+//-----------------------------------------------------------------------------
+// Slowly meandering line sampled every step meters, close to a recorded field row
+inline std::vector<romea::core::PathWayPoint2D> makeWayPoints(
+  size_t numberOfPoints,
+  double step = 0.1,
+  double speed = 1.)
+{
+  std::vector<romea::core::PathWayPoint2D> wayPoints;
+  wayPoints.reserve(numberOfPoints);
+  for (size_t n = 0; n < numberOfPoints; ++n) {
+    double x = n * step;
+    wayPoints.emplace_back(Eigen::Vector2d{x, 2. * std::sin(x / 20.)}, speed);
+  }
+  return wayPoints;
+}
+
+//-----------------------------------------------------------------------------
+// Vehicle pose slightly beside the path at curvilinear abscissa ~ x
+inline romea::core::Pose2D makeVehiclePose(double x, double lateralOffset = 0.2)
+{
+  romea::core::Pose2D pose;
+  pose.position.x() = x;
+  pose.position.y() = 2. * std::sin(x / 20.) + lateralOffset;
+  pose.yaw = std::atan(0.1 * std::cos(x / 20.));
+  return pose;
+}
+
+#endif  // BENCH_UTILS_HPP_
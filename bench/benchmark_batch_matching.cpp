@@ -0,0 +1,119 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Matching of large batches of poses on their nearest curves, dominated by the
+// construction of the matched points once the candidate curve is known.
+
+// std
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathSection2D.hpp"
+#include "romea_core_path/PathSectionMatching2D.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+static std::vector<romea::core::Pose2D> makeVehiclePoses(size_t numberOfPoses, double length)
+{
+  std::vector<romea::core::Pose2D> poses;
+  poses.reserve(numberOfPoses);
+  for (size_t n = 0; n < numberOfPoses; ++n) {
+    poses.push_back(makeVehiclePose(1. + (length - 2.) * n / numberOfPoses));
+  }
+  return poses;
+}
+
+//-----------------------------------------------------------------------------
+static void BM_CurveBatchMatching(benchmark::State & state)
+{
+  romea::core::PathSection2D section(3.);
+  section.addWayPoints(makeWayPoints(1000));
+  auto poses = makeVehiclePoses(state.range(0), section.getLength());
+
+  std::vector<const romea::core::PathCurve2D *> curves;
+  for (const auto & pose : poses) {
+    curves.push_back(&section.getCurve(section.findIndex(pose.position.x())));
+  }
+
+  for (auto _ : state) {
+    for (size_t n = 0; n < poses.size(); ++n) {
+      benchmark::DoNotOptimize(romea::core::match(*curves[n], poses[n], 1.));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * poses.size());
+}
+
+//-----------------------------------------------------------------------------
+// Results kept for the whole batch, as matched points with a propagated
+// covariance or as compact Frenet poses
+static void BM_CurveBatchFrenetPoses(benchmark::State & state)
+{
+  romea::core::PathSection2D section(3.);
+  section.addWayPoints(makeWayPoints(1000));
+  auto poses = makeVehiclePoses(state.range(0), section.getLength());
+  bool compact = state.range(1);
+
+  std::vector<const romea::core::PathCurve2D *> curves;
+  for (const auto & pose : poses) {
+    curves.push_back(&section.getCurve(section.findIndex(pose.position.x())));
+  }
+
+  std::vector<romea::core::PathMatchedPoint2D> matchedPoints;
+  std::vector<romea::core::PathCompactFrenetPose2D> frenetPoses;
+  romea::core::PathCompactFrenetPose2D frenetPose;
+  for (auto _ : state) {
+    matchedPoints.clear();
+    frenetPoses.clear();
+    for (size_t n = 0; n < poses.size(); ++n) {
+      if (compact) {
+        if (romea::core::match(*curves[n], poses[n], 1., frenetPose)) {
+          frenetPoses.push_back(frenetPose);
+        }
+      } else if (auto matchedPoint = romea::core::match(*curves[n], poses[n], 1.)) {
+        matchedPoints.push_back(*matchedPoint);
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * poses.size());
+  state.counters["bytes_per_result"] = compact ?
+    sizeof(romea::core::PathCompactFrenetPose2D) : sizeof(romea::core::PathMatchedPoint2D);
+}
+
+//-----------------------------------------------------------------------------
+static void BM_SectionBatchMatching(benchmark::State & state)
+{
+  romea::core::PathSection2D section(3.);
+  section.addWayPoints(makeWayPoints(1000));
+  auto poses = makeVehiclePoses(state.range(0), section.getLength());
+
+  for (auto _ : state) {
+    for (const auto & pose : poses) {
+      benchmark::DoNotOptimize(romea::core::match(section, pose, 1., 0.2, 1., state.range(1)));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * poses.size());
+}
+
+BENCHMARK(BM_CurveBatchMatching)->Arg(10000);
+BENCHMARK(BM_CurveBatchFrenetPoses)->Args({10000, 0})->Args({10000, 1});
+BENCHMARK(BM_SectionBatchMatching)->Args({10000, 1})->Args({10000, 0});
+
+BENCHMARK_MAIN();
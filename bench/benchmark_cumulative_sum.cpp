@@ -0,0 +1,81 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Abscissae of a 20 km path sampled every centimetre, summed naively and with
+// compensation, by successive increments and in bulk with a number of threads.
+
+// std
+#include <cmath>
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// Eigen
+#include <Eigen/Core>
+
+// romea
+#include "romea_core_path/CumulativeSum.hpp"
+
+//-----------------------------------------------------------------------------
+static std::vector<double> makeDeltas()
+{
+  std::vector<double> deltas(2000000);
+  for (size_t n = 0; n < deltas.size(); ++n) {
+    deltas[n] = 0.01 + 0.001 * std::sin(n * 0.1);
+  }
+  return deltas;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Summation>
+static void BM_Increment(benchmark::State & state)
+{
+  auto deltas = makeDeltas();
+
+  for (auto _ : state) {
+    romea::core::CumulativeSum<double, Eigen::aligned_allocator<double>, Summation> cumsum;
+    cumsum.reserve(deltas.size() + 1);
+    for (const double & delta : deltas) {
+      cumsum.increment(delta);
+    }
+    benchmark::DoNotOptimize(cumsum.finalValue());
+  }
+  state.SetItemsProcessed(state.iterations() * deltas.size());
+}
+
+//-----------------------------------------------------------------------------
+template<typename Summation>
+static void BM_AssignFromDeltas(benchmark::State & state)
+{
+  auto deltas = makeDeltas();
+
+  for (auto _ : state) {
+    romea::core::CumulativeSum<double, Eigen::aligned_allocator<double>, Summation> cumsum;
+    cumsum.assignFromDeltas(deltas.data(), deltas.size(), state.range(0));
+    benchmark::DoNotOptimize(cumsum.finalValue());
+  }
+  state.SetItemsProcessed(state.iterations() * deltas.size());
+}
+
+BENCHMARK_TEMPLATE(BM_Increment, romea::core::NaiveSummation)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Increment, romea::core::CompensatedSummation)
+->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_AssignFromDeltas, romea::core::NaiveSummation)
+->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_AssignFromDeltas, romea::core::CompensatedSummation)
+->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,65 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Cost of fitting second and third degree curves and of the nearest abscissa
+// search on them (closed form cubic vs bracketed Newton on the quintic).
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathSection2D.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+static void BM_FitCurves(benchmark::State & state)
+{
+  romea::core::PathSection2D section(state.range(1));
+  section.setPolynomialDegree(state.range(0));
+  section.addWayPoints(makeWayPoints(10000));
+
+  for (auto _ : state) {
+    section.setPolynomialDegree(state.range(0));
+    for (size_t n = 0; n < section.size(); ++n) {
+      benchmark::DoNotOptimize(section.getCurve(n));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * section.size());
+}
+
+//-----------------------------------------------------------------------------
+static void BM_FindNearestCurvilinearAbscissa(benchmark::State & state)
+{
+  romea::core::PathSection2D section(state.range(1));
+  section.setPolynomialDegree(state.range(0));
+  section.addWayPoints(makeWayPoints(10000));
+
+  size_t n = 100;
+  for (auto _ : state) {
+    const auto & curve = section.getCurve(n);
+    auto pose = makeVehiclePose(section.getX()[n]);
+    benchmark::DoNotOptimize(curve.findNearestCurvilinearAbscissa(pose.position));
+    n = n + 37 < section.size() - 100 ? n + 37 : 100;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FitCurves)->Args({2, 3})->Args({3, 3})->Args({3, 6});
+BENCHMARK(BM_FindNearestCurvilinearAbscissa)->Args({2, 3})->Args({3, 3})->Args({3, 6});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,114 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Evaluation of a path curve on many abscissae: scalar calls against the
+// batch and fused posture APIs.
+
+// std
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathSection2D.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+static romea::core::PathCurve2D makeCurve()
+{
+  romea::core::PathSection2D section(3.);
+  section.addWayPoints(makeWayPoints(1000));
+  return section.getCurve(500);
+}
+
+//-----------------------------------------------------------------------------
+static Eigen::ArrayXd makeAbscissae(const romea::core::PathCurve2D & curve, Eigen::Index size)
+{
+  const auto & interval = curve.getCurvilinearAbscissaInterval();
+  return Eigen::ArrayXd::LinSpaced(size, interval.lower(), interval.upper());
+}
+
+//-----------------------------------------------------------------------------
+static void BM_ScalarPostures(benchmark::State & state)
+{
+  auto curve = makeCurve();
+  Eigen::ArrayXd S = makeAbscissae(curve, state.range(0));
+  Eigen::ArrayXd X(S.size()), Y(S.size()), tangents(S.size()), curvatures(S.size());
+
+  for (auto _ : state) {
+    for (Eigen::Index n = 0; n < S.size(); ++n) {
+      X[n] = curve.computeX(S[n]);
+      Y[n] = curve.computeY(S[n]);
+      tangents[n] = curve.computeTangent(S[n]);
+      curvatures[n] = curve.computeCurvature(S[n]);
+    }
+    benchmark::DoNotOptimize(curvatures.data());
+  }
+  state.SetItemsProcessed(state.iterations() * S.size());
+}
+
+//-----------------------------------------------------------------------------
+static void BM_BatchPostures(benchmark::State & state)
+{
+  auto curve = makeCurve();
+  Eigen::ArrayXd S = makeAbscissae(curve, state.range(0));
+  Eigen::ArrayXd X(S.size()), Y(S.size()), tangents(S.size()), curvatures(S.size());
+
+  for (auto _ : state) {
+    curve.computePostures(S, X, Y, tangents, curvatures);
+    benchmark::DoNotOptimize(curvatures.data());
+  }
+  state.SetItemsProcessed(state.iterations() * S.size());
+}
+
+//-----------------------------------------------------------------------------
+static void BM_ScalarCurvature(benchmark::State & state)
+{
+  auto curve = makeCurve();
+  Eigen::ArrayXd S = makeAbscissae(curve, state.range(0));
+  Eigen::ArrayXd curvatures(S.size());
+
+  for (auto _ : state) {
+    for (Eigen::Index n = 0; n < S.size(); ++n) {
+      curvatures[n] = curve.computeCurvature(S[n]);
+    }
+    benchmark::DoNotOptimize(curvatures.data());
+  }
+  state.SetItemsProcessed(state.iterations() * S.size());
+}
+
+//-----------------------------------------------------------------------------
+static void BM_BatchCurvature(benchmark::State & state)
+{
+  auto curve = makeCurve();
+  Eigen::ArrayXd S = makeAbscissae(curve, state.range(0));
+  Eigen::ArrayXd curvatures(S.size());
+
+  for (auto _ : state) {
+    curve.computeCurvature(S, curvatures);
+    benchmark::DoNotOptimize(curvatures.data());
+  }
+  state.SetItemsProcessed(state.iterations() * S.size());
+}
+
+BENCHMARK(BM_ScalarPostures)->Arg(64)->Arg(4096);
+BENCHMARK(BM_BatchPostures)->Arg(64)->Arg(4096);
+BENCHMARK(BM_ScalarCurvature)->Arg(64)->Arg(4096);
+BENCHMARK(BM_BatchCurvature)->Arg(64)->Arg(4096);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Global matching on vineyard like paths made of many rows: probing every
+// section against probing the sections selected by the section tree.
+
+// std
+#include <cmath>
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/Path2D.hpp"
+#include "romea_core_path/PathMatching2D.hpp"
+#include "romea_core_path/PathSectionMatching2D.hpp"
+
+//-----------------------------------------------------------------------------
+// Rows of 50 m spaced by 2.5 m, each row being its own section
+static romea::core::Path2D makeRowsPath(size_t numberOfRows)
+{
+  romea::core::Path2D::WayPoints wayPoints(numberOfRows);
+  for (size_t row = 0; row < numberOfRows; ++row) {
+    for (size_t n = 0; n <= 100; ++n) {
+      double y = row % 2 == 0 ? 0.5 * n : 50. - 0.5 * n;
+      wayPoints[row].emplace_back(Eigen::Vector2d(2.5 * row, y), 1.);
+    }
+  }
+  return romea::core::Path2D(wayPoints, 3);
+}
+
+//-----------------------------------------------------------------------------
+static romea::core::Pose2D makeRowPose(size_t row)
+{
+  romea::core::Pose2D pose;
+  pose.position = Eigen::Vector2d(2.5 * row + 0.1, 25.);
+  pose.yaw = row % 2 == 0 ? M_PI_2 : -M_PI_2;
+  return pose;
+}
+
+//-----------------------------------------------------------------------------
+static void BM_AllSections(benchmark::State & state)
+{
+  auto path = makeRowsPath(state.range(0));
+
+  size_t n = 0;
+  for (auto _ : state) {
+    auto pose = makeRowPose((n++ * 37) % path.size());
+    for (size_t s = 0; s < path.size(); ++s) {
+      benchmark::DoNotOptimize(
+        romea::core::match(path.getSection(s), pose, 1., 0.2, 10.));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+//-----------------------------------------------------------------------------
+static void BM_SectionTree(benchmark::State & state)
+{
+  auto path = makeRowsPath(state.range(0));
+
+  size_t n = 0;
+  for (auto _ : state) {
+    auto pose = makeRowPose((n++ * 37) % path.size());
+    benchmark::DoNotOptimize(romea::core::match(path, pose, 1., 0.2, 10.));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_AllSections)->Arg(20)->Arg(200)->Arg(2000);
+BENCHMARK(BM_SectionTree)->Arg(20)->Arg(200)->Arg(2000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,124 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Nearest oriented point search of PathSection2D: linear scan of the way
+// points against the segment tree, for several research radii.
+
+// std
+#include <cmath>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathSection2D.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+// Search done by matching before the segment tree
+static size_t linearScan(
+  const romea::core::PathSection2D & section,
+  const romea::core::Pose2D & pose,
+  const romea::core::Interval<size_t> & indexRange,
+  const double & researchRadius)
+{
+  const auto & X = section.getX();
+  const auto & Y = section.getY();
+  const auto & speeds = section.getSpeeds();
+  Eigen::Vector2d dir{std::cos(pose.yaw), std::sin(pose.yaw)};
+
+  size_t nearestPointIndex = section.size();
+  double minSqDist = researchRadius * researchRadius;
+  Eigen::Vector2d curSectionDir = Eigen::Vector2d::Zero();
+  for (size_t n = indexRange.lower(); n <= indexRange.upper(); ++n) {
+    Eigen::Vector2d point(X[n], Y[n]);
+    double sqDist = (pose.position - point).squaredNorm();
+    if (sqDist < minSqDist) {
+      if (n < indexRange.upper()) {
+        curSectionDir = Eigen::Vector2d(X[n + 1], Y[n + 1]) - point;
+      }
+      if (std::signbit(dir.dot(curSectionDir)) == std::signbit(speeds[n])) {
+        minSqDist = sqDist;
+        nearestPointIndex = n;
+      }
+    }
+  }
+  return nearestPointIndex;
+}
+
+//-----------------------------------------------------------------------------
+static romea::core::PathSection2D makeSection(size_t numberOfPoints)
+{
+  romea::core::PathSection2D section(3.);
+  section.addWayPoints(makeWayPoints(numberOfPoints));
+  return section;
+}
+
+//-----------------------------------------------------------------------------
+static void BM_LinearScan(benchmark::State & state)
+{
+  auto section = makeSection(state.range(0));
+  romea::core::Interval<size_t> range(0, section.size() - 1);
+  double radius = state.range(1);
+  double length = section.getLength();
+
+  size_t n = 0;
+  for (auto _ : state) {
+    auto pose = makeVehiclePose(std::fmod(n++ * 7.3, length));
+    benchmark::DoNotOptimize(linearScan(section, pose, range, radius));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+//-----------------------------------------------------------------------------
+static void BM_SegmentTree(benchmark::State & state)
+{
+  auto section = makeSection(state.range(0));
+  romea::core::Interval<size_t> range(0, section.size() - 1);
+  double radius = state.range(1);
+  double length = section.getLength();
+
+  size_t n = 0;
+  for (auto _ : state) {
+    auto pose = makeVehiclePose(std::fmod(n++ * 7.3, length));
+    benchmark::DoNotOptimize(
+      section.getSegmentTree().findNearestOrientedPointIndex(
+        section.getX().data(), section.getY().data(), pose, range, radius));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+//-----------------------------------------------------------------------------
+static void BM_SegmentTreeBuild(benchmark::State & state)
+{
+  auto wayPoints = makeWayPoints(state.range(0));
+  for (auto _ : state) {
+    romea::core::PathOrientedSegmentTree2D tree;
+    tree.reserve(wayPoints.size());
+    for (const auto & wayPoint : wayPoints) {
+      tree.addPoint(wayPoint.position, wayPoint.desired_speed);
+    }
+    benchmark::DoNotOptimize(tree.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_LinearScan)->ArgsProduct({{10000, 1000000}, {1, 10, 100}});
+BENCHMARK(BM_SegmentTree)->ArgsProduct({{10000, 1000000}, {1, 10, 100}});
+BENCHMARK(BM_SegmentTreeBuild)->Arg(1000000);
+
+BENCHMARK_MAIN();
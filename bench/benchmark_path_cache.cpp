@@ -0,0 +1,63 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compare building a path (eager curve fitting) with reloading it from its binary cache.
+
+// std
+#include <sstream>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathSerialization.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+static void BM_BuildPath(benchmark::State & state)
+{
+  romea::core::Path2D::WayPoints wayPoints = {makeWayPoints(state.range(0))};
+
+  for (auto _ : state) {
+    romea::core::Path2D path(wayPoints, 3.);
+    benchmark::DoNotOptimize(path);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//-----------------------------------------------------------------------------
+static void BM_LoadPath(benchmark::State & state)
+{
+  romea::core::Path2D::WayPoints wayPoints = {makeWayPoints(state.range(0))};
+  std::uint64_t hash = romea::core::computePathHash(wayPoints, 3.);
+
+  std::stringstream blob;
+  romea::core::savePath(blob, romea::core::Path2D(wayPoints, 3.), hash);
+  std::string data = blob.str();
+
+  for (auto _ : state) {
+    std::istringstream is(data);
+    benchmark::DoNotOptimize(romea::core::loadPath(is, hash));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_BuildPath)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadPath)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
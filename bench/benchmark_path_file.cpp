@@ -0,0 +1,99 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Loading of a large legacy text path file, with the stream extraction loader
+// PathFile used before as a reference, for a growing number of threads.
+
+// std
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathFile.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+// 10 sections of 100000 way points with speed and marker columns
+static const std::string & legacyPathFilename()
+{
+  static const std::string filename = [] {
+      auto filename = std::filesystem::temp_directory_path() / "romea_core_path_benchmark_path.txt";
+      std::ofstream file(filename);
+      file << "ENU\n10\n";
+      char row[128];
+      for (size_t i = 0; i < 10; ++i) {
+        file << "100000 4\n";
+        for (const auto & wayPoint : makeWayPoints(100000)) {
+          std::snprintf(
+            row, sizeof(row), "%.8e %.8e %.8e %d\n",
+            wayPoint.position.x(), wayPoint.position.y() + i, wayPoint.desired_speed, 0);
+          file << row;
+        }
+      }
+      return filename.string();
+    }();
+  return filename;
+}
+
+//-----------------------------------------------------------------------------
+static void BM_StreamExtraction(benchmark::State & state)
+{
+  const auto & filename = legacyPathFilename();
+  for (auto _ : state) {
+    std::ifstream file(filename);
+    std::string header;
+    size_t numberOfSections;
+    file >> header >> numberOfSections;
+
+    std::vector<std::vector<romea::core::PathWayPoint2D>> wayPoints(numberOfSections);
+    for (auto & sectionWayPoints : wayPoints) {
+      size_t numberOfWayPoints, numberOfColumns;
+      file >> numberOfWayPoints >> numberOfColumns;
+      sectionWayPoints.resize(numberOfWayPoints);
+      for (auto & wayPoint : sectionWayPoints) {
+        int markerCount;
+        file >> wayPoint.position.x() >> wayPoint.position.y() >> wayPoint.desired_speed;
+        file >> markerCount;
+      }
+    }
+    benchmark::DoNotOptimize(wayPoints);
+  }
+  state.SetItemsProcessed(state.iterations() * 1000000);
+}
+
+//-----------------------------------------------------------------------------
+static void BM_PathFile(benchmark::State & state)
+{
+  const auto & filename = legacyPathFilename();
+  for (auto _ : state) {
+    romea::core::PathFile file(filename, state.range(0));
+    benchmark::DoNotOptimize(file.getWayPoints());
+  }
+  state.SetItemsProcessed(state.iterations() * 1000000);
+}
+
+BENCHMARK(BM_StreamExtraction)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PathFile)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()
+->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
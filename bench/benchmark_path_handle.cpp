@@ -0,0 +1,71 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Latency of pinning the active path while a writer thread keeps replacing it,
+// readers must never wait for the writer.
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathHandle.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+static void BM_AcquirePath(benchmark::State & state)
+{
+  const romea::core::Path2D longPath({makeWayPoints(10000)}, 3.);
+  const romea::core::Path2D shortPath({makeWayPoints(1000)}, 3.);
+  bool swapping = state.range(0);
+
+  romea::core::PathHandle handle;
+  handle.publish(romea::core::Path2D(longPath));
+
+  std::atomic<bool> stop = false;
+  std::thread writer([&]() {
+      for (size_t n = 0; swapping && !stop; ++n) {
+        handle.publish(romea::core::Path2D(n % 2 == 0 ? shortPath : longPath));
+      }
+    });
+
+  auto reader = handle.makeReader();
+  std::vector<double> latencies;
+  for (auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    benchmark::DoNotOptimize(reader.acquire());
+    auto end = std::chrono::steady_clock::now();
+    latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+  }
+
+  stop = true;
+  writer.join();
+
+  std::sort(latencies.begin(), latencies.end());
+  state.counters["p50_us"] = latencies[latencies.size() / 2];
+  state.counters["p99_us"] = latencies[latencies.size() * 99 / 100];
+  state.counters["max_us"] = latencies.back();
+}
+
+BENCHMARK(BM_AcquirePath)->Arg(0)->Arg(1)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,96 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Tracking of a vehicle driving along a path at 100 Hz, the matching being done
+// once per control step as in a path following loop.
+
+// std
+#include <optional>
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathMatcher.hpp"
+#include "romea_core_path/PathMatching2D.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+namespace
+{
+
+constexpr double CONTROL_PERIOD = 0.01;
+constexpr double SPEED = 1.;
+
+//-----------------------------------------------------------------------------
+std::vector<romea::core::Pose2D> makeControlStepPoses(size_t numberOfPoses)
+{
+  std::vector<romea::core::Pose2D> poses;
+  poses.reserve(numberOfPoses);
+  for (size_t n = 0; n < numberOfPoses; ++n) {
+    poses.push_back(makeVehiclePose(1. + SPEED * CONTROL_PERIOD * n));
+  }
+  return poses;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+static void BM_FreeFunctionTracking(benchmark::State & state)
+{
+  romea::core::Path2D path(romea::core::Path2D::WayPoints{makeWayPoints(10000)}, 3.);
+  auto poses = makeControlStepPoses(state.range(0));
+
+  for (auto _ : state) {
+    std::optional<romea::core::PathMatchedPoint2D> previousMatchedPoint;
+    for (const auto & pose : poses) {
+      auto matchedPoints = previousMatchedPoint.has_value() ?
+        romea::core::match(path, pose, SPEED, *previousMatchedPoint, 1., 0.2, 10.) :
+        romea::core::match(path, pose, SPEED, 0.2, 10.);
+      if (!matchedPoints.empty()) {
+        previousMatchedPoint = matchedPoints[0];
+      }
+      benchmark::DoNotOptimize(matchedPoints);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * poses.size());
+}
+
+//-----------------------------------------------------------------------------
+static void BM_PathMatcherTracking(benchmark::State & state)
+{
+  romea::core::Path2D path(romea::core::Path2D::WayPoints{makeWayPoints(10000)}, 3.);
+  auto poses = makeControlStepPoses(state.range(0));
+  romea::core::PathMatcherParameters parameters;
+  parameters.newtonWarmStart = state.range(1);
+  romea::core::PathMatcher matcher(path, parameters);
+
+  for (auto _ : state) {
+    matcher.reset();
+    double stamp = 0;
+    for (const auto & pose : poses) {
+      benchmark::DoNotOptimize(matcher.match(pose, SPEED, stamp).data());
+      stamp += CONTROL_PERIOD;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * poses.size());
+}
+
+BENCHMARK(BM_FreeFunctionTracking)->Arg(10000);
+BENCHMARK(BM_PathMatcherTracking)->Args({10000, 0})->Args({10000, 1});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,82 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Build time and global matching latency of a dense 20 Hz recording, as
+// recorded and after an error-bounded simplification.
+
+// std
+#include <cmath>
+#include <random>
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathMatching2D.hpp"
+#include "romea_core_path/PathSimplification.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+// 1 km recorded at 20 Hz and 1 m/s with a few millimetres of noise
+static romea::core::Path2D::WayPoints makeRecordedWayPoints(bool simplified)
+{
+  auto wayPoints = makeWayPoints(20000, 0.05);
+  std::mt19937 generator(42);
+  std::normal_distribution<double> noise(0., 0.003);
+  for (auto & wayPoint : wayPoints) {
+    wayPoint.position += Eigen::Vector2d(noise(generator), noise(generator));
+  }
+
+  if (simplified) {
+    wayPoints = romea::core::simplifyWayPoints(
+      wayPoints, romea::core::PathSimplificationParameters());
+  }
+  return {wayPoints};
+}
+
+//-----------------------------------------------------------------------------
+static void BM_BuildPath(benchmark::State & state)
+{
+  auto wayPoints = makeRecordedWayPoints(state.range(0));
+  for (auto _ : state) {
+    romea::core::Path2D path(wayPoints, 3.);
+    for (size_t n = 0; n < path.getSection(0).size(); ++n) {
+      path.getSection(0).getCurve(n);
+    }
+    benchmark::DoNotOptimize(path);
+  }
+  state.counters["points"] = wayPoints[0].size();
+}
+
+//-----------------------------------------------------------------------------
+static void BM_GlobalMatching(benchmark::State & state)
+{
+  romea::core::Path2D path(makeRecordedWayPoints(state.range(0)), 3.);
+
+  size_t n = 0;
+  for (auto _ : state) {
+    double x = 10. + std::fmod(n++ * 7.3, 980.);
+    benchmark::DoNotOptimize(romea::core::match(path, makeVehiclePose(x), 1., 0.2, 10.));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_BuildPath)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GlobalMatching)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
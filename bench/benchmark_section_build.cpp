@@ -0,0 +1,84 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Construction of a section (abscissae, uniform step and segment tree, curves
+// being fitted lazily) way point by way point and in bulk from way points or
+// from columns.
+
+// std
+#include <vector>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathSection2D.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+static void BM_AddWayPointByWayPoint(benchmark::State & state)
+{
+  auto wayPoints = makeWayPoints(state.range(0));
+
+  for (auto _ : state) {
+    romea::core::PathSection2D section(3.);
+    section.reserve(wayPoints.size());
+    for (const auto & wayPoint : wayPoints) {
+      section.addWayPoint(wayPoint);
+    }
+    benchmark::DoNotOptimize(section.getLength());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//-----------------------------------------------------------------------------
+static void BM_AddWayPoints(benchmark::State & state)
+{
+  auto wayPoints = makeWayPoints(state.range(0));
+
+  for (auto _ : state) {
+    romea::core::PathSection2D section(3.);
+    section.addWayPoints(wayPoints);
+    benchmark::DoNotOptimize(section.getLength());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//-----------------------------------------------------------------------------
+static void BM_AddWayPointColumns(benchmark::State & state)
+{
+  auto wayPoints = makeWayPoints(state.range(0));
+  std::vector<double> X, Y, speeds;
+  for (const auto & wayPoint : wayPoints) {
+    X.push_back(wayPoint.position.x());
+    Y.push_back(wayPoint.position.y());
+    speeds.push_back(wayPoint.desired_speed);
+  }
+
+  for (auto _ : state) {
+    romea::core::PathSection2D section(3.);
+    section.addWayPoints(X.data(), Y.data(), speeds.data(), X.size());
+    benchmark::DoNotOptimize(section.getLength());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_AddWayPointByWayPoint)->Arg(10000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AddWayPoints)->Arg(10000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AddWayPointColumns)->Arg(10000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,145 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compare the per way point quadratic curves of PathSection2D with the global
+// spline of PathSplineSection2D: build time, memory and matching latency.
+
+// std
+#include <optional>
+#include <type_traits>
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathSectionMatching2D.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+static void buildGeometry(const romea::core::PathSection2D & section)
+{
+  for (size_t n = 0; n < section.size(); ++n) {
+    section.getCurve(n);
+  }
+}
+
+//-----------------------------------------------------------------------------
+static void buildGeometry(const romea::core::PathSplineSection2D & section)
+{
+  section.getSpline();
+}
+
+//-----------------------------------------------------------------------------
+static double bytesPerPoint(const romea::core::PathSection2D &)
+{
+  // way point columns + one optional curve per way point
+  return 4 * sizeof(double) + sizeof(std::optional<romea::core::PathCurve2D>);
+}
+
+//-----------------------------------------------------------------------------
+static double bytesPerPoint(const romea::core::PathSplineSection2D & section)
+{
+  // way point columns + knot + one segment per interval
+  const auto & spline = section.getSpline();
+  return 4 * sizeof(double) + sizeof(double) +
+         sizeof(romea::core::PathSpline2D::Segment) * spline.size() / section.size();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Section>
+static Section makeSection(size_t numberOfPoints)
+{
+  if constexpr (std::is_same_v<Section, romea::core::PathSection2D>) {
+    Section section(3.);
+    section.addWayPoints(makeWayPoints(numberOfPoints));
+    return section;
+  } else {
+    Section section;
+    section.addWayPoints(makeWayPoints(numberOfPoints));
+    return section;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Section>
+static void BM_Build(benchmark::State & state)
+{
+  auto wayPoints = makeWayPoints(state.range(0));
+
+  for (auto _ : state) {
+    auto section = makeSection<Section>(0);
+    section.addWayPoints(wayPoints);
+    buildGeometry(section);
+    benchmark::DoNotOptimize(section);
+  }
+
+  auto section = makeSection<Section>(state.range(0));
+  state.counters["bytes_per_point"] = bytesPerPoint(section);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//-----------------------------------------------------------------------------
+template<typename Section>
+static void BM_GlobalMatching(benchmark::State & state)
+{
+  auto section = makeSection<Section>(state.range(0));
+  buildGeometry(section);
+
+  double length = section.getLength();
+  double s = length / 2.;
+  for (auto _ : state) {
+    auto pose = makeVehiclePose(s);
+    benchmark::DoNotOptimize(romea::core::match(section, pose, 1., 1., 10.));
+    s = s + 13.7 < length - 10. ? s + 13.7 : 10.;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+//-----------------------------------------------------------------------------
+template<typename Section>
+static void BM_TrackedMatching(benchmark::State & state)
+{
+  auto section = makeSection<Section>(state.range(0));
+  buildGeometry(section);
+
+  double length = section.getLength();
+  auto matchedPoint = romea::core::match(section, makeVehiclePose(5.), 1., 1., 10.);
+  double s = 5.;
+  for (auto _ : state) {
+    s = s + 0.05 < length - 5. ? s + 0.05 : 5.;
+    auto pose = makeVehiclePose(s);
+    auto next = romea::core::match(section, pose, 1., *matchedPoint, 2., 1., 10.);
+    if (!next) {
+      next = romea::core::match(section, pose, 1., 1., 10.);
+    }
+    matchedPoint = next;
+    benchmark::DoNotOptimize(matchedPoint);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_Build, romea::core::PathSection2D)
+->RangeMultiplier(10)->Range(10000, 100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Build, romea::core::PathSplineSection2D)
+->RangeMultiplier(10)->Range(10000, 100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GlobalMatching, romea::core::PathSection2D)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_GlobalMatching, romea::core::PathSplineSection2D)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_TrackedMatching, romea::core::PathSection2D)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_TrackedMatching, romea::core::PathSplineSection2D)->Arg(100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compare the SoA layout of PathSection2D with PathInterleavedSection2D.
+// Cache misses can be reported when google benchmark is built with libpfm:
+//   ./romea_core_path_benchmark_section_layout --benchmark_perf_counters=CYCLES,CACHE-MISSES
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathSectionMatching2D.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+template<typename Section>
+static void fitCurves(const Section & section)
+{
+  for (size_t n = 0; n < section.size(); ++n) {
+    section.getCurve(n);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Section>
+static void BM_GlobalMatching(benchmark::State & state)
+{
+  size_t numberOfPoints = state.range(0);
+  Section section(3.);
+  section.addWayPoints(makeWayPoints(numberOfPoints));
+  fitCurves(section);
+
+  double length = section.getLength();
+  double s = length / 2.;
+  for (auto _ : state) {
+    auto pose = makeVehiclePose(s);
+    benchmark::DoNotOptimize(romea::core::match(section, pose, 1., 1., 10.));
+    s = s + 13.7 < length - 10. ? s + 13.7 : 10.;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+//-----------------------------------------------------------------------------
+template<typename Section>
+static void BM_TrackedMatching(benchmark::State & state)
+{
+  size_t numberOfPoints = state.range(0);
+  Section section(3.);
+  section.addWayPoints(makeWayPoints(numberOfPoints));
+  fitCurves(section);
+
+  double length = section.getLength();
+  auto matchedPoint = romea::core::match(section, makeVehiclePose(5.), 1., 1., 10.);
+  double s = 5.;
+  for (auto _ : state) {
+    s = s + 0.05 < length - 5. ? s + 0.05 : 5.;
+    auto pose = makeVehiclePose(s);
+    auto next = romea::core::match(section, pose, 1., *matchedPoint, 2., 1., 10.);
+    if (!next) {
+      next = romea::core::match(section, pose, 1., 1., 10.);
+    }
+    matchedPoint = next;
+    benchmark::DoNotOptimize(matchedPoint);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_GlobalMatching, romea::core::PathSection2D)
+->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK_TEMPLATE(BM_GlobalMatching, romea::core::PathInterleavedSection2D)
+->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK_TEMPLATE(BM_TrackedMatching, romea::core::PathSection2D)
+->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK_TEMPLATE(BM_TrackedMatching, romea::core::PathInterleavedSection2D)
+->RangeMultiplier(10)->Range(10000, 1000000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,60 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Tracked matching on a PathSection2D for growing research intervals, the
+// candidates being scanned over the whole interval or searched outward from
+// the previous curve index.
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathSectionMatching2D.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+static void BM_TrackedMatching(benchmark::State & state)
+{
+  romea::core::PathSection2D section(3.);
+  section.addWayPoints(makeWayPoints(100000));
+  double researchLength = state.range(0);
+  bool outwardSearch = state.range(1);
+  const auto & S = section.getCurvilinearAbscissa();
+
+  // curves are fitted beforehand, only the search is measured
+  for (size_t n = 0; n < section.size(); ++n) {
+    section.getCurve(n);
+  }
+
+  size_t n = 0;
+  for (auto _ : state) {
+    // the previous curve index lags a few points behind the vehicle
+    size_t index = 1000 + (n++ * 73) % (section.size() - 2000);
+    auto pose = makeVehiclePose(section.getX()[index]);
+    romea::core::Interval<double> interval(
+      S[index] - researchLength / 2., S[index] + researchLength / 2.);
+
+    benchmark::DoNotOptimize(
+      romea::core::match(
+        section, pose, 1., index - 3, interval, 0.2, 10., false, outwardSearch));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_TrackedMatching)->ArgsProduct({{1, 10, 100}, {0, 1}});
+
+BENCHMARK_MAIN();
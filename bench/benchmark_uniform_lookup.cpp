@@ -0,0 +1,73 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Abscissa to index lookups on a section whose way points are irregularly
+// spaced (linear walks) and on the same section resampled with a uniform step
+// (index arithmetic).
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// romea
+#include "romea_core_path/PathResampling.hpp"
+#include "romea_core_path/PathSection2D.hpp"
+
+// local
+#include "bench_utils.hpp"
+
+//-----------------------------------------------------------------------------
+static romea::core::PathSection2D makeSection(bool uniform)
+{
+  auto wayPoints = makeWayPoints(20000);
+  romea::core::PathSection2D section(3.);
+  section.addWayPoints(uniform ? romea::core::resampleWayPoints(wayPoints, 0.1, 3.) : wayPoints);
+  return section;
+}
+
+//-----------------------------------------------------------------------------
+static void BM_FindIndex(benchmark::State & state)
+{
+  auto section = makeSection(state.range(0));
+  double length = section.getLength();
+
+  size_t n = 0;
+  for (auto _ : state) {
+    double s = length * ((n++ * 7919) % 10007) / 10007.;
+    benchmark::DoNotOptimize(section.findIndex(s));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+//-----------------------------------------------------------------------------
+static void BM_FindIntervalBoundIndexes(benchmark::State & state)
+{
+  auto section = makeSection(state.range(0));
+  double researchLength = state.range(1);
+  const auto & S = section.getCurvilinearAbscissa();
+
+  size_t n = 0;
+  for (auto _ : state) {
+    size_t index = (n++ * 7919) % section.size();
+    romea::core::Interval<double> interval(
+      S[index] - researchLength / 2., S[index] + researchLength / 2.);
+    benchmark::DoNotOptimize(section.findIntervalBoundIndexes(index, interval));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FindIndex)->Arg(0)->Arg(1);
+BENCHMARK(BM_FindIntervalBoundIndexes)->ArgsProduct({{0, 1}, {3, 10, 100}});
+
+BENCHMARK_MAIN();
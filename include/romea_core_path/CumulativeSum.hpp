@@ -16,22 +16,99 @@
 #define ROMEA_CORE_PATH__CUMULATIVESUM_HPP_
 
 // std
-#include <vector>
-#include <memory>
+#include <algorithm>
 #include <cstdlib>
+#include <future>
+#include <memory>
+#include <vector>
 
 namespace romea
 {
 namespace core
 {
 
-template<typename T, typename Allocator>
+// Summation policies of CumulativeSum. An accumulator is started from a value,
+// incremented by deltas or by another accumulator, and gives the running sum.
+
+// Plain running sum, each value is the previous one plus the delta
+struct NaiveSummation
+{
+  template<typename T>
+  struct Accumulator
+  {
+    explicit Accumulator(const T & initialValue = 0)
+    : sum(initialValue)
+    {
+    }
+
+    void add(const T & delta)
+    {
+      sum += delta;
+    }
+
+    void add(const Accumulator & other)
+    {
+      sum += other.sum;
+    }
+
+    T value() const
+    {
+      return sum;
+    }
+
+    T sum;
+  };
+};
+
+// Running sum carrying the exact rounding error of each addition (TwoSum), so
+// that values stay within one rounding of the exact sums whatever the number of
+// deltas and the order in which chunks of them are summed
+struct CompensatedSummation
+{
+  template<typename T>
+  struct Accumulator
+  {
+    explicit Accumulator(const T & initialValue = 0)
+    : sum(initialValue),
+      compensation(0)
+    {
+    }
+
+    void add(const T & delta)
+    {
+      T s = sum + delta;
+      T d = s - sum;
+      compensation += (sum - (s - d)) + (delta - d);
+      sum = s;
+    }
+
+    void add(const Accumulator & other)
+    {
+      add(other.sum);
+      compensation += other.compensation;
+    }
+
+    T value() const
+    {
+      return sum + compensation;
+    }
+
+    T sum;
+    T compensation;
+  };
+};
+
+template<typename T, typename Allocator, typename Summation = NaiveSummation>
 class CumulativeSum
 {
 public:
   using Vector = std::vector<T, Allocator>;
   using iterator = typename Vector::iterator;
   using const_iterator = typename Vector::const_iterator;
+  using Accumulator = typename Summation::template Accumulator<T>;
+
+  // Below this number of deltas per chunk threads cost more than they save
+  static constexpr size_t MINIMAL_DELTAS_PER_CHUNK = 1 << 16;
 
 public:
   CumulativeSum();
@@ -42,6 +119,19 @@ public:
 
   void increment(const double & delta);
 
+  // Append a sum computed elsewhere, the next increments start from it
+  void append(const T & value);
+
+  // Replace the sums by the initial value followed by its increments by each
+  // delta in turn, the same values as successive calls to increment.
+  // Large inputs can be scanned by up to numberOfThreads chunks: the totals of
+  // the chunks are summed first and each chunk is then scanned from its offset,
+  // so values may differ from increments in the last bit with the naive policy.
+  void assignFromDeltas(
+    const T * deltas,
+    const size_t & size,
+    size_t numberOfThreads = 1);
+
   const T & initialValue()const;
 
   const T & finalValue()const;
@@ -58,95 +148,184 @@ public:
 
   const_iterator end() const;
 
+private:
+  static void scan_(
+    const T * deltas,
+    const size_t & begin,
+    const size_t & end,
+    Accumulator & accumulator,
+    T * sums);
+
 private:
   Vector cumsum_;
+  Accumulator accumulator_;
 };
 
 
 //-----------------------------------------------------------------------------
-template<typename T, typename Allocator>
-CumulativeSum<T, Allocator>::CumulativeSum()
+template<typename T, typename Allocator, typename Summation>
+CumulativeSum<T, Allocator, Summation>::CumulativeSum()
 : CumulativeSum(0)
 {
 }
 
 //-----------------------------------------------------------------------------
-template<typename T, typename Allocator>
-CumulativeSum<T, Allocator>::CumulativeSum(const T & initialValue)
-: cumsum_(1, initialValue)
+template<typename T, typename Allocator, typename Summation>
+CumulativeSum<T, Allocator, Summation>::CumulativeSum(const T & initialValue)
+: cumsum_(1, initialValue),
+  accumulator_(initialValue)
+{
+}
+
+//-----------------------------------------------------------------------------
+template<typename T, typename Allocator, typename Summation>
+void CumulativeSum<T, Allocator, Summation>::increment(const double & delta)
+{
+  accumulator_.add(delta);
+  cumsum_.push_back(accumulator_.value());
+}
+
+//-----------------------------------------------------------------------------
+template<typename T, typename Allocator, typename Summation>
+void CumulativeSum<T, Allocator, Summation>::append(const T & value)
+{
+  accumulator_ = Accumulator(value);
+  cumsum_.push_back(value);
+}
+
+//-----------------------------------------------------------------------------
+template<typename T, typename Allocator, typename Summation>
+void CumulativeSum<T, Allocator, Summation>::assignFromDeltas(
+  const T * deltas,
+  const size_t & size,
+  size_t numberOfThreads)
 {
+  cumsum_.resize(size + 1);
+  accumulator_ = Accumulator(cumsum_[0]);
+
+  size_t numberOfChunks = std::min(numberOfThreads, size / MINIMAL_DELTAS_PER_CHUNK);
+  if (numberOfChunks < 2) {
+    scan_(deltas, 0, size, accumulator_, cumsum_.data());
+    return;
+  }
+
+  auto chunkBegin = [&](const size_t & k) {return size * k / numberOfChunks;};
+
+  // totals of all chunks but the last one, which is not needed for the offsets
+  std::vector<std::future<Accumulator>> totals;
+  for (size_t k = 0; k + 1 < numberOfChunks; ++k) {
+    totals.push_back(
+      std::async(
+        std::launch::async, [&, k]() {
+          Accumulator total;
+          for (size_t n = chunkBegin(k); n < chunkBegin(k + 1); ++n) {
+            total.add(deltas[n]);
+          }
+          return total;
+        }));
+  }
+
+  std::vector<Accumulator> offsets(1, accumulator_);
+  for (auto & total : totals) {
+    offsets.push_back(offsets.back());
+    offsets.back().add(total.get());
+  }
+
+  std::vector<std::future<void>> scans;
+  for (size_t k = 0; k + 1 < numberOfChunks; ++k) {
+    scans.push_back(
+      std::async(
+        std::launch::async, [&, k]() {
+          scan_(deltas, chunkBegin(k), chunkBegin(k + 1), offsets[k], cumsum_.data());
+        }));
+  }
+
+  accumulator_ = offsets.back();
+  scan_(deltas, chunkBegin(numberOfChunks - 1), size, accumulator_, cumsum_.data());
+  for (auto & scan : scans) {
+    scan.get();
+  }
 }
 
 //-----------------------------------------------------------------------------
-template<typename T, typename Allocator>
-void CumulativeSum<T, Allocator>::increment(const double & delta)
+template<typename T, typename Allocator, typename Summation>
+void CumulativeSum<T, Allocator, Summation>::scan_(
+  const T * deltas,
+  const size_t & begin,
+  const size_t & end,
+  Accumulator & accumulator,
+  T * sums)
 {
-  cumsum_.push_back(cumsum_.back() + delta);
+  for (size_t n = begin; n < end; ++n) {
+    accumulator.add(deltas[n]);
+    sums[n + 1] = accumulator.value();
+  }
 }
 
 //-----------------------------------------------------------------------------
-template<typename T, typename Allocator>
-const T & CumulativeSum<T, Allocator>::initialValue()const
+template<typename T, typename Allocator, typename Summation>
+const T & CumulativeSum<T, Allocator, Summation>::initialValue()const
 {
   return cumsum_.front();
 }
 
 //-----------------------------------------------------------------------------
-template<typename T, typename Allocator>
-const T & CumulativeSum<T, Allocator>::finalValue()const
+template<typename T, typename Allocator, typename Summation>
+const T & CumulativeSum<T, Allocator, Summation>::finalValue()const
 {
   return cumsum_.back();
 }
 
 //-----------------------------------------------------------------------------
-template<typename T, typename Allocator>
-const T & CumulativeSum<T, Allocator>::operator[](size_t n) const
+template<typename T, typename Allocator, typename Summation>
+const T & CumulativeSum<T, Allocator, Summation>::operator[](size_t n) const
 {
   return cumsum_[n];
 }
 
 //-----------------------------------------------------------------------------
-template<typename T, typename Allocator>
-void CumulativeSum<T, Allocator>::reserve(size_t n)
+template<typename T, typename Allocator, typename Summation>
+void CumulativeSum<T, Allocator, Summation>::reserve(size_t n)
 {
   cumsum_.reserve(n);
 }
 
 //-----------------------------------------------------------------------------
-template<typename T, typename Allocator>
-size_t CumulativeSum<T, Allocator>::size() const
+template<typename T, typename Allocator, typename Summation>
+size_t CumulativeSum<T, Allocator, Summation>::size() const
 {
   return cumsum_.size();
 }
 
 //-----------------------------------------------------------------------------
-template<typename T, typename Allocator>
-void CumulativeSum<T, Allocator>::clear()
+template<typename T, typename Allocator, typename Summation>
+void CumulativeSum<T, Allocator, Summation>::clear()
 {
   cumsum_.clear();
   cumsum_.push_back(0);
+  accumulator_ = Accumulator();
 }
 
 //-----------------------------------------------------------------------------
-template<typename T, typename Allocator>
-const typename CumulativeSum<T, Allocator>::Vector &
-CumulativeSum<T, Allocator>::data()const
+template<typename T, typename Allocator, typename Summation>
+const typename CumulativeSum<T, Allocator, Summation>::Vector &
+CumulativeSum<T, Allocator, Summation>::data()const
 {
   return cumsum_;
 }
 
 //-----------------------------------------------------------------------------
-template<typename T, typename Allocator>
-typename CumulativeSum<T, Allocator>::const_iterator
-CumulativeSum<T, Allocator>::begin() const
+template<typename T, typename Allocator, typename Summation>
+typename CumulativeSum<T, Allocator, Summation>::const_iterator
+CumulativeSum<T, Allocator, Summation>::begin() const
 {
   return cumsum_.begin();
 }
 
 //-----------------------------------------------------------------------------
-template<typename T, typename Allocator>
-typename CumulativeSum<T, Allocator>::const_iterator
-CumulativeSum<T, Allocator>::end() const
+template<typename T, typename Allocator, typename Summation>
+typename CumulativeSum<T, Allocator, Summation>::const_iterator
+CumulativeSum<T, Allocator, Summation>::end() const
 {
   return cumsum_.end();
 }
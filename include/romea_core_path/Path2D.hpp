@@ -23,20 +23,26 @@
 #include "CumulativeSum.hpp"
 #include "PathAnnotation.hpp"
 #include "PathSection2D.hpp"
+#include "PathSectionTree2D.hpp"
 
 namespace romea
 {
 namespace core
 {
 
+class PathFile;
+
 class Path2D
 {
 public:
   using WayPoints = std::vector<std::vector<PathWayPoint2D>>;
-  using CurvilinearAbscissa = CumulativeSum<double, Eigen::aligned_allocator<double>>;
+  using WayPointColumns = std::vector<PathSection2D::WayPointColumns>;
+  using CurvilinearAbscissa =
+    CumulativeSum<double, Eigen::aligned_allocator<double>, CompensatedSummation>;
   using Sections = std::vector<PathSection2D>;
   using Annotations = std::multimap<std::size_t, PathAnnotation>;
   using AnnotationList = std::vector<PathAnnotation>;
+  using Curves = std::vector<std::vector<PathCurve2D>>;
 
 public:
   Path2D(
@@ -46,7 +52,30 @@ public:
   Path2D(
     const WayPoints & wayPoints,
     const double & interpolationWindowLength,
-    const Annotations & annotations);
+    const Annotations & annotations,
+    const size_t & polynomialDegree = 2);
+
+  // The columns of each section are moved into the path sections
+  Path2D(
+    WayPointColumns && wayPoints,
+    const double & interpolationWindowLength,
+    const Annotations & annotations,
+    const size_t & polynomialDegree = 2);
+
+  // Build the path from the way points and annotations of a loaded file, the
+  // way points are moved from the file without any intermediate copy
+  Path2D(
+    PathFile && file,
+    const double & interpolationWindowLength,
+    const size_t & polynomialDegree = 2);
+
+  // Build the path with curves that have already been estimated, no fitting is done
+  Path2D(
+    const WayPoints & wayPoints,
+    const double & interpolationWindowLength,
+    const Annotations & annotations,
+    const Curves & curves,
+    const size_t & polynomialDegree = 2);
 
   const PathSection2D & getSection(const size_t & sectionIndex) const;
 
@@ -56,19 +85,43 @@ public:
 
   size_t size() const;
 
+  const double & getInterpolationWindowLength() const;
+
+  size_t getPolynomialDegree() const;
+
+  // The section tree is dropped, nearby sections are then found by checking
+  // every section box
   PathSection2D & addEmptySection();
 
+  // Indexes, in increasing order, of the sections that may hold a point closer
+  // than the research radius to the position
+  void findNearbySections(
+    const Eigen::Vector2d & position,
+    const double & researchRadius,
+    std::vector<size_t> & sectionIndexes) const;
+
   const Sections & getSections() const {return sections_;}
 
   void setAnnotations(const Annotations & annotations);
 
   const Annotations & getAnnotations() const {return annotations_;}
 
+private:
+  void addSections_(const WayPoints & wayPoints);
+
+  void addSections_(WayPointColumns && wayPoints);
+
+  void fitCurves_();
+
+  void buildSectionTree_();
+
 private:
   Sections sections_;
+  PathSectionTree2D sectionTree_;
   CurvilinearAbscissa curvilinearAbscissa_;
   double length_;
   double interpolationWindowLength_;
+  size_t polynomialDegree_;
   Annotations annotations_;
 };
 
@@ -0,0 +1,127 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_CORE_PATH__PATHCOMPACTSECTION2D_HPP_
+#define ROMEA_CORE_PATH__PATHCOMPACTSECTION2D_HPP_
+
+// std
+#include <unordered_map>
+#include <vector>
+
+// romea
+#include "romea_core_common/math/Interval.hpp"
+#include "romea_core_path/PathCurve2D.hpp"
+#include "romea_core_path/PathWayPoint2D.hpp"
+
+
+namespace romea
+{
+namespace core
+{
+
+// Interleaved section storing way points in single precision to halve memory
+// and bandwidth. Positions are offsets from the first way point of the section,
+// so that the float rounding stays below the millimetre over a few kilometres.
+// Abscissae are offsets from a double base abscissa kept per chunk of
+// POINTS_PER_CHUNK way points, so that their resolution does not depend on the
+// section length. Curves are only stored once fitted. All the accessors and the
+// curve fitting work in double precision.
+class PathCompactSection2D
+{
+public:
+  struct Point
+  {
+    float x;
+    float y;
+    float curvilinearAbscissa;
+    float speed;
+  };
+
+  using Points = std::vector<Point>;
+
+  static constexpr size_t POINTS_PER_CHUNK = 256;
+
+public:
+  PathCompactSection2D(
+    const double & interpolationWindowLength,
+    const double & initialCurvilinearAbcissa = 0,
+    size_t initialPointIndex = 0);
+
+  void addWayPoint(const PathWayPoint2D & wayPoint);
+
+  void addWayPoints(const std::vector<PathWayPoint2D> & wayPoints);
+
+  const PathCurve2D & getCurve(const size_t & pointIndex) const;
+
+  size_t getNumberOfFittedCurves() const;
+
+  const Points & getPoints()const;
+
+  const Eigen::Vector2d & getOrigin()const;
+
+  Eigen::Vector2d getPosition(const size_t & pointIndex)const;
+
+  double getCurvilinearAbscissa(const size_t & pointIndex)const;
+
+  double getSpeed(const size_t & pointIndex)const;
+
+  const double & getInitialCurvilinearAbscissa()const;
+
+  double getFinalCurvilinearAbscissa()const;
+
+  const double & getLength()const;
+
+  size_t getInitialPointIndex()const;
+
+  void reserve(size_t n);
+
+  size_t size()const;
+
+  void clear();
+
+
+  size_t findIndex(const double & value) const;
+
+  size_t findIndex(
+    const double & value,
+    const size_t & startSearchIndex) const;
+
+  Interval<size_t> findIntervalBoundIndexes(
+    const size_t & intervalCenterIndex,
+    const double & intervalWidth)const;
+
+  Interval<size_t> findIntervalBoundIndexes(
+    const size_t & intervalCenterIndex,
+    const Interval<double> & interval)const;
+
+private:
+  const PathCurve2D & computePathCurve_(const size_t & pointIndex)const;
+
+private:
+  Points points_;
+  std::vector<double> chunkCurvilinearAbscissae_;
+  mutable std::unordered_map<size_t, PathCurve2D> curves_;
+
+  Eigen::Vector2d origin_;
+  Eigen::Vector2d lastPosition_;
+  size_t initial_point_index_;
+  double initialCurvilinearAbscissa_;
+  double interpolationWindowLength_;
+  double length_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHCOMPACTSECTION2D_HPP_
@@ -30,39 +30,122 @@ namespace core
 {
 
 
+// Local polynomial fit x(s), y(s) of the path around a way point. The degree
+// is 2 or 3, coefficients are stored up to s^3 and the unused ones are zero.
 class PathCurve2D
 {
 public:
   using Vector = std::vector<double, Eigen::aligned_allocator<double>>;
+  using ConstStridedArray = Eigen::Ref<const Eigen::ArrayXd, 0, Eigen::InnerStride<>>;
+  using ConstArrayRef = Eigen::Ref<const Eigen::ArrayXd>;
+  using ArrayRef = Eigen::Ref<Eigen::ArrayXd>;
+  using PolynomCoefficients = Eigen::Array4d;
+
+  enum class FitStatus
+  {
+    NOT_ESTIMATED,
+    SUCCESS,
+    NOT_ENOUGH_POINTS,
+    SINGULAR_MATRIX
+  };
 
 public:
   PathCurve2D();
 
+  // Rebuild an already estimated curve, e.g. from a serialized path
+  PathCurve2D(
+    const PolynomCoefficients & fxPolynomCoefficient,
+    const PolynomCoefficients & fyPolynomCoefficient,
+    const size_t & polynomialDegree,
+    const Eigen::Vector2d & origin,
+    const double & originCurvilinearAbscissa,
+    const Interval<size_t> & indexInterval,
+    const Interval<double> & curvilinearAbscissaInterval);
+
   bool estimate(
     const Vector & X,
     const Vector & Y,
     const Vector & S,
     const Interval<size_t> & indexInterval,
-    const Interval<double> & curvilinearAbscissaInterval);
+    const Interval<double> & curvilinearAbscissaInterval,
+    const size_t & polynomialDegree = 2);
+
+  // X, Y and S only hold the points of indexInterval and can be strided views,
+  // e.g. the columns of an interleaved storage
+  bool estimate(
+    const ConstStridedArray & X,
+    const ConstStridedArray & Y,
+    const ConstStridedArray & S,
+    const Interval<size_t> & indexInterval,
+    const Interval<double> & curvilinearAbscissaInterval,
+    const size_t & polynomialDegree = 2);
 
+  // Closed form cubic solution for degree 2, bracketed Newton on the quintic for degree 3
   std::optional<double> findNearestCurvilinearAbscissa(
     const Eigen::Vector2d & vehiclePosition) const;
 
+  // Newton steps on the distance to the vehicle started from a previous abscissa,
+  // for tracking. The result may lie outside the curvilinear abscissa interval,
+  // nothing is returned when the iterations diverge.
+  std::optional<double> refineNearestCurvilinearAbscissa(
+    const Eigen::Vector2d & vehiclePosition,
+    const double & initialCurvilinearAbscissa,
+    const size_t & maximalNumberOfIterations = 2) const;
+
   double computeX(const double & curvilinearAbscissa)const;
 
   double computeY(const double & curvilinearAbscissa)const;
 
   double computeTangent(const double & curvilinearAbscissa)const;
 
+  // Unit tangent vector, cos and sin of the tangent without any trigonometric call
+  Eigen::Vector2d computeDirection(const double & curvilinearAbscissa)const;
+
   double computeCurvature(const double & curvilinearAbscissa)const;
 
+  // Batch versions evaluating a whole array of abscissae at once, outputs must
+  // have the size of the input and can be maps over caller owned buffers
+  void computeX(const ConstArrayRef & curvilinearAbscissae, ArrayRef X)const;
+
+  void computeY(const ConstArrayRef & curvilinearAbscissae, ArrayRef Y)const;
+
+  void computeTangent(const ConstArrayRef & curvilinearAbscissae, ArrayRef tangents)const;
+
+  void computeCurvature(const ConstArrayRef & curvilinearAbscissae, ArrayRef curvatures)const;
+
+  // Position, tangent and curvature sharing the derivative evaluations
+  void computePostures(
+    const ConstArrayRef & curvilinearAbscissae,
+    ArrayRef X,
+    ArrayRef Y,
+    ArrayRef tangents,
+    ArrayRef curvatures)const;
+
   const Interval<double> & getCurvilinearAbscissaInterval()const;
 
   const Interval<size_t> & getIndexInterval()const;
 
+  const PolynomCoefficients & getXPolynomCoefficients()const;
+
+  const PolynomCoefficients & getYPolynomCoefficients()const;
+
+  size_t getPolynomialDegree()const;
+
+  FitStatus getFitStatus()const;
+
+  const Eigen::Vector2d & getOrigin()const;
+
+  const double & getOriginCurvilinearAbscissa()const;
+
+private:
+  std::optional<double> findNearestCurvilinearAbscissaOnCubic_(
+    const Eigen::Vector2d & vehiclePosition) const;
+
 private:
-  Eigen::Array3d fxPolynomCoefficient_;
-  Eigen::Array3d fyPolynomCoefficient_;
+  PolynomCoefficients fxPolynomCoefficient_;
+  PolynomCoefficients fyPolynomCoefficient_;
+  size_t polynomialDegree_;
+  FitStatus fitStatus_;
   Eigen::Vector2d origin_;
   double originCurvilinearAbscissa_;
 
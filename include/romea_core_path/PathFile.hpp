@@ -41,17 +41,31 @@ public:
 
 public:
   PathFile();
-  explicit PathFile(const std::string & filename);
 
+  // Sections of large legacy text files are parsed by up to numberOfThreads
+  // threads, with the same result as a single threaded parsing
+  explicit PathFile(const std::string & filename, size_t numberOfThreads = 1);
+
+  // Gathered from the columns on the first call
   const std::vector<std::vector<PathWayPoint2D>> & getWayPoints() const;
+
+  // Way points of each section stored by columns, as in PathSection2D
+  const Path2D::WayPointColumns & getWayPointColumns() const;
+
+  // Move the columns out of the file, which then holds no way point
+  Path2D::WayPointColumns releaseWayPointColumns();
   const std::string & getCoordinateSystemDescription() const;
   const Eigen::Affine3d & getWorldToPathTransformation() const;
   const std::optional<GeodeticCoordinates> & getWGS84Anchor() const;
   const Annotations & getAnnotations() const {return annotations_;}
 
 private:
-  void loadHeader_();
-  void loadWayPoints_();
+  // Line and column aware reader of the legacy text format
+  class TextParser;
+
+  void loadV1_(const std::string & filename);
+  void loadHeaderV1_(TextParser & parser);
+  void loadWayPointsV1_(TextParser & parser);
 
   void loadV2_();
   void loadHeaderV2_(const nlohmann::json & data);
@@ -62,8 +76,10 @@ private:
   std::string coordinate_system_;
   Eigen::Affine3d world_to_path_;
   std::optional<GeodeticCoordinates> wgs84_anchor_;
-  std::vector<std::vector<PathWayPoint2D>> way_points_;
+  Path2D::WayPointColumns way_point_columns_;
+  mutable std::vector<std::vector<PathWayPoint2D>> way_points_;
   std::ifstream file_;
+  size_t number_of_threads_;
   Annotations annotations_;
 };
 
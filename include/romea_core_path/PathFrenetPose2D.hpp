@@ -40,6 +40,24 @@ std::ostream & operator<<(std::ostream & os, const PathFrenetPose2D & frenetPose
 
 PathFrenetPose2D reverse(const PathFrenetPose2D & frenetPose);
 
+// Frenet pose without covariance, for planners, visualisers or offline analyses
+// storing many poses. It is trivially copyable and a quarter of the size of
+// PathFrenetPose2D.
+struct PathCompactFrenetPose2D
+{
+  PathCompactFrenetPose2D();
+
+  explicit PathCompactFrenetPose2D(const PathFrenetPose2D & frenetPose);
+
+  double curvilinearAbscissa;
+  double lateralDeviation;
+  double courseDeviation;
+};
+
+std::ostream & operator<<(std::ostream & os, const PathCompactFrenetPose2D & frenetPose);
+
+PathCompactFrenetPose2D reverse(const PathCompactFrenetPose2D & frenetPose);
+
 }  // namespace core
 }  // namespace romea
 
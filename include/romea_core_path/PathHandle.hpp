@@ -0,0 +1,130 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_PATH__PATHHANDLE_HPP_
+#define ROMEA_CORE_PATH__PATHHANDLE_HPP_
+
+// std
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// romea
+#include "romea_core_path/Path2D.hpp"
+#include "romea_core_path/PathMatchedPoint2D.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Active path shared between a control thread and the threads replacing it.
+// Writers build a new Path2D off-thread and publish it atomically, readers pin
+// the current version without ever blocking on writers. Each reader owns a
+// hazard slot announcing the version it uses, a replaced version is destroyed
+// by a later publish or reclaim once no slot refers to it anymore.
+class PathHandle
+{
+public:
+  struct Version
+  {
+    Path2D path;
+    std::uint64_t generation;
+  };
+
+  class Reader
+  {
+  public:
+    Reader(Reader && reader);
+
+    Reader(const Reader &) = delete;
+
+    Reader & operator=(const Reader &) = delete;
+
+    ~Reader();
+
+    // Pin the current version in a bounded number of steps, nullptr when no path
+    // has been published yet. The version stays valid until the next call to
+    // acquire or release.
+    const Version * acquire();
+
+    void release();
+
+  private:
+    friend class PathHandle;
+
+    Reader(PathHandle * handle, size_t slotIndex);
+
+    PathHandle * handle_;
+    size_t slotIndex_;
+  };
+
+public:
+  explicit PathHandle(size_t maximalNumberOfReaders = 8);
+
+  PathHandle(const PathHandle &) = delete;
+
+  PathHandle & operator=(const PathHandle &) = delete;
+
+  // Readers must have been destroyed before their handle
+  ~PathHandle();
+
+  // Throw when maximalNumberOfReaders readers are alive
+  Reader makeReader();
+
+  // Make the path the current version and return its generation
+  std::uint64_t publish(Path2D && path);
+
+  std::uint64_t getGeneration() const;
+
+  // Destroy the replaced versions no reader uses anymore and return the number
+  // of versions still waiting for their readers
+  size_t reclaim();
+
+private:
+  // slots are padded to a cache line to keep readers from sharing one
+  struct alignas(64) Slot
+  {
+    std::atomic<std::uintptr_t> value;
+  };
+
+  size_t reclaim_();
+
+private:
+  std::atomic<Version *> current_;
+  std::vector<Slot> slots_;
+
+  std::mutex writerMutex_;
+  std::vector<bool> usedSlots_;
+  std::vector<std::unique_ptr<Version>> retiredVersions_;
+};
+
+// Carry a point tracked on the previous path over to a new one sharing its
+// geometry around the point (same way points in the fitting window of its
+// curve), so that tracked matching goes on without a global match. Section
+// and curve indexes, curvilinear abscissae and desired speed are those of the
+// new path. Return nothing when the geometry differs.
+std::optional<PathMatchedPoint2D> remapMatchedPoint(
+  const PathMatchedPoint2D & matchedPoint,
+  const Path2D & previousPath,
+  const Path2D & path);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHHANDLE_HPP_
@@ -0,0 +1,116 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_CORE_PATH__PATHINTERLEAVEDSECTION2D_HPP_
+#define ROMEA_CORE_PATH__PATHINTERLEAVEDSECTION2D_HPP_
+
+// std
+#include <optional>
+#include <vector>
+
+// romea
+#include "romea_core_common/math/Interval.hpp"
+#include "romea_core_path/CumulativeSum.hpp"
+#include "romea_core_path/PathCurve2D.hpp"
+#include "romea_core_path/PathWayPoint2D.hpp"
+
+
+namespace romea
+{
+namespace core
+{
+
+// Same geometry as PathSection2D but the per point data read by matching (x, y,
+// curvilinear abscissa and speed) are packed into one record, so that a nearest
+// point scan walks a single memory stream instead of four.
+class PathInterleavedSection2D
+{
+public:
+  struct Point
+  {
+    double x;
+    double y;
+    double curvilinearAbscissa;
+    double speed;
+  };
+
+  using Points = std::vector<Point>;
+
+public:
+  PathInterleavedSection2D(
+    const double & interpolationWindowLength,
+    const double & initialCurvilinearAbcissa = 0,
+    size_t initialPointIndex = 0);
+
+  void addWayPoint(const PathWayPoint2D & wayPoint);
+
+  void addWayPoints(const std::vector<PathWayPoint2D> & wayPoints);
+
+  const PathCurve2D & getCurve(const size_t & pointIndex) const;
+
+  const Points & getPoints()const;
+
+  const double & getInitialCurvilinearAbscissa()const;
+
+  const double & getFinalCurvilinearAbscissa()const;
+
+  const double & getLength()const;
+
+  size_t getInitialPointIndex()const;
+
+  void reserve(size_t n);
+
+  size_t size()const;
+
+  void clear();
+
+
+  size_t findIndex(const double & value) const;
+
+  size_t findIndex(
+    const double & value,
+    const size_t & startSearchIndex) const;
+
+  Interval<size_t> findIntervalBoundIndexes(
+    const size_t & intervalCenterIndex,
+    const double & intervalWidth)const;
+
+  Interval<size_t> findIntervalBoundIndexes(
+    const size_t & intervalCenterIndex,
+    const Interval<double> & interval)const;
+
+private:
+  void computePathCurve_(const size_t & pointIndex)const;
+
+  PathCurve2D::ConstStridedArray column_(
+    const double Point::* member,
+    const Interval<size_t> & indexRange)const;
+
+private:
+  Points points_;
+  mutable std::vector<std::optional<PathCurve2D>> curves_;
+
+  size_t initial_point_index_;
+  double initialCurvilinearAbscissa_;
+  double interpolationWindowLength_;
+  double length_;
+
+  // abscissae are summed as in PathSection2D to get the same values
+  CompensatedSummation::Accumulator<double> curvilinearAbscissa_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHINTERLEAVEDSECTION2D_HPP_
@@ -16,6 +16,7 @@
 #define ROMEA_CORE_PATH__PATHMATCHEDPOINT2D_HPP_
 
 // std
+#include <cstdint>
 #include <optional>
 #include <ostream>
 #include <vector>
@@ -50,9 +51,57 @@ double direction(const PathMatchedPoint2D & matchedPoint);
 Eigen::Vector2d globalPosition(const PathMatchedPoint2D & matchedPoint);
 
 std::optional<PathMatchedPoint2D> findMatchedPointBySectionIndex(
-  const std::vector<PathMatchedPoint2D> matchedPoints,
+  const std::vector<PathMatchedPoint2D> & matchedPoints,
   const size_t & sectionIndex);
 
+// Lookup in a contiguous range of matched points without copying them,
+// return nullptr when no point belongs to the section
+const PathMatchedPoint2D * findMatchedPointBySectionIndex(
+  const PathMatchedPoint2D * first,
+  const PathMatchedPoint2D * last,
+  const size_t & sectionIndex);
+
+// Matched point without covariance made of plain values only. It is trivially
+// copyable and about half the size of PathMatchedPoint2D, so that controllers,
+// loggers or IPC publishers can copy it with memcpy or place it in shared memory.
+struct PathCompactMatchedPoint2D
+{
+  PathCompactMatchedPoint2D();
+
+  explicit PathCompactMatchedPoint2D(const PathMatchedPoint2D & matchedPoint);
+
+  double x;
+  double y;
+  double course;
+  double curvature;
+  PathCompactFrenetPose2D frenetPose;
+  double futureCurvature;
+  double desiredSpeed;
+  double sectionMinimalCurvilinearAbscissa;
+  double sectionMaximalCurvilinearAbscissa;
+  std::uint64_t sectionIndex;
+  std::uint64_t curveIndex;
+};
+
+std::ostream & operator<<(std::ostream & os, const PathCompactMatchedPoint2D & matchedPoint);
+
+// Matched point with a null covariance
+PathMatchedPoint2D toMatchedPoint(const PathCompactMatchedPoint2D & matchedPoint);
+
+double direction(const PathCompactMatchedPoint2D & matchedPoint);
+
+Eigen::Vector2d globalPosition(const PathCompactMatchedPoint2D & matchedPoint);
+
+const PathCompactMatchedPoint2D * findMatchedPointBySectionIndex(
+  const PathCompactMatchedPoint2D * first,
+  const PathCompactMatchedPoint2D * last,
+  const size_t & sectionIndex);
+
+// Fill a caller owned buffer, its capacity is reused from one call to the next
+void compact(
+  const std::vector<PathMatchedPoint2D> & matchedPoints,
+  std::vector<PathCompactMatchedPoint2D> & compactMatchedPoints);
+
 
 }  // namespace core
 }  // namespace romea
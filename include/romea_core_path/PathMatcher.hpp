@@ -0,0 +1,108 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_PATH__PATHMATCHER_HPP_
+#define ROMEA_CORE_PATH__PATHMATCHER_HPP_
+
+// std
+#include <limits>
+#include <optional>
+#include <vector>
+
+// romea
+#include "romea_core_common/geometry/PoseAndTwist2D.hpp"
+#include "romea_core_path/Path2D.hpp"
+#include "romea_core_path/PathMatchedPoint2D.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+struct PathMatcherParameters
+{
+  double timeHorizon = 0.2;
+  double researchRadius = 10;
+  // The curvilinear abscissa interval searched around the tracked point is
+  // researchLengthFactor times the distance travelled since the previous
+  // call, bounded by the minimal and maximal research lengths
+  double researchLengthFactor = 4.;
+  double minimalResearchLength = 1.;
+  double maximalResearchLength = std::numeric_limits<double>::max();
+  // When the tracked point is lost, search the whole path within the same
+  // call instead of waiting for the next one
+  bool globalMatchingOnLoss = false;
+  // Track the matched point with a few Newton steps from the previous one, the
+  // tracked match is only done when they fail or near the section ends
+  bool newtonWarmStart = true;
+  // Search the tracked candidates outward from the tracked curve index, see
+  // PathSectionMatching2D for the heuristic bound stopping the search
+  bool outwardCandidateSearch = false;
+  bool propagateCovariance = true;
+};
+
+// Matching state of a vehicle following a path. A global match is done until
+// the vehicle is located, then tracked matches around the previous matched
+// point. Results and scratch data live in buffers owned by the matcher, once
+// they have grown to the number of sections matched at once, calls do not
+// allocate anymore.
+class PathMatcher
+{
+public:
+  explicit PathMatcher(
+    const Path2D & path,
+    const PathMatcherParameters & parameters = PathMatcherParameters());
+
+  // Matched points sorted from the best one, empty when the vehicle is lost.
+  // The returned buffer is overwritten by the next call.
+  const std::vector<PathMatchedPoint2D> & match(
+    const Pose2D & vehiclePose,
+    const double & vehicleSpeed,
+    const double & stamp);
+
+  bool isTracking() const;
+
+  const std::optional<PathMatchedPoint2D> & getTrackedPoint() const;
+
+  // The next call does a global match
+  void reset();
+
+  // Bind the matcher to a new path, the tracked point is remapped onto it when
+  // both paths share the geometry around it. The previous path must still be
+  // alive during the call.
+  void setPath(const Path2D & path);
+
+  const Path2D & getPath() const;
+
+  const PathMatcherParameters & getParameters() const;
+
+private:
+  double computeResearchLength_(const double & vehicleSpeed, const double & stamp) const;
+
+private:
+  const Path2D * path_;
+  PathMatcherParameters parameters_;
+
+  std::optional<PathMatchedPoint2D> trackedPoint_;
+  double previousStamp_;
+
+  std::vector<PathMatchedPoint2D> matchedPoints_;
+  std::vector<size_t> sectionIndexes_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHMATCHER_HPP_
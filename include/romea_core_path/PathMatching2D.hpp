@@ -35,7 +35,8 @@ std::vector<PathMatchedPoint2D> match(
   const Pose2D & vehiclePose,
   const double & vehicleSpeed,
   const double & time_horizon,
-  const double & researchRadius);
+  const double & researchRadius,
+  bool propagateCovariance = true);
 
 std::vector<PathMatchedPoint2D> match(
   const Path2D & path,
@@ -44,8 +45,11 @@ std::vector<PathMatchedPoint2D> match(
   const PathMatchedPoint2D & previousMatchedPoint,
   const double & expectedTravelledDistance,
   const double & time_horizon,
-  const double & researchRadius);
+  const double & researchRadius,
+  bool propagateCovariance = true);
 
+// outwardSearch expands the candidate search from previousCurveIndex, see the
+// matching of PathSection2D for the bound it relies on
 std::vector<PathMatchedPoint2D> match(
   const Path2D & path,
   const Pose2D & vehiclePose,
@@ -54,7 +58,73 @@ std::vector<PathMatchedPoint2D> match(
   const size_t & previousCurveIndex,
   const Interval<double> & curvilinearAbscissaInterval,
   const double & time_horizon,
-  const double & researchRadius);
+  const double & researchRadius,
+  bool propagateCovariance = true,
+  bool outwardSearch = false);
+
+// Same matchings writing their results to caller owned buffers, the capacity
+// of matchedPoints and sectionIndexes is reused so that repeated calls do not
+// allocate once the buffers have grown
+void match(
+  const Path2D & path,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const double & time_horizon,
+  const double & researchRadius,
+  std::vector<PathMatchedPoint2D> & matchedPoints,
+  std::vector<size_t> & sectionIndexes,
+  bool propagateCovariance = true);
+
+void match(
+  const Path2D & path,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const size_t & previousSectionIndex,
+  const size_t & previousCurveIndex,
+  const Interval<double> & curvilinearAbscissaInterval,
+  const double & time_horizon,
+  const double & researchRadius,
+  std::vector<PathMatchedPoint2D> & matchedPoints,
+  bool propagateCovariance = true,
+  bool outwardSearch = false);
+
+// Same matchings without covariance propagation writing compact matched points,
+// which are about half the size of PathMatchedPoint2D, for callers that store or
+// publish the results and do not use the covariance
+void match(
+  const Path2D & path,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const double & time_horizon,
+  const double & researchRadius,
+  std::vector<PathCompactMatchedPoint2D> & matchedPoints,
+  std::vector<size_t> & sectionIndexes);
+
+void match(
+  const Path2D & path,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const size_t & previousSectionIndex,
+  const size_t & previousCurveIndex,
+  const Interval<double> & curvilinearAbscissaInterval,
+  const double & time_horizon,
+  const double & researchRadius,
+  std::vector<PathCompactMatchedPoint2D> & matchedPoints,
+  bool outwardSearch = false);
+
+// Tracked matching warm started from the previous matched point by Newton steps
+// on its curve. Nothing is returned when the iterations diverge, when the result
+// leaves curvilinearAbscissaInterval or when this interval overlaps another
+// section, the caller then falls back to the tracked match above.
+std::optional<PathMatchedPoint2D> warmStartedMatch(
+  const Path2D & path,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const PathMatchedPoint2D & previousMatchedPoint,
+  const Interval<double> & curvilinearAbscissaInterval,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance = true);
 
 }  // namespace core
 }  // namespace romea
@@ -0,0 +1,141 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_CORE_PATH__PATHMATCHINGINSTRUMENTATION_HPP_
+#define ROMEA_CORE_PATH__PATHMATCHINGINSTRUMENTATION_HPP_
+
+// std
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace romea
+{
+namespace core
+{
+
+// Timings and counters of the matching hot path. They are only recorded when the
+// library is built with ROMEA_CORE_PATH_ENABLE_INSTRUMENTATION (cmake option
+// ENABLE_MATCHING_INSTRUMENTATION), otherwise the probes compile to nothing and
+// snapshots stay empty.
+
+enum class MatchingStage
+{
+  MATCH,
+  CANDIDATE_SEARCH,
+  CURVE_LOOKUP,
+  ROOT_SOLVE,
+  FUTURE_CURVATURE,
+  SORT,
+  NUMBER_OF_STAGES
+};
+
+enum class MatchingCounter
+{
+  SECTIONS_PROBED,
+  POINTS_SCANNED,
+  CURVES_FITTED,
+  MATCH_LOSSES,
+  NUMBER_OF_COUNTERS
+};
+
+struct LatencyHistogram
+{
+  // bin n counts the durations in [2^(n-1), 2^n) nanoseconds
+  static constexpr size_t NUMBER_OF_BINS = 40;
+
+  std::array<std::uint64_t, NUMBER_OF_BINS> bins = {};
+  std::uint64_t count = 0;
+  std::uint64_t totalNanoseconds = 0;
+  std::uint64_t maximalNanoseconds = 0;
+
+  double meanNanoseconds() const;
+
+  // upper bound of the bin holding the q quantile
+  std::uint64_t quantileNanoseconds(const double & q) const;
+};
+
+struct MatchingInstrumentationSnapshot
+{
+  std::array<LatencyHistogram, size_t(MatchingStage::NUMBER_OF_STAGES)> stages;
+  std::array<std::uint64_t, size_t(MatchingCounter::NUMBER_OF_COUNTERS)> counters = {};
+
+  const LatencyHistogram & stage(const MatchingStage & stage) const;
+
+  std::uint64_t counter(const MatchingCounter & counter) const;
+};
+
+constexpr bool isMatchingInstrumentationEnabled()
+{
+#ifdef ROMEA_CORE_PATH_ENABLE_INSTRUMENTATION
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Values accumulated by all threads since the last reset
+MatchingInstrumentationSnapshot getMatchingInstrumentationSnapshot();
+
+void resetMatchingInstrumentation();
+
+namespace instrumentation
+{
+
+void record(const MatchingStage & stage, const std::uint64_t & nanoseconds);
+
+void add(const MatchingCounter & counter, const std::uint64_t & value);
+
+class ScopedTimer
+{
+public:
+  explicit ScopedTimer(const MatchingStage & stage)
+  : stage_(stage),
+    start_(std::chrono::steady_clock::now())
+  {
+  }
+
+  ~ScopedTimer()
+  {
+    auto duration = std::chrono::steady_clock::now() - start_;
+    record(stage_, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+  }
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer & operator=(const ScopedTimer &) = delete;
+
+private:
+  MatchingStage stage_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace instrumentation
+
+}  // namespace core
+}  // namespace romea
+
+#ifdef ROMEA_CORE_PATH_ENABLE_INSTRUMENTATION
+#define ROMEA_PATH_INSTRUMENTATION_CONCAT_(a, b) a ## b
+#define ROMEA_PATH_INSTRUMENTATION_CONCAT(a, b) ROMEA_PATH_INSTRUMENTATION_CONCAT_(a, b)
+#define ROMEA_PATH_TIME_SCOPE(stage) \
+  romea::core::instrumentation::ScopedTimer \
+  ROMEA_PATH_INSTRUMENTATION_CONCAT(romea_path_timer_, __LINE__)(romea::core::MatchingStage::stage)
+#define ROMEA_PATH_COUNT(counter, value) \
+  romea::core::instrumentation::add(romea::core::MatchingCounter::counter, value)
+#else
+#define ROMEA_PATH_TIME_SCOPE(stage) static_cast<void>(0)
+#define ROMEA_PATH_COUNT(counter, value) static_cast<void>(0)
+#endif
+
+#endif  // ROMEA_CORE_PATH__PATHMATCHINGINSTRUMENTATION_HPP_
@@ -0,0 +1,101 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_PATH__PATHMATCHINGREPLAY_HPP_
+#define ROMEA_CORE_PATH__PATHMATCHINGREPLAY_HPP_
+
+// std
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_core_common/geometry/PoseAndTwist2D.hpp"
+#include "romea_core_path/Path2D.hpp"
+#include "romea_core_path/PathMatchedPoint2D.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+struct PoseLogRecord
+{
+  double stamp;
+  Pose2D pose;
+  double speed;
+};
+
+using PoseLog = std::vector<PoseLogRecord>;
+
+// Pose logs are either csv files with stamp,x,y,yaw,speed columns (a header
+// line and lines starting with # are skipped) or, when the file name ends with
+// .bin, raw records of five native doubles in the same order
+PoseLog loadPoseLog(const std::string & filename);
+
+void savePoseLog(const std::string & filename, const PoseLog & log);
+
+struct MatchingReplayParameters
+{
+  double timeHorizon = 0.2;
+  double researchRadius = 10;
+  // length of the curvilinear abscissa interval searched around the previous
+  // matched point, widened to four times the travelled distance at high speed
+  double minimalResearchLength = 1.;
+  // Newton steps from the previous matched point before the tracked match
+  bool newtonWarmStart = true;
+  // candidates searched outward from the previous curve index
+  bool outwardCandidateSearch = false;
+};
+
+struct MatchingReplayResult
+{
+  // one entry per log record, empty when matching failed
+  std::vector<std::optional<PathMatchedPoint2D>> matchedPoints;
+  std::vector<std::uint64_t> latencyNanoseconds;
+  // indexes of the records where a tracked point was lost
+  std::vector<size_t> matchLosses;
+};
+
+struct MatchingReplayStatistics
+{
+  size_t numberOfPoses = 0;
+  size_t numberOfMatchLosses = 0;
+  double matchesPerSecond = 0;
+  std::uint64_t p50Nanoseconds = 0;
+  std::uint64_t p99Nanoseconds = 0;
+  std::uint64_t maximalNanoseconds = 0;
+};
+
+// Replay the log as the path following node does: a global match until the
+// vehicle is located, then tracked matches around the previous matched point
+MatchingReplayResult replayMatching(
+  const Path2D & path,
+  const PoseLog & log,
+  const MatchingReplayParameters & parameters = {});
+
+MatchingReplayStatistics computeStatistics(const MatchingReplayResult & result);
+
+// Write stamp,section,curve,s,lateral_deviation,course_deviation rows
+void saveMatchedFrenetPoses(
+  const std::string & filename,
+  const PoseLog & log,
+  const MatchingReplayResult & result);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHMATCHINGREPLAY_HPP_
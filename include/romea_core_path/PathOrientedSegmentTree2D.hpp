@@ -0,0 +1,132 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_PATH__PATHORIENTEDSEGMENTTREE2D_HPP_
+#define ROMEA_CORE_PATH__PATHORIENTEDSEGMENTTREE2D_HPP_
+
+// eigen
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// std
+#include <cstdint>
+#include <vector>
+
+// romea
+#include "romea_core_common/geometry/PoseAndTwist2D.hpp"
+#include "romea_core_common/math/Interval.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Acceleration structure of the nearest oriented point search of a section.
+// For each way point it stores the unit direction to the next point (the last
+// point keeps the direction of the previous one) and whether the way point is
+// driven backward. Chunks of points are grouped in a tree where each node holds
+// the bounding box of its points and the cone of their travel directions, so
+// that whole chunks are skipped when they are farther than the current nearest
+// point or when none of their points can match the vehicle orientation.
+// The tree is updated when a point is added, positions are not duplicated and
+// are given to the search by the section.
+class PathOrientedSegmentTree2D
+{
+public:
+  static constexpr size_t BRANCHING_FACTOR = 16;
+
+  struct Node
+  {
+    Node();
+
+    Eigen::AlignedBox2d box;
+    // travel direction angles are in [coneStart, coneStart + coneWidth],
+    // a width greater or equal to pi means that the node cannot be rejected
+    double coneStart;
+    double coneWidth;
+  };
+
+  using Directions = std::vector<Eigen::Vector2d>;
+
+public:
+  PathOrientedSegmentTree2D();
+
+  void addPoint(const Eigen::Vector2d & position, const double & speed);
+
+  // Bulk insertion into an empty tree: the travel angle of each point is only
+  // computed once and levels are built bottom up. Cones may be narrower than
+  // when points are added one by one, as these also merge the provisional
+  // direction of the last added point, search results are the same.
+  void addPoints(const double * X, const double * Y, const double * speeds, const size_t & size);
+
+  void reserve(size_t n);
+
+  void clear();
+
+  size_t size()const;
+
+  const Directions & getDirections()const;
+
+  Eigen::AlignedBox2d getBoundingBox()const;
+
+  bool isBackward(const size_t & pointIndex)const;
+
+  // Same result as a linear scan of the index range keeping the nearest point
+  // whose direction dot product with the pose heading has the sign of its speed
+  size_t findNearestOrientedPointIndex(
+    const double * X,
+    const double * Y,
+    const Pose2D & pose,
+    const Interval<size_t> & indexRange,
+    const double & researchRadius)const;
+
+  // Same search also giving the number of points whose distance was computed,
+  // the points of pruned nodes are not counted
+  size_t findNearestOrientedPointIndex(
+    const double * X,
+    const double * Y,
+    const Pose2D & pose,
+    const Interval<size_t> & indexRange,
+    const double & researchRadius,
+    size_t & numberOfVisitedPoints)const;
+
+private:
+  struct Query;
+
+  void extendBoxes_(const size_t & pointIndex, const Eigen::Vector2d & position);
+
+  void extendCones_(const size_t & pointIndex);
+
+  void addLevel_();
+
+  double travelAngle_(const size_t & pointIndex, bool & degenerated)const;
+
+  void search_(
+    const size_t & level,
+    const size_t & nodeIndex,
+    const size_t & nodeSpan,
+    Query & query)const;
+
+private:
+  Directions directions_;
+  std::vector<std::uint64_t> backward_;
+  std::vector<std::vector<Node>> levels_;
+  Eigen::Vector2d lastPosition_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHORIENTEDSEGMENTTREE2D_HPP_
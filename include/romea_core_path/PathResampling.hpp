@@ -0,0 +1,56 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_PATH__PATHRESAMPLING_HPP_
+#define ROMEA_CORE_PATH__PATHRESAMPLING_HPP_
+
+// std
+#include <vector>
+
+// romea
+#include "romea_core_path/Path2D.hpp"
+#include "romea_core_path/PathWayPoint2D.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Way points of a section resampled along the curves fitted on them, each one
+// exactly step meters from the previous one. The first and last way points are
+// kept, so only the last step can be shorter. The resampled points lie on the
+// fitted curves, hence within the fitting error of the original path, and the
+// chords between them stray from these curves by at most step^2 * curvature / 8.
+// The desired speed of a resampled point is the one of the nearest way point.
+std::vector<PathWayPoint2D> resampleWayPoints(
+  const std::vector<PathWayPoint2D> & wayPoints,
+  const double & step,
+  const double & interpolationWindowLength,
+  const size_t & polynomialDegree = 2);
+
+// Path built from resampled sections, whose abscissa lookups are then done by
+// index arithmetic. Annotations are moved to the resampled point nearest in
+// curvilinear abscissa to their original point.
+Path2D resamplePath(
+  const Path2D::WayPoints & wayPoints,
+  const double & step,
+  const double & interpolationWindowLength,
+  const Path2D::Annotations & annotations = {},
+  const size_t & polynomialDegree = 2);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHRESAMPLING_HPP_
@@ -26,6 +26,7 @@
 #include "romea_core_common/containers/Eigen/DequeOfEigenVector.hpp"
 #include "romea_core_path/CumulativeSum.hpp"
 #include "romea_core_path/PathCurve2D.hpp"
+#include "romea_core_path/PathOrientedSegmentTree2D.hpp"
 #include "romea_core_path/PathWayPoint2D.hpp"
 
 
@@ -40,7 +41,17 @@ class PathSection2D
 {
 public:
   using Vector = std::vector<double, Eigen::aligned_allocator<double>>;
-  using CurvilinearAbscissa = CumulativeSum<double, Eigen::aligned_allocator<double>>;
+  // abscissae of long paths are summed with compensation to avoid any drift
+  using CurvilinearAbscissa =
+    CumulativeSum<double, Eigen::aligned_allocator<double>, CompensatedSummation>;
+
+  // Way points stored by columns, as in the section
+  struct WayPointColumns
+  {
+    Vector x;
+    Vector y;
+    Vector speeds;
+  };
 
 public:
   PathSection2D(
@@ -52,8 +63,25 @@ public:
 
   void addWayPoints(const std::vector<PathWayPoint2D> & wayPoints);
 
+  // The columns are moved into an empty section instead of being copied
+  void addWayPoints(WayPointColumns && wayPoints);
+
+  // The columns are copied into arrays allocated once
+  void addWayPoints(
+    const double * x,
+    const double * y,
+    const double * speeds,
+    const size_t & size);
+
   const PathCurve2D & getCurve(const size_t & pointIndex) const;
 
+  void setCurve(const size_t & pointIndex, const PathCurve2D & curve);
+
+  // Degree (2 or 3) of the curves fitted from now on, already fitted curves are dropped
+  void setPolynomialDegree(const size_t & polynomialDegree);
+
+  size_t getPolynomialDegree()const;
+
   const Vector & getX()const;
 
   const Vector & getY()const;
@@ -62,8 +90,17 @@ public:
 
   const Vector & getSpeeds() const;
 
+  const PathOrientedSegmentTree2D & getSegmentTree() const;
+
+  Eigen::AlignedBox2d getBoundingBox() const;
+
   const double & getLength()const;
 
+  // Arc length between consecutive way points when they are all the same, as
+  // for resampled sections, except for a shorter last one. Abscissa lookups
+  // are then done by index arithmetic. Null when the spacing is irregular.
+  const double & getUniformStep()const;
+
   size_t getInitialPointIndex()const;
 
   void reserve(size_t n);
@@ -90,6 +127,14 @@ public:
 private:
   void incrementCurvilinearAbscissa_();
 
+  void updateUniformStep_(const double & ds, bool firstStep);
+
+  // Abscissae, curve slots and segment tree of the way points set in the
+  // columns of an empty section
+  void initializeFromColumns_();
+
+  size_t findUniformIndex_(const double & value, bool strict) const;
+
   void computePathCurve_(const size_t & pointIndex)const;
 
   Interval<double> computeCurvilinearAbscissaInterval_(
@@ -103,10 +148,15 @@ private:
 
   mutable std::vector<std::optional<PathCurve2D>> curves_;
   Vector speeds_;
+  PathOrientedSegmentTree2D segmentTree_;
 
   size_t initial_point_index_;
   double interpolationWindowLength_;
+  size_t polynomialDegree_;
   double length_;
+
+  double uniformStep_;
+  bool hasShortLastStep_;
 };
 
 }  // namespace core
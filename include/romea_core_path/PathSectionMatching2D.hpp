@@ -21,7 +21,10 @@
 
 // romea
 #include "romea_core_path/Path2D.hpp"
+#include "romea_core_path/PathCompactSection2D.hpp"
+#include "romea_core_path/PathInterleavedSection2D.hpp"
 #include "romea_core_path/PathMatchedPoint2D.hpp"
+#include "romea_core_path/PathSplineSection2D.hpp"
 #include "romea_core_common/geometry/PoseAndTwist2D.hpp"
 
 
@@ -30,12 +33,16 @@ namespace romea
 namespace core
 {
 
+// The Frenet pose covariance is only propagated from the vehicle pose one when
+// propagateCovariance is set, it is left null otherwise
+
 std::optional<PathMatchedPoint2D> match(
   const PathSection2D & section,
   const Pose2D & vehiclePose,
   const double & vehicleSpeed,
   const double & time_horizon,
-  const double & researchRadius);
+  const double & researchRadius,
+  bool propagateCovariance = true);
 
 std::optional<PathMatchedPoint2D> match(
   const PathSection2D & section,
@@ -44,8 +51,14 @@ std::optional<PathMatchedPoint2D> match(
   const PathMatchedPoint2D & previousMatchedPoint,
   const double & expectedTravelledDistance,
   const double & time_horizon,
-  const double & researchRadius);
+  const double & researchRadius,
+  bool propagateCovariance = true);
 
+// With outwardSearch, the nearest way point is searched from previousCurveIndex
+// outward and each side stops once its arc length from previousCurveIndex
+// exceeds the best distance found. This bound takes chords for arc lengths and
+// is only a heuristic where the section bends back on itself within the
+// interval, the whole interval is scanned otherwise.
 std::optional<PathMatchedPoint2D> match(
   const PathSection2D & section,
   const Pose2D & vehiclePose,
@@ -53,12 +66,91 @@ std::optional<PathMatchedPoint2D> match(
   const size_t & previousCurveIndex,
   const Interval<double> & curvilinearAbscissaInterval,
   const double & time_horizon,
-  const double & researchRadius);
+  const double & researchRadius,
+  bool propagateCovariance = true,
+  bool outwardSearch = false);
+
+std::optional<PathMatchedPoint2D> match(
+  const PathInterleavedSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance = true);
+
+std::optional<PathMatchedPoint2D> match(
+  const PathInterleavedSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const PathMatchedPoint2D & previousMatchedPoint,
+  const double & expectedTravelledDistance,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance = true);
+
+std::optional<PathMatchedPoint2D> match(
+  const PathCompactSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance = true);
+
+std::optional<PathMatchedPoint2D> match(
+  const PathCompactSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const PathMatchedPoint2D & previousMatchedPoint,
+  const double & expectedTravelledDistance,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance = true);
+
+std::optional<PathMatchedPoint2D> match(
+  const PathSplineSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance = true);
 
 std::optional<PathMatchedPoint2D> match(
+  const PathSplineSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const PathMatchedPoint2D & previousMatchedPoint,
+  const double & expectedTravelledDistance,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance = true);
+
+// Tracked matching warm started from the previous matched point: Newton steps
+// on its curve, moving to the neighbouring curves while the abscissa leaves
+// them. Nothing is returned when the iterations diverge or when the abscissa
+// leaves the section, the caller then falls back to the tracked match above.
+std::optional<PathMatchedPoint2D> warmStartedMatch(
+  const PathSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const PathMatchedPoint2D & previousMatchedPoint,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance = true);
+
+std::optional<PathMatchedPoint2D> match(
+  const PathCurve2D & curve,
+  const Pose2D & vehiclePose,
+  const double & desiredSpeed,
+  bool propagateCovariance = true);
+
+// Frenet pose of the vehicle without covariance, written to frenetPose, for
+// batches of poses keeping a quarter of the size of full matched points.
+// Return false when the vehicle pose can not be matched on the curve.
+bool match(
   const PathCurve2D & curve,
   const Pose2D & vehiclePose,
-  const double & desiredSpeed);
+  const double & desiredSpeed,
+  PathCompactFrenetPose2D & frenetPose);
 
 }  // namespace core
 }  // namespace romea
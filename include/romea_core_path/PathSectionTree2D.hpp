@@ -0,0 +1,76 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_PATH__PATHSECTIONTREE2D_HPP_
+#define ROMEA_CORE_PATH__PATHSECTIONTREE2D_HPP_
+
+// eigen
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// std
+#include <vector>
+
+namespace romea
+{
+namespace core
+{
+
+// Static bounding volume hierarchy over the bounding boxes of the sections of
+// a path, built once by median splits along the longest box axis. It is used
+// to visit only the sections that may hold a point within the research radius.
+class PathSectionTree2D
+{
+public:
+  using Boxes = std::vector<Eigen::AlignedBox2d>;
+
+  static constexpr size_t MAXIMAL_LEAF_SIZE = 4;
+
+public:
+  PathSectionTree2D();
+
+  explicit PathSectionTree2D(const Boxes & sectionBoxes);
+
+  size_t size()const;
+
+  // Fill sectionIndexes, in increasing order, with the indexes of the sections
+  // whose box inflated by the research radius contains the position
+  void findSections(
+    const Eigen::Vector2d & position,
+    const double & researchRadius,
+    std::vector<size_t> & sectionIndexes)const;
+
+private:
+  struct Node
+  {
+    Eigen::AlignedBox2d box;
+    // leaf when count is not null, otherwise the left child follows the node
+    size_t first;
+    size_t count;
+    size_t right;
+  };
+
+  size_t build_(const size_t & first, const size_t & last);
+
+private:
+  Boxes boxes_;
+  std::vector<size_t> order_;
+  std::vector<Node> nodes_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHSECTIONTREE2D_HPP_
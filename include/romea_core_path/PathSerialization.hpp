@@ -0,0 +1,64 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_CORE_PATH__PATHSERIALIZATION_HPP_
+#define ROMEA_CORE_PATH__PATHSERIALIZATION_HPP_
+
+// std
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+
+// romea
+#include "romea_core_path/Path2D.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Content hash of everything a Path2D is built from
+std::uint64_t computePathHash(
+  const Path2D::WayPoints & wayPoints,
+  const double & interpolationWindowLength,
+  const Path2D::Annotations & annotations = {},
+  const size_t & polynomialDegree = 2);
+
+// Write a fully built path (way points, fitted curves and annotations) as a binary blob
+void savePath(
+  std::ostream & os,
+  const Path2D & path,
+  const std::uint64_t & hash);
+
+// Read a path written by savePath without fitting any curve.
+// Return nothing when the blob is invalid or when its hash differs from expectedHash.
+std::optional<Path2D> loadPath(
+  std::istream & is,
+  const std::uint64_t & expectedHash);
+
+// Load the path from the cache file when its hash matches the inputs,
+// otherwise build it and (re)write the cache file
+Path2D loadOrBuildPath(
+  const std::string & cacheFilename,
+  const Path2D::WayPoints & wayPoints,
+  const double & interpolationWindowLength,
+  const Path2D::Annotations & annotations = {},
+  const size_t & polynomialDegree = 2);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHSERIALIZATION_HPP_
@@ -0,0 +1,70 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_PATH__PATHSIMPLIFICATION_HPP_
+#define ROMEA_CORE_PATH__PATHSIMPLIFICATION_HPP_
+
+// std
+#include <vector>
+
+// romea
+#include "romea_core_path/Path2D.hpp"
+#include "romea_core_path/PathWayPoint2D.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+struct PathSimplificationParameters
+{
+  // Maximal distance between a removed way point and the chord joining the
+  // kept ones around it, so curved parts keep more points than straight ones
+  double tolerance = 0.01;
+  // Maximal difference between the desired speed of a removed way point and
+  // the ones of the kept way points around it, the speed being read on the
+  // nearest way point. With 0 every speed change is kept.
+  double speedTolerance = 0.;
+  // Maximal curvilinear abscissa between kept way points, it must stay below
+  // interpolationWindowLength / (polynomialDegree + 2) for each fitting window
+  // to hold enough points
+  double maximalSpacing = 0.75;
+};
+
+// Indexes of the way points kept by a Douglas-Peucker simplification. The
+// first and last way points and the required indexes are always kept.
+std::vector<size_t> findSimplifiedWayPointIndexes(
+  const std::vector<PathWayPoint2D> & wayPoints,
+  const PathSimplificationParameters & parameters,
+  const std::vector<size_t> & requiredIndexes = {});
+
+std::vector<PathWayPoint2D> simplifyWayPoints(
+  const std::vector<PathWayPoint2D> & wayPoints,
+  const PathSimplificationParameters & parameters);
+
+// Path built from simplified sections. Section boundaries are unchanged and
+// annotated way points are kept, their annotations being moved to the index of
+// these way points in the simplified path.
+Path2D simplifyPath(
+  const Path2D::WayPoints & wayPoints,
+  const PathSimplificationParameters & parameters,
+  const double & interpolationWindowLength,
+  const Path2D::Annotations & annotations = {},
+  const size_t & polynomialDegree = 2);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHSIMPLIFICATION_HPP_
@@ -0,0 +1,104 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_CORE_PATH__PATHSPLINE2D_HPP_
+#define ROMEA_CORE_PATH__PATHSPLINE2D_HPP_
+
+// std
+#include <array>
+#include <optional>
+#include <vector>
+
+// romea
+#include "romea_core_common/math/Interval.hpp"
+#include "romea_core_path/PathCurve2D.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Natural cubic spline x(s), y(s) interpolating all the way points of a section,
+// parametrized by the curvilinear abscissa of the way points polyline. It is C2
+// and stores one cubic per interval between two consecutive way points, instead
+// of one overlapping local fit per way point as PathCurve2D does.
+class PathSpline2D
+{
+public:
+  using Vector = PathCurve2D::Vector;
+
+  // Coefficients of x and y as polynomials of t = s - knot
+  struct Segment
+  {
+    std::array<double, 4> x;
+    std::array<double, 4> y;
+  };
+
+  using Segments = std::vector<Segment>;
+
+public:
+  PathSpline2D();
+
+  void estimate(const Vector & X, const Vector & Y, const Vector & S);
+
+  // Index of the segment holding s, searched from segmentHint (O(1) when the
+  // hint is the right segment or a neighbour, binary search otherwise)
+  size_t findSegmentIndex(const double & curvilinearAbscissa) const;
+
+  size_t findSegmentIndex(
+    const double & curvilinearAbscissa,
+    const size_t & segmentHint) const;
+
+  std::optional<double> findNearestCurvilinearAbscissa(
+    const Eigen::Vector2d & vehiclePosition,
+    const Interval<size_t> & segmentRange) const;
+
+  Eigen::Vector2d computePosition(
+    const double & curvilinearAbscissa,
+    const size_t & segmentIndex) const;
+
+  double computeTangent(
+    const double & curvilinearAbscissa,
+    const size_t & segmentIndex) const;
+
+  Eigen::Vector2d computeDirection(
+    const double & curvilinearAbscissa,
+    const size_t & segmentIndex) const;
+
+  double computeCurvature(
+    const double & curvilinearAbscissa,
+    const size_t & segmentIndex) const;
+
+  const Vector & getKnots() const;
+
+  const Segments & getSegments() const;
+
+  size_t size() const;
+
+  void clear();
+
+private:
+  std::optional<double> findNearestCurvilinearAbscissa_(
+    const Eigen::Vector2d & vehiclePosition,
+    const size_t & segmentIndex) const;
+
+private:
+  Vector knots_;
+  Segments segments_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHSPLINE2D_HPP_
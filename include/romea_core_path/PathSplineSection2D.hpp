@@ -0,0 +1,102 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_CORE_PATH__PATHSPLINESECTION2D_HPP_
+#define ROMEA_CORE_PATH__PATHSPLINESECTION2D_HPP_
+
+// std
+#include <vector>
+
+// romea
+#include "romea_core_common/math/Interval.hpp"
+#include "romea_core_path/CumulativeSum.hpp"
+#include "romea_core_path/PathSpline2D.hpp"
+#include "romea_core_path/PathWayPoint2D.hpp"
+
+
+namespace romea
+{
+namespace core
+{
+
+// Section whose geometry is a single spline through all its way points instead
+// of one PathCurve2D per way point. The spline is (re)built on first access
+// after way points have been added.
+class PathSplineSection2D
+{
+public:
+  using Vector = std::vector<double, Eigen::aligned_allocator<double>>;
+  using CurvilinearAbscissa =
+    CumulativeSum<double, Eigen::aligned_allocator<double>, CompensatedSummation>;
+
+public:
+  explicit PathSplineSection2D(
+    const double & initialCurvilinearAbcissa = 0,
+    size_t initialPointIndex = 0);
+
+  void addWayPoint(const PathWayPoint2D & wayPoint);
+
+  void addWayPoints(const std::vector<PathWayPoint2D> & wayPoints);
+
+  const PathSpline2D & getSpline() const;
+
+  const Vector & getX()const;
+
+  const Vector & getY()const;
+
+  const CurvilinearAbscissa & getCurvilinearAbscissa()const;
+
+  const Vector & getSpeeds() const;
+
+  const double & getLength()const;
+
+  size_t getInitialPointIndex()const;
+
+  void reserve(size_t n);
+
+  size_t size()const;
+
+  void clear();
+
+
+  size_t findIndex(const double & value) const;
+
+  size_t findIndex(
+    const double & value,
+    const size_t & startSearchIndex) const;
+
+  Interval<size_t> findIntervalBoundIndexes(
+    const size_t & intervalCenterIndex,
+    const double & intervalWidth)const;
+
+  Interval<size_t> findIntervalBoundIndexes(
+    const size_t & intervalCenterIndex,
+    const Interval<double> & interval)const;
+
+private:
+  Vector X_;
+  Vector Y_;
+  CurvilinearAbscissa curvilinearAbscissa_;
+  Vector speeds_;
+
+  mutable PathSpline2D spline_;
+
+  size_t initial_point_index_;
+  double length_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHSPLINESECTION2D_HPP_
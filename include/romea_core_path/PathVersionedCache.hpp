@@ -0,0 +1,98 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_PATH__PATHVERSIONEDCACHE_HPP_
+#define ROMEA_CORE_PATH__PATHVERSIONEDCACHE_HPP_
+
+// std
+#include <cstdint>
+#include <optional>
+#include <string>
+
+// romea
+#include "romea_core_path/Path2D.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// A path is built and fitted once by a writer process and reloaded without
+// any fitting by any number of reader processes. The name is a file path, use
+// a file of /dev/shm to keep the cache in memory.
+//
+// The file <name> holds a control block with an atomic generation counter,
+// mapped by every process, and each published path is saved with savePath to
+// its own file <name>.<generation>. A new path is fully written before the
+// generation is incremented, so readers either load the previous path or the
+// new one, never a partial one. Each reader loads its own copy of the path:
+// this saves the fitting of the curves, not the memory of the readers.
+class PathVersionedCacheWriter
+{
+public:
+  explicit PathVersionedCacheWriter(const std::string & name);
+
+  PathVersionedCacheWriter(const PathVersionedCacheWriter &) = delete;
+
+  PathVersionedCacheWriter & operator=(const PathVersionedCacheWriter &) = delete;
+
+  ~PathVersionedCacheWriter();
+
+  // Publish a new path and return its generation. The path published two
+  // generations before is removed, readers that have already mapped it are
+  // not affected.
+  std::uint64_t publish(const Path2D & path);
+
+  std::uint64_t getGeneration() const;
+
+private:
+  std::string name_;
+  void * control_;
+};
+
+class PathVersionedCacheReader
+{
+public:
+  explicit PathVersionedCacheReader(const std::string & name);
+
+  PathVersionedCacheReader(const PathVersionedCacheReader &) = delete;
+
+  PathVersionedCacheReader & operator=(const PathVersionedCacheReader &) = delete;
+
+  ~PathVersionedCacheReader();
+
+  // Generation of the last published path, 0 when nothing has been published yet
+  std::uint64_t getGeneration() const;
+
+  // Load a copy of the last published path without fitting any curve and set generation
+  // to its generation. Return nothing when no path has been published yet.
+  std::optional<Path2D> load(std::uint64_t & generation) const;
+
+  // Load the last published path only when its generation differs from
+  // generation, which is then updated
+  std::optional<Path2D> loadIfUpdated(std::uint64_t & generation) const;
+
+private:
+  bool attach_() const;
+
+private:
+  std::string name_;
+  mutable const void * control_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHVERSIONEDCACHE_HPP_
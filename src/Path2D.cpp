@@ -12,7 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+// std
+#include <cassert>
+#include <utility>
+#include <vector>
+
+// romea
 #include "romea_core_path/Path2D.hpp"
+#include "romea_core_path/PathFile.hpp"
 
 namespace romea
 {
@@ -23,30 +30,144 @@ namespace core
 Path2D::Path2D(
   const WayPoints & wayPoints,
   const double & interpolationWindowLength)
+: Path2D(wayPoints, interpolationWindowLength, Annotations())
+{
+}
+
+Path2D::Path2D(
+  const WayPoints & wayPoints,
+  const double & interpolationWindowLength,
+  const Annotations & annotations,
+  const size_t & polynomialDegree)
+: sections_(),
+  sectionTree_(),
+  curvilinearAbscissa_(0),
+  length_(0),
+  interpolationWindowLength_(interpolationWindowLength),
+  polynomialDegree_(polynomialDegree)
+{
+  addSections_(wayPoints);
+  buildSectionTree_();
+  fitCurves_();
+  setAnnotations(annotations);
+
+  // std::cout << "annotations:\n";
+  // for(auto const & [i, a] : annotations_) {
+  //   std::printf("  - index: %4lu, abscissa: %7.3f, type: %-12s, value: %s\n",
+  //     i, a.abscissa, a.type.c_str(), a.value.c_str());
+  // }
+}
+
+//-----------------------------------------------------------------------------
+Path2D::Path2D(
+  WayPointColumns && wayPoints,
+  const double & interpolationWindowLength,
+  const Annotations & annotations,
+  const size_t & polynomialDegree)
 : sections_(),
+  sectionTree_(),
   curvilinearAbscissa_(0),
   length_(0),
-  interpolationWindowLength_(interpolationWindowLength)
+  interpolationWindowLength_(interpolationWindowLength),
+  polynomialDegree_(polynomialDegree)
+{
+  addSections_(std::move(wayPoints));
+  buildSectionTree_();
+  fitCurves_();
+  setAnnotations(annotations);
+}
+
+//-----------------------------------------------------------------------------
+Path2D::Path2D(
+  PathFile && file,
+  const double & interpolationWindowLength,
+  const size_t & polynomialDegree)
+: Path2D(
+    file.releaseWayPointColumns(),
+    interpolationWindowLength,
+    file.getAnnotations(),
+    polynomialDegree)
+{
+}
+
+//-----------------------------------------------------------------------------
+Path2D::Path2D(
+  const WayPoints & wayPoints,
+  const double & interpolationWindowLength,
+  const Annotations & annotations,
+  const Curves & curves,
+  const size_t & polynomialDegree)
+: sections_(),
+  sectionTree_(),
+  curvilinearAbscissa_(0),
+  length_(0),
+  interpolationWindowLength_(interpolationWindowLength),
+  polynomialDegree_(polynomialDegree)
+{
+  assert(curves.size() == wayPoints.size());
+  addSections_(wayPoints);
+  buildSectionTree_();
+
+  for (size_t i = 0; i < sections_.size(); ++i) {
+    assert(curves[i].size() == sections_[i].size());
+    for (size_t j = 0; j < sections_[i].size(); ++j) {
+      sections_[i].setCurve(j, curves[i][j]);
+    }
+  }
+
+  setAnnotations(annotations);
+}
+
+//-----------------------------------------------------------------------------
+void Path2D::addSections_(const WayPoints & wayPoints)
 {
   sections_.reserve(wayPoints.size());
 
   size_t global_point_index = 0;
   for (const auto & sectionWayPoints : wayPoints) {
     if (sections_.empty()) {
-      sections_.emplace_back(interpolationWindowLength, 0, 0);
+      sections_.emplace_back(interpolationWindowLength_, 0, 0);
+      sections_.back().setPolynomialDegree(polynomialDegree_);
       sections_.back().addWayPoints(sectionWayPoints);
     } else {
-      curvilinearAbscissa_.increment(sections_.back().getLength());
+      // each section starts exactly where the previous one ends
+      curvilinearAbscissa_.append(sections_.back().getCurvilinearAbscissa().finalValue());
 
       double finalValue = curvilinearAbscissa_.finalValue();
-      sections_.emplace_back(interpolationWindowLength, finalValue, global_point_index);
+      sections_.emplace_back(interpolationWindowLength_, finalValue, global_point_index);
+      sections_.back().setPolynomialDegree(polynomialDegree_);
       sections_.back().addWayPoints(sectionWayPoints);
     }
 
     length_ += sections_.back().getLength();
     global_point_index += sections_.back().size();
   }
+}
+
+//-----------------------------------------------------------------------------
+void Path2D::addSections_(WayPointColumns && wayPoints)
+{
+  sections_.reserve(wayPoints.size());
+
+  size_t global_point_index = 0;
+  for (auto & sectionWayPoints : wayPoints) {
+    if (!sections_.empty()) {
+      curvilinearAbscissa_.append(sections_.back().getCurvilinearAbscissa().finalValue());
+    }
+
+    double finalValue = curvilinearAbscissa_.finalValue();
+    sections_.emplace_back(interpolationWindowLength_, finalValue, global_point_index);
+    sections_.back().setPolynomialDegree(polynomialDegree_);
+    sections_.back().addWayPoints(std::move(sectionWayPoints));
+
+    length_ += sections_.back().getLength();
+    global_point_index += sections_.back().size();
+  }
+}
 
+//-----------------------------------------------------------------------------
+void Path2D::fitCurves_()
+{
   for (size_t i = 0; i < sections_.size(); ++i) {
     for (size_t j = 0; j < sections_[i].size(); ++j) {
       sections_[i].getCurve(j);
@@ -54,19 +175,35 @@ Path2D::Path2D(
   }
 }
 
-Path2D::Path2D(
-  const WayPoints & wayPoints,
-  const double & interpolationWindowLength,
-  const Annotations & annotations)
-: Path2D(wayPoints, interpolationWindowLength)
+//-----------------------------------------------------------------------------
+void Path2D::buildSectionTree_()
 {
-  setAnnotations(annotations);
+  PathSectionTree2D::Boxes boxes;
+  boxes.reserve(sections_.size());
+  for (const auto & section : sections_) {
+    boxes.push_back(section.getBoundingBox());
+  }
+  sectionTree_ = PathSectionTree2D(boxes);
+}
 
-  // std::cout << "annotations:\n";
-  // for(auto const & [i, a] : annotations_) {
-  //   std::printf("  - index: %4lu, abscissa: %7.3f, type: %-12s, value: %s\n",
-  //     i, a.abscissa, a.type.c_str(), a.value.c_str());
-  // }
+//-----------------------------------------------------------------------------
+void Path2D::findNearbySections(
+  const Eigen::Vector2d & position,
+  const double & researchRadius,
+  std::vector<size_t> & sectionIndexes) const
+{
+  if (sectionTree_.size() == sections_.size()) {
+    sectionTree_.findSections(position, researchRadius, sectionIndexes);
+    return;
+  }
+
+  sectionIndexes.clear();
+  double sqRadius = researchRadius * researchRadius;
+  for (size_t n = 0; n < sections_.size(); ++n) {
+    if (sections_[n].getBoundingBox().squaredExteriorDistance(position) < sqRadius) {
+      sectionIndexes.push_back(n);
+    }
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -87,6 +224,18 @@ size_t Path2D::size()const
   return sections_.size();
 }
 
+//-----------------------------------------------------------------------------
+const double & Path2D::getInterpolationWindowLength()const
+{
+  return interpolationWindowLength_;
+}
+
+//-----------------------------------------------------------------------------
+size_t Path2D::getPolynomialDegree()const
+{
+  return polynomialDegree_;
+}
+
 //-----------------------------------------------------------------------------
 const Path2D::CurvilinearAbscissa & Path2D::getCurvilinearAbscissa()const
 {
@@ -104,7 +253,12 @@ PathSection2D & Path2D::addEmptySection()
     initial_index = last_section.getInitialPointIndex() + last_section.size();
   }
 
-  return sections_.emplace_back(interpolationWindowLength_, abscissa, initial_index);
+  // the new section is filled by the caller, the boxes of the tree would be outdated
+  sectionTree_ = PathSectionTree2D();
+
+  auto & section = sections_.emplace_back(interpolationWindowLength_, abscissa, initial_index);
+  section.setPolynomialDegree(polynomialDegree_);
+  return section;
 }
 
 void Path2D::setAnnotations(Annotations const & annotations)
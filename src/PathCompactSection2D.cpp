@@ -0,0 +1,256 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+// romea
+#include "romea_core_path/PathCompactSection2D.hpp"
+#include "romea_core_path/PathMatchingInstrumentation.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+PathCompactSection2D::PathCompactSection2D(
+  const double & interpolationWindowLength,
+  const double & initialCurvilinearAbcissa,
+  size_t initialPointIndex)
+: points_(),
+  chunkCurvilinearAbscissae_(),
+  curves_(),
+  origin_(Eigen::Vector2d::Zero()),
+  lastPosition_(Eigen::Vector2d::Zero()),
+  initial_point_index_(initialPointIndex),
+  initialCurvilinearAbscissa_(initialCurvilinearAbcissa),
+  interpolationWindowLength_(interpolationWindowLength),
+  length_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+void PathCompactSection2D::addWayPoint(const PathWayPoint2D & wayPoint)
+{
+  if (points_.empty()) {
+    origin_ = wayPoint.position;
+  } else {
+    // the length is accumulated in double to avoid any drift of the abscissa offsets
+    length_ += (wayPoint.position - lastPosition_).norm();
+  }
+  lastPosition_ = wayPoint.position;
+
+  if (points_.size() % POINTS_PER_CHUNK == 0) {
+    chunkCurvilinearAbscissae_.push_back(length_);
+  }
+
+  Eigen::Vector2d offset = wayPoint.position - origin_;
+  points_.push_back(
+    {static_cast<float>(offset.x()),
+      static_cast<float>(offset.y()),
+      static_cast<float>(length_ - chunkCurvilinearAbscissae_.back()),
+      static_cast<float>(wayPoint.desired_speed)});
+}
+
+//-----------------------------------------------------------------------------
+void PathCompactSection2D::addWayPoints(const std::vector<PathWayPoint2D> & wayPoints)
+{
+  reserve(size() + wayPoints.size());
+  for (const auto & wayPoint : wayPoints) {
+    addWayPoint(wayPoint);
+  }
+}
+
+//-----------------------------------------------------------------------------
+const PathCurve2D & PathCompactSection2D::getCurve(const size_t & pointIndex)const
+{
+  auto it = curves_.find(pointIndex);
+  if (it == curves_.end()) {
+    return computePathCurve_(pointIndex);
+  }
+
+  return it->second;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathCompactSection2D::getNumberOfFittedCurves() const
+{
+  return curves_.size();
+}
+
+//-----------------------------------------------------------------------------
+const PathCurve2D & PathCompactSection2D::computePathCurve_(const size_t & pointIndex) const
+{
+  ROMEA_PATH_COUNT(CURVES_FITTED, 1);
+  PathCurve2D & curve = curves_[pointIndex];
+
+  double s = getCurvilinearAbscissa(pointIndex);
+  Interval<double> curvilinearAbscissaInterval(
+    s - interpolationWindowLength_ / 2., s + interpolationWindowLength_ / 2.);
+
+  Interval<size_t> indexRange = findIntervalBoundIndexes(pointIndex, curvilinearAbscissaInterval);
+
+  // the fit is done in double on the points of the window only
+  Eigen::ArrayXd X(indexRange.width() + 1);
+  Eigen::ArrayXd Y(indexRange.width() + 1);
+  Eigen::ArrayXd S(indexRange.width() + 1);
+  for (size_t n = indexRange.lower(); n <= indexRange.upper(); ++n) {
+    Eigen::Vector2d position = getPosition(n);
+    X[n - indexRange.lower()] = position.x();
+    Y[n - indexRange.lower()] = position.y();
+    S[n - indexRange.lower()] = getCurvilinearAbscissa(n);
+  }
+
+  [[maybe_unused]] bool estimated = curve.estimate(
+    X, Y, S, indexRange, curvilinearAbscissaInterval);
+
+  assert(estimated);
+  return curve;
+}
+
+//-----------------------------------------------------------------------------
+void PathCompactSection2D::reserve(size_t n)
+{
+  points_.reserve(n);
+  chunkCurvilinearAbscissae_.reserve(n / POINTS_PER_CHUNK + 1);
+}
+
+//-----------------------------------------------------------------------------
+const PathCompactSection2D::Points & PathCompactSection2D::getPoints()const
+{
+  return points_;
+}
+
+//-----------------------------------------------------------------------------
+const Eigen::Vector2d & PathCompactSection2D::getOrigin()const
+{
+  return origin_;
+}
+
+//-----------------------------------------------------------------------------
+Eigen::Vector2d PathCompactSection2D::getPosition(const size_t & pointIndex)const
+{
+  const auto & point = points_[pointIndex];
+  return {origin_.x() + point.x, origin_.y() + point.y};
+}
+
+//-----------------------------------------------------------------------------
+double PathCompactSection2D::getCurvilinearAbscissa(const size_t & pointIndex)const
+{
+  return initialCurvilinearAbscissa_ +
+    chunkCurvilinearAbscissae_[pointIndex / POINTS_PER_CHUNK] +
+    points_[pointIndex].curvilinearAbscissa;
+}
+
+//-----------------------------------------------------------------------------
+double PathCompactSection2D::getSpeed(const size_t & pointIndex)const
+{
+  return points_[pointIndex].speed;
+}
+
+//-----------------------------------------------------------------------------
+const double & PathCompactSection2D::getInitialCurvilinearAbscissa()const
+{
+  return initialCurvilinearAbscissa_;
+}
+
+//-----------------------------------------------------------------------------
+double PathCompactSection2D::getFinalCurvilinearAbscissa()const
+{
+  return points_.empty() ? initialCurvilinearAbscissa_ : getCurvilinearAbscissa(size() - 1);
+}
+
+//-----------------------------------------------------------------------------
+const double & PathCompactSection2D::getLength()const
+{
+  return length_;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathCompactSection2D::getInitialPointIndex()const
+{
+  return initial_point_index_;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathCompactSection2D::size()const
+{
+  return points_.size();
+}
+
+//-----------------------------------------------------------------------------
+void PathCompactSection2D::clear()
+{
+  points_.clear();
+  chunkCurvilinearAbscissae_.clear();
+  curves_.clear();
+  length_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathCompactSection2D::findIndex(
+  const double & value,
+  const size_t & startSearchIndex) const
+{
+  size_t n = startSearchIndex;
+  while (n < points_.size() - 1 && getCurvilinearAbscissa(n) < value) {
+    n++;
+  }
+  return n;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathCompactSection2D::findIndex(const double & value) const
+{
+  return findIndex(value, 0);
+}
+
+//-----------------------------------------------------------------------------
+Interval<size_t> PathCompactSection2D::findIntervalBoundIndexes(
+  const size_t & intervalCenterIndex,
+  const double & intervalWidth) const
+{
+  double s = getCurvilinearAbscissa(intervalCenterIndex);
+  return findIntervalBoundIndexes(
+    intervalCenterIndex, Interval<double>(s - intervalWidth / 2., s + intervalWidth / 2.));
+}
+
+//-----------------------------------------------------------------------------
+Interval<size_t> PathCompactSection2D::findIntervalBoundIndexes(
+  const size_t & intervalCenterIndex,
+  const Interval<double> & interval)const
+{
+  size_t minimalIndex = intervalCenterIndex;
+  size_t maximalIndex = intervalCenterIndex;
+
+  while (minimalIndex != 0 &&
+    interval.inside(getCurvilinearAbscissa(minimalIndex)))
+  {
+    minimalIndex--;
+  }
+
+  while (maximalIndex != points_.size() - 1 &&
+    interval.inside(getCurvilinearAbscissa(maximalIndex)))
+  {
+    maximalIndex++;
+  }
+
+  return {minimalIndex, maximalIndex};
+}
+
+}  // namespace core
+}  // namespace romea
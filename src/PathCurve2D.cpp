@@ -18,7 +18,7 @@
 // std
 #include <algorithm>
 #include <cassert>
-#include <iostream>
+#include <cmath>
 #include <limits>
 #include <optional>
 
@@ -26,57 +26,115 @@
 #include "gsl/gsl_poly.h"
 
 // romea
-
 #include "romea_core_path/PathCurve2D.hpp"
 
+// local
+#include "PathPolynomial.hpp"
+
 namespace
 {
 
-inline bool computeSecondDegreePolynomialRegressionLight(
-  const Eigen::ArrayXd & X, const Eigen::ArrayXd & Y, Eigen::Array3d & polynomCoefficient)
-{
-  double ide = 0;
-  double MCx1 = 0, MCx2 = 0, MCx3 = 0, MCx4 = 0;
-  double MCy1 = 0, MCxy = 0, MCx2y = 0;
-
-  double Xoff = X[0];
-
-  for (int i = 0; i < X.size(); i++) {
-    double Xtemp = X[i] - Xoff;
-    double Xtemp2 = Xtemp * Xtemp;
-    double Xtemp3 = Xtemp * Xtemp2;
-    double Xtemp4 = Xtemp2 * Xtemp2;
-    double Ytemp = Y[i];
-    ide = ide + 1;
-    MCx1 += Xtemp;
-    MCx2 += Xtemp2;
-    MCx3 += Xtemp3;
-    MCx4 += Xtemp4;
-    MCy1 += Ytemp;
-    MCxy += Xtemp * Ytemp;
-    MCx2y += Xtemp2 * Ytemp;
+using FitStatus = romea::core::PathCurve2D::FitStatus;
+using PolynomCoefficients = romea::core::PathCurve2D::PolynomCoefficients;
+
+// Least squares fit of V(S) by a polynomial of the given degree. The normal
+// equations are built on abscissae shifted to the first point and scaled by the
+// window span to keep them well conditioned, the solution is then expanded
+// back to a polynomial of S.
+template<int Degree>
+FitStatus computePolynomialRegression(
+  const romea::core::PathCurve2D::ConstStridedArray & S,
+  const romea::core::PathCurve2D::ConstStridedArray & V,
+  PolynomCoefficients & polynomCoefficient)
+{
+  constexpr int N = Degree + 1;
+
+  double offset = S[0];
+  double scale = S[S.size() - 1] - offset;
+  if (scale <= 0) {
+    return FitStatus::SINGULAR_MATRIX;
   }
 
-  Eigen::Matrix3d transform;
-  transform.row(0) << ide, MCx1, MCx2;
-  transform.row(1) << MCx1, MCx2, MCx3;
-  transform.row(2) << MCx2, MCx3, MCx4;
+  Eigen::Matrix<double, 2 * Degree + 1, 1> moments = Eigen::Matrix<double, 2 * Degree + 1, 1>::Zero();
+  Eigen::Matrix<double, N, 1> F = Eigen::Matrix<double, N, 1>::Zero();
+  for (Eigen::Index i = 0; i < S.size(); ++i) {
+    double t = (S[i] - offset) / scale;
+    double power = 1;
+    for (int k = 0; k <= 2 * Degree; ++k) {
+      moments[k] += power;
+      if (k < N) {
+        F[k] += power * V[i];
+      }
+      power *= t;
+    }
+  }
 
-  Eigen::Vector3d F(MCy1, MCxy, MCx2y);
+  Eigen::Matrix<double, N, N> transform;
+  for (int r = 0; r < N; ++r) {
+    for (int c = 0; c < N; ++c) {
+      transform(r, c) = moments[r + c];
+    }
+  }
 
   bool success = true;
-  Eigen::Matrix3d inverseTransform;
+  Eigen::Matrix<double, N, N> inverseTransform;
   transform.computeInverseWithCheck(inverseTransform, success);
   if (!success) {
-    std::cout << "Matrix not inversible" << std::endl;
-    return success;
+    return FitStatus::SINGULAR_MATRIX;
+  }
+
+  Eigen::Matrix<double, N, 1> scaledCoefficient = inverseTransform * F;
+
+  // Horner expansion of sum_k (c_k / scale^k) (s - offset)^k
+  polynomCoefficient.setZero();
+  for (int k = N - 1; k >= 0; --k) {
+    for (int j = 3; j > 0; --j) {
+      polynomCoefficient[j] = polynomCoefficient[j - 1] - offset * polynomCoefficient[j];
+    }
+    polynomCoefficient[0] = -offset * polynomCoefficient[0] +
+      scaledCoefficient[k] / std::pow(scale, k);
   }
 
-  polynomCoefficient = inverseTransform * F;
-  polynomCoefficient(1) = polynomCoefficient(1) - 2 * polynomCoefficient(2) * Xoff;
-  polynomCoefficient(0) =
-    polynomCoefficient(0) - polynomCoefficient(1) * Xoff - polynomCoefficient(2) * Xoff * Xoff;
-  return success;
+  return FitStatus::SUCCESS;
+}
+
+using romea::core::detail::evaluate;
+using romea::core::detail::evaluateFirstDerivative;
+using romea::core::detail::evaluateSecondDerivative;
+using romea::core::detail::unitDirection;
+
+//-----------------------------------------------------------------------------
+// Curvature from the derivatives of arrays, null when the curve is straight
+template<typename Xdd, typename Ydd>
+inline Eigen::ArrayXd curvature(
+  const Eigen::ArrayXd & Xdot,
+  const Eigen::ArrayXd & Ydot,
+  const Xdd & Xdotdot,
+  const Ydd & Ydotdot)
+{
+  Eigen::ArrayXd denominator = Xdot * Ydotdot - Ydot * Xdotdot;
+  Eigen::ArrayXd squaredSpeed = Xdot.square() + Ydot.square();
+  return (denominator.abs() <= std::numeric_limits<double>::epsilon()).select(
+    0., denominator / (squaredSpeed * squaredSpeed.sqrt()));
+}
+
+//-----------------------------------------------------------------------------
+// g(s) = 1/2 d(r^2)/ds where r is the distance between the curve and a position,
+// its derivative is returned in dg
+inline double distanceDerivative(
+  const PolynomCoefficients & fx,
+  const PolynomCoefficients & fy,
+  const Eigen::Vector2d & position,
+  const double & s,
+  double & dg)
+{
+  double ex = evaluate(fx, s) - position.x();
+  double ey = evaluate(fy, s) - position.y();
+  double dx = evaluateFirstDerivative(fx, s);
+  double dy = evaluateFirstDerivative(fy, s);
+  dg = dx * dx + dy * dy + ex * evaluateSecondDerivative(fx, s) +
+    ey * evaluateSecondDerivative(fy, s);
+  return ex * dx + ey * dy;
 }
 
 }  // namespace
@@ -86,38 +144,95 @@ namespace romea::core
 
 //-----------------------------------------------------------------------------
 PathCurve2D::PathCurve2D()
-: fxPolynomCoefficient_(Eigen::Array3d::Zero()),
-  fyPolynomCoefficient_(Eigen::Array3d::Zero()),
+: fxPolynomCoefficient_(PolynomCoefficients::Zero()),
+  fyPolynomCoefficient_(PolynomCoefficients::Zero()),
+  polynomialDegree_(2),
+  fitStatus_(FitStatus::NOT_ESTIMATED),
   indexInterval_(0, std::numeric_limits<size_t>::max())
 {
 }
 
+//-----------------------------------------------------------------------------
+PathCurve2D::PathCurve2D(
+  const PolynomCoefficients & fxPolynomCoefficient,
+  const PolynomCoefficients & fyPolynomCoefficient,
+  const size_t & polynomialDegree,
+  const Eigen::Vector2d & origin,
+  const double & originCurvilinearAbscissa,
+  const Interval<size_t> & indexInterval,
+  const Interval<double> & curvilinearAbscissaInterval)
+: fxPolynomCoefficient_(fxPolynomCoefficient),
+  fyPolynomCoefficient_(fyPolynomCoefficient),
+  polynomialDegree_(polynomialDegree),
+  fitStatus_(FitStatus::SUCCESS),
+  origin_(origin),
+  originCurvilinearAbscissa_(originCurvilinearAbscissa),
+  indexInterval_(indexInterval),
+  curvilinearAbscissaInterval_(curvilinearAbscissaInterval)
+{
+}
+
 //-----------------------------------------------------------------------------
 bool PathCurve2D::estimate(
   const Vector & X,
   const Vector & Y,
   const Vector & S,
   const Interval<size_t> & indexInterval,
-  const Interval<double> & curvilinearAbscissaInterval)
+  const Interval<double> & curvilinearAbscissaInterval,
+  const size_t & polynomialDegree)
+{
+  auto first = indexInterval.lower();
+  auto size = indexInterval.width() + 1;
+
+  return estimate(
+    Eigen::Map<const Eigen::ArrayXd>(X.data() + first, size),
+    Eigen::Map<const Eigen::ArrayXd>(Y.data() + first, size),
+    Eigen::Map<const Eigen::ArrayXd>(S.data() + first, size),
+    indexInterval,
+    curvilinearAbscissaInterval,
+    polynomialDegree);
+}
+
+//-----------------------------------------------------------------------------
+bool PathCurve2D::estimate(
+  const ConstStridedArray & X,
+  const ConstStridedArray & Y,
+  const ConstStridedArray & S,
+  const Interval<size_t> & indexInterval,
+  const Interval<double> & curvilinearAbscissaInterval,
+  const size_t & polynomialDegree)
 {
-  assert(indexInterval.width() > 2);
+  assert(polynomialDegree == 2 || polynomialDegree == 3);
 
+  polynomialDegree_ = polynomialDegree;
   indexInterval_ = indexInterval;
   curvilinearAbscissaInterval_ = curvilinearAbscissaInterval;
 
-  auto center_index = indexInterval.center();
+  assert(X.size() == static_cast<Eigen::Index>(indexInterval.width() + 1));
+
+  // at least one more point than coefficients to have a regression
+  if (indexInterval.width() <= polynomialDegree) {
+    fitStatus_ = FitStatus::NOT_ENOUGH_POINTS;
+    return false;
+  }
+
+  auto center_index = indexInterval.center() - indexInterval.lower();
   origin_ << X[center_index], Y[center_index];
   originCurvilinearAbscissa_ = S[center_index];
 
-  Eigen::Map<const Eigen::ArrayXd> Xmap(
-    X.data() + indexInterval.lower(), indexInterval.width() + 1);
-  Eigen::Map<const Eigen::ArrayXd> Ymap(
-    Y.data() + indexInterval.lower(), indexInterval.width() + 1);
-  Eigen::Map<const Eigen::ArrayXd> Smap(
-    S.data() + indexInterval.lower(), indexInterval.width() + 1);
+  if (polynomialDegree == 3) {
+    fitStatus_ = computePolynomialRegression<3>(S, X, fxPolynomCoefficient_);
+    if (fitStatus_ == FitStatus::SUCCESS) {
+      fitStatus_ = computePolynomialRegression<3>(S, Y, fyPolynomCoefficient_);
+    }
+  } else {
+    fitStatus_ = computePolynomialRegression<2>(S, X, fxPolynomCoefficient_);
+    if (fitStatus_ == FitStatus::SUCCESS) {
+      fitStatus_ = computePolynomialRegression<2>(S, Y, fyPolynomCoefficient_);
+    }
+  }
 
-  return computeSecondDegreePolynomialRegressionLight(Smap, Xmap, fxPolynomCoefficient_) &&
-         computeSecondDegreePolynomialRegressionLight(Smap, Ymap, fyPolynomCoefficient_);
+  return fitStatus_ == FitStatus::SUCCESS;
 }
 
 //-----------------------------------------------------------------------------
@@ -139,6 +254,10 @@ std::optional<double> PathCurve2D::findNearestCurvilinearAbscissa(
   //    minimalCurvilinearAbscissa = maximalCurvilinearAbscissa - 2*active_window_;
   //  }
 
+  if (polynomialDegree_ == 3) {
+    return findNearestCurvilinearAbscissaOnCubic_(vehiclePosition);
+  }
+
   double cx = fxPolynomCoefficient_[2];
   double bx = fxPolynomCoefficient_[1];
   double ax = fxPolynomCoefficient_[0];
@@ -184,41 +303,134 @@ std::optional<double> PathCurve2D::findNearestCurvilinearAbscissa(
   return std::nullopt;
 }
 
+//-----------------------------------------------------------------------------
+std::optional<double> PathCurve2D::findNearestCurvilinearAbscissaOnCubic_(
+  const Eigen::Vector2d & vehiclePosition) const
+{
+  // g(s) = 1/2 d(r^2)/ds, a quintic whose root inside the interval is searched
+  // by Newton iterations kept inside a sign changing bracket
+  auto g = [&](const double & s, double & dg) {
+      return distanceDerivative(
+        fxPolynomCoefficient_, fyPolynomCoefficient_, vehiclePosition, s, dg);
+    };
+
+  double lower = curvilinearAbscissaInterval_.lower();
+  double upper = curvilinearAbscissaInterval_.upper();
+
+  double dg;
+  double gLower = g(lower, dg);
+  double gUpper = g(upper, dg);
+  if (gLower > 0 || gUpper < 0) {
+    return std::nullopt;
+  }
+
+  // start from the projection on the tangent at the origin
+  double s = originCurvilinearAbscissa_;
+  double tx = evaluateFirstDerivative(fxPolynomCoefficient_, s);
+  double ty = evaluateFirstDerivative(fyPolynomCoefficient_, s);
+  s += (tx * (vehiclePosition.x() - origin_.x()) + ty * (vehiclePosition.y() - origin_.y())) /
+    (tx * tx + ty * ty);
+  s = std::clamp(s, lower, upper);
+
+  constexpr int MAXIMAL_NUMBER_OF_ITERATIONS = 30;
+  constexpr double TOLERANCE = 1e-9;
+  for (int i = 0; i < MAXIMAL_NUMBER_OF_ITERATIONS; ++i) {
+    double value = g(s, dg);
+    if (value == 0) {
+      break;
+    } else if (value < 0) {
+      lower = s;
+    } else {
+      upper = s;
+    }
+
+    double next = s - value / dg;
+    if (!(dg > 0) || next <= lower || next >= upper) {
+      next = 0.5 * (lower + upper);
+    }
+
+    bool converged = std::abs(next - s) < TOLERANCE;
+    s = next;
+    if (converged) {
+      break;
+    }
+  }
+
+  return s;
+}
+
+//-----------------------------------------------------------------------------
+std::optional<double> PathCurve2D::refineNearestCurvilinearAbscissa(
+  const Eigen::Vector2d & vehiclePosition,
+  const double & initialCurvilinearAbscissa,
+  const size_t & maximalNumberOfIterations) const
+{
+  // a step below the tolerance leaves an error of its square order
+  constexpr double TOLERANCE = 1e-4;
+  constexpr double CONVERGED = 1e-9;
+
+  double s = initialCurvilinearAbscissa;
+  double step = std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < maximalNumberOfIterations && std::abs(step) > CONVERGED; ++i) {
+    double dg;
+    double value = distanceDerivative(
+      fxPolynomCoefficient_, fyPolynomCoefficient_, vehiclePosition, s, dg);
+
+    // only a minimum of the distance is searched
+    if (!(dg > 0)) {
+      return std::nullopt;
+    }
+
+    double nextStep = value / dg;
+    if (i != 0 && std::abs(nextStep) >= std::abs(step)) {
+      return std::nullopt;
+    }
+    step = nextStep;
+    s -= step;
+  }
+
+  if (!(std::abs(step) < TOLERANCE)) {
+    return std::nullopt;
+  }
+
+  return s;
+}
+
 //-----------------------------------------------------------------------------
 double PathCurve2D::computeX(const double & curvilinearAbscissa) const
 {
-  double s = curvilinearAbscissa;
-  return fxPolynomCoefficient_[0] + s * (fxPolynomCoefficient_[1] + s * fxPolynomCoefficient_[2]);
+  return evaluate(fxPolynomCoefficient_, curvilinearAbscissa);
 }
 
 //-----------------------------------------------------------------------------
 double PathCurve2D::computeY(const double & curvilinearAbscissa) const
 {
-  double s = curvilinearAbscissa;
-  return fyPolynomCoefficient_[0] + s * (fyPolynomCoefficient_[1] + s * fyPolynomCoefficient_[2]);
+  return evaluate(fyPolynomCoefficient_, curvilinearAbscissa);
 }
 
 //-----------------------------------------------------------------------------
 double PathCurve2D::computeTangent(const double & curvilinearAbscissa) const
 {
   return std::atan2(
-    (2 * fyPolynomCoefficient_[2] * curvilinearAbscissa + fyPolynomCoefficient_[1]),
-    (2 * fxPolynomCoefficient_[2] * curvilinearAbscissa + fxPolynomCoefficient_[1]));
+    evaluateFirstDerivative(fyPolynomCoefficient_, curvilinearAbscissa),
+    evaluateFirstDerivative(fxPolynomCoefficient_, curvilinearAbscissa));
 }
 
 //-----------------------------------------------------------------------------
-double PathCurve2D::computeCurvature(const double & curvilinearAbscissa) const
+Eigen::Vector2d PathCurve2D::computeDirection(const double & curvilinearAbscissa) const
 {
-  double cy = fyPolynomCoefficient_[2];
-  double by = fyPolynomCoefficient_[1];
-
-  double cx = fxPolynomCoefficient_[2];
-  double bx = fxPolynomCoefficient_[1];
+  return unitDirection(
+    evaluateFirstDerivative(fxPolynomCoefficient_, curvilinearAbscissa),
+    evaluateFirstDerivative(fyPolynomCoefficient_, curvilinearAbscissa));
+}
 
-  double Xdot = bx + (2 * cx * curvilinearAbscissa);
-  double Ydot = by + (2 * cy * curvilinearAbscissa);
-  double Xdotdot = 2 * cx;
-  double Ydotdot = 2 * cy;
+//-----------------------------------------------------------------------------
+double PathCurve2D::computeCurvature(const double & curvilinearAbscissa) const
+{
+  double Xdot = evaluateFirstDerivative(fxPolynomCoefficient_, curvilinearAbscissa);
+  double Ydot = evaluateFirstDerivative(fyPolynomCoefficient_, curvilinearAbscissa);
+  double Xdotdot = evaluateSecondDerivative(fxPolynomCoefficient_, curvilinearAbscissa);
+  double Ydotdot = evaluateSecondDerivative(fyPolynomCoefficient_, curvilinearAbscissa);
   double denominator = Xdot * Ydotdot - Ydot * Xdotdot;
 
   if (std::abs(denominator) <= std::numeric_limits<double>::epsilon()) {
@@ -230,6 +442,70 @@ double PathCurve2D::computeCurvature(const double & curvilinearAbscissa) const
   return 1 / radius;
 }
 
+//-----------------------------------------------------------------------------
+void PathCurve2D::computeX(const ConstArrayRef & curvilinearAbscissae, ArrayRef X) const
+{
+  assert(X.size() == curvilinearAbscissae.size());
+  X = evaluate(fxPolynomCoefficient_, curvilinearAbscissae);
+}
+
+//-----------------------------------------------------------------------------
+void PathCurve2D::computeY(const ConstArrayRef & curvilinearAbscissae, ArrayRef Y) const
+{
+  assert(Y.size() == curvilinearAbscissae.size());
+  Y = evaluate(fyPolynomCoefficient_, curvilinearAbscissae);
+}
+
+//-----------------------------------------------------------------------------
+void PathCurve2D::computeTangent(
+  const ConstArrayRef & curvilinearAbscissae,
+  ArrayRef tangents) const
+{
+  assert(tangents.size() == curvilinearAbscissae.size());
+  Eigen::ArrayXd Xdot = evaluateFirstDerivative(fxPolynomCoefficient_, curvilinearAbscissae);
+  tangents = evaluateFirstDerivative(fyPolynomCoefficient_, curvilinearAbscissae).binaryExpr(
+    Xdot, [](double y, double x) {return std::atan2(y, x);});
+}
+
+//-----------------------------------------------------------------------------
+void PathCurve2D::computeCurvature(
+  const ConstArrayRef & curvilinearAbscissae,
+  ArrayRef curvatures) const
+{
+  assert(curvatures.size() == curvilinearAbscissae.size());
+  Eigen::ArrayXd Xdot = evaluateFirstDerivative(fxPolynomCoefficient_, curvilinearAbscissae);
+  Eigen::ArrayXd Ydot = evaluateFirstDerivative(fyPolynomCoefficient_, curvilinearAbscissae);
+  curvatures = curvature(
+    Xdot, Ydot,
+    evaluateSecondDerivative(fxPolynomCoefficient_, curvilinearAbscissae),
+    evaluateSecondDerivative(fyPolynomCoefficient_, curvilinearAbscissae));
+}
+
+//-----------------------------------------------------------------------------
+void PathCurve2D::computePostures(
+  const ConstArrayRef & curvilinearAbscissae,
+  ArrayRef X,
+  ArrayRef Y,
+  ArrayRef tangents,
+  ArrayRef curvatures) const
+{
+  assert(X.size() == curvilinearAbscissae.size());
+  assert(Y.size() == curvilinearAbscissae.size());
+  assert(tangents.size() == curvilinearAbscissae.size());
+  assert(curvatures.size() == curvilinearAbscissae.size());
+
+  X = evaluate(fxPolynomCoefficient_, curvilinearAbscissae);
+  Y = evaluate(fyPolynomCoefficient_, curvilinearAbscissae);
+
+  Eigen::ArrayXd Xdot = evaluateFirstDerivative(fxPolynomCoefficient_, curvilinearAbscissae);
+  Eigen::ArrayXd Ydot = evaluateFirstDerivative(fyPolynomCoefficient_, curvilinearAbscissae);
+  tangents = Ydot.binaryExpr(Xdot, [](double y, double x) {return std::atan2(y, x);});
+  curvatures = curvature(
+    Xdot, Ydot,
+    evaluateSecondDerivative(fxPolynomCoefficient_, curvilinearAbscissae),
+    evaluateSecondDerivative(fyPolynomCoefficient_, curvilinearAbscissae));
+}
+
 //-----------------------------------------------------------------------------
 const Interval<double> & PathCurve2D::getCurvilinearAbscissaInterval() const
 {
@@ -242,4 +518,40 @@ const Interval<size_t> & PathCurve2D::getIndexInterval() const
   return indexInterval_;
 }
 
+//-----------------------------------------------------------------------------
+const PathCurve2D::PolynomCoefficients & PathCurve2D::getXPolynomCoefficients() const
+{
+  return fxPolynomCoefficient_;
+}
+
+//-----------------------------------------------------------------------------
+const PathCurve2D::PolynomCoefficients & PathCurve2D::getYPolynomCoefficients() const
+{
+  return fyPolynomCoefficient_;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathCurve2D::getPolynomialDegree() const
+{
+  return polynomialDegree_;
+}
+
+//-----------------------------------------------------------------------------
+PathCurve2D::FitStatus PathCurve2D::getFitStatus() const
+{
+  return fitStatus_;
+}
+
+//-----------------------------------------------------------------------------
+const Eigen::Vector2d & PathCurve2D::getOrigin() const
+{
+  return origin_;
+}
+
+//-----------------------------------------------------------------------------
+const double & PathCurve2D::getOriginCurvilinearAbscissa() const
+{
+  return originCurvilinearAbscissa_;
+}
+
 }  // namespace romea::core
@@ -13,11 +13,17 @@
 // limitations under the License.
 
 // std
+#include <algorithm>
+#include <charconv>
 #include <cstdio>
 #include <exception>
+#include <future>
+#include <limits>
 #include <stdexcept>
 #include <map>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
 #include <utility>
 
@@ -28,6 +34,14 @@
 // json
 #include "nlohmann/json.hpp"
 
+namespace
+{
+
+// Smaller sections are not worth the threads
+constexpr size_t MINIMAL_ROWS_PER_CHUNK = 1 << 14;
+
+}  // namespace
+
 static bool endsWith(std::string_view str, std::string_view suffix)
 {
   return str.size() >= suffix.size() &&
@@ -39,16 +53,262 @@ namespace romea
 namespace core
 {
 
+// Values are read in place from the file content with std::from_chars, errors
+// report the line and the column (both starting at 1) of the faulty token
+class PathFile::TextParser
+{
+public:
+  // position must be the beginning of the line
+  TextParser(
+    std::string_view data,
+    const std::string & filename,
+    size_t position = 0,
+    size_t line = 1)
+  : data_(data),
+    filename_(filename),
+    position_(position),
+    line_(line),
+    lineBegin_(position),
+    tokenColumn_(1)
+  {
+  }
+
+  std::string readWord(const char * expected)
+  {
+    return std::string(readToken_(expected, true));
+  }
+
+  template<typename T>
+  T readNumber(const char * expected, bool acrossLines = false)
+  {
+    std::string_view token = readToken_(expected, acrossLines);
+    const char * first = token.data();
+    const char * last = token.data() + token.size();
+    if (*first == '+') {
+      ++first;
+    }
+
+    T value;
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec == std::errc::result_out_of_range) {
+      fail(std::string(expected) + " is out of range: " + std::string(token), tokenColumn_);
+    } else if (ec != std::errc() || ptr != last) {
+      fail("expected " + std::string(expected) + ", got " + std::string(token), tokenColumn_);
+    }
+    return value;
+  }
+
+  void readEndOfLine()
+  {
+    skipSpaces_(false);
+    if (position_ == data_.size()) {
+      return;
+    }
+    if (data_[position_] != '\n') {
+      size_t column = this->column();
+      std::string_view token = readToken_("", false);
+      fail("expected the end of the line, got " + std::string(token), column);
+    }
+    newLine_();
+  }
+
+  void skipBlankLines()
+  {
+    skipSpaces_(true);
+  }
+
+  // One way point per line written in the rows [firstRow, lastRow) of the
+  // columns, blank lines are skipped
+  void readWayPoints(
+    PathSection2D::WayPointColumns & wayPoints,
+    size_t firstRow,
+    size_t lastRow,
+    size_t numberOfColumns)
+  {
+    for (size_t n = firstRow; n < lastRow; ++n) {
+      skipBlankLines();
+      wayPoints.x[n] = readNumber<double>("the x coordinate");
+      wayPoints.y[n] = readNumber<double>("the y coordinate");
+
+      if (numberOfColumns >= 3) {
+        wayPoints.speeds[n] = readNumber<double>("the desired speed");
+      }
+
+      // The 4th column correspond to a marker counter (incremented using joystick)
+      if (numberOfColumns >= 4) {
+        readNumber<double>("the marker counter");
+      }
+      readEndOfLine();
+    }
+  }
+
+  // Way points are one per line, so the rows of the section are split in chunks
+  // at line beginnings located by a scan of the newlines, then the chunks are
+  // parsed concurrently. Errors are rethrown in file order so that the result is
+  // the one of readWayPoints. Return false, without reading anything, when the
+  // section is too small to be split or when the file ends before its last row.
+  bool readWayPointsConcurrently(
+    PathSection2D::WayPointColumns & wayPoints,
+    size_t numberOfColumns,
+    size_t numberOfThreads)
+  {
+    size_t numberOfRows = wayPoints.x.size();
+    size_t numberOfChunks = std::min(numberOfThreads, numberOfRows / MINIMAL_ROWS_PER_CHUNK);
+    if (numberOfChunks < 2) {
+      return false;
+    }
+
+    std::vector<TextParser> chunks;
+    chunks.reserve(numberOfChunks);
+    size_t position = position_;
+    size_t line = line_;
+    size_t lineBegin = lineBegin_;
+    size_t row = 0;
+    while (row < numberOfRows) {
+      if (position == data_.size()) {
+        return false;
+      }
+
+      size_t end = std::min(data_.find('\n', position), data_.size());
+      if (!std::all_of(data_.begin() + position, data_.begin() + end, isSpace_)) {
+        if (row == chunks.size() * numberOfRows / numberOfChunks) {
+          chunks.emplace_back(data_, filename_, position, line);
+        }
+        ++row;
+      }
+
+      if (end == data_.size()) {
+        if (row < numberOfRows) {
+          return false;
+        }
+        // last row without final newline, the line is left open as readEndOfLine does
+        lineBegin = position;
+        position = end;
+      } else {
+        position = end + 1;
+        lineBegin = position;
+        ++line;
+      }
+    }
+
+    auto readChunk = [&](size_t k) {
+        size_t firstRow = k * numberOfRows / numberOfChunks;
+        size_t lastRow = (k + 1) * numberOfRows / numberOfChunks;
+        chunks[k].readWayPoints(wayPoints, firstRow, lastRow, numberOfColumns);
+      };
+
+    std::vector<std::future<void>> futures;
+    for (size_t k = 0; k + 1 < numberOfChunks; ++k) {
+      futures.push_back(std::async(std::launch::async, readChunk, k));
+    }
+
+    std::exception_ptr lastChunkError;
+    try {
+      readChunk(numberOfChunks - 1);
+    } catch (...) {
+      lastChunkError = std::current_exception();
+    }
+    for (auto & future : futures) {
+      future.get();
+    }
+    if (lastChunkError) {
+      std::rethrow_exception(lastChunkError);
+    }
+
+    position_ = position;
+    line_ = line;
+    lineBegin_ = lineBegin;
+    return true;
+  }
+
+  bool atEnd() const
+  {
+    return position_ == data_.size();
+  }
+
+  size_t column() const
+  {
+    return position_ - lineBegin_ + 1;
+  }
+
+  size_t tokenColumn() const
+  {
+    return tokenColumn_;
+  }
+
+  [[noreturn]] void fail(const std::string & message, size_t column) const
+  {
+    throw std::runtime_error(
+      filename_ + ":" + std::to_string(line_) + ":" + std::to_string(column) + ": " + message);
+  }
+
+private:
+  static bool isSpace_(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\r';
+  }
+
+  void newLine_()
+  {
+    ++position_;
+    ++line_;
+    lineBegin_ = position_;
+  }
+
+  void skipSpaces_(bool acrossLines)
+  {
+    while (position_ != data_.size()) {
+      if (isSpace_(data_[position_])) {
+        ++position_;
+      } else if (acrossLines && data_[position_] == '\n') {
+        newLine_();
+      } else {
+        break;
+      }
+    }
+  }
+
+  std::string_view readToken_(const char * expected, bool acrossLines)
+  {
+    skipSpaces_(acrossLines);
+    tokenColumn_ = column();
+    if (position_ == data_.size() || data_[position_] == '\n') {
+      fail("expected " + std::string(expected), tokenColumn_);
+    }
+
+    size_t begin = position_;
+    while (position_ != data_.size() && !isSpace_(data_[position_]) &&
+      data_[position_] != '\n')
+    {
+      ++position_;
+    }
+    return data_.substr(begin, position_ - begin);
+  }
+
+private:
+  std::string_view data_;
+  const std::string & filename_;
+  size_t position_;
+  size_t line_;
+  size_t lineBegin_;
+  size_t tokenColumn_;
+};
+
 //-----------------------------------------------------------------------------
-PathFile::PathFile(const std::string & filename)
-: coordinate_system_(), world_to_path_(), wgs84_anchor_(), way_points_(), file_(filename)
+PathFile::PathFile(const std::string & filename, size_t numberOfThreads)
+: coordinate_system_(),
+  world_to_path_(),
+  wgs84_anchor_(),
+  way_point_columns_(),
+  way_points_(),
+  file_(filename),
+  number_of_threads_(std::max<size_t>(numberOfThreads, 1))
 {
   if (file_.is_open()) {
     if (endsWith(filename, ".traj")) {
       loadV2_();
     } else {
-      loadHeader_();
-      loadWayPoints_();
+      loadV1_(filename);
     }
   } else {
     throw(std::runtime_error("Failed to open path file " + filename));
@@ -61,18 +321,31 @@ PathFile::PathFile(const std::string & filename)
 }
 
 //-----------------------------------------------------------------------------
-void PathFile::loadHeader_()
+void PathFile::loadV1_(const std::string & filename)
 {
-  std::string header;
-  file_ >> header;
-  coordinate_system_ = header;
+  // the whole file is read at once and parsed in place
+  file_.seekg(0, std::ios::end);
+  std::string data(static_cast<size_t>(file_.tellg()), '\0');
+  file_.seekg(0, std::ios::beg);
+  if (!file_.read(data.data(), data.size())) {
+    throw std::runtime_error("Failed to read path file " + filename);
+  }
+
+  TextParser parser(data, filename);
+  loadHeaderV1_(parser);
+  loadWayPointsV1_(parser);
+}
 
-  if (header.compare("WGS84") == 0) {
-    double reference_latitude;
-    double reference_longitude;
-    double reference_altitude;
+//-----------------------------------------------------------------------------
+void PathFile::loadHeaderV1_(TextParser & parser)
+{
+  coordinate_system_ = parser.readWord("a WGS84, ENU or PIXEL header");
 
-    file_ >> reference_latitude >> reference_longitude >> reference_altitude;
+  if (coordinate_system_ == "WGS84") {
+    // the anchor can follow the header on the same line or on the next one
+    double reference_latitude = parser.readNumber<double>("the anchor latitude", true);
+    double reference_longitude = parser.readNumber<double>("the anchor longitude", true);
+    double reference_altitude = parser.readNumber<double>("the anchor altitude", true);
 
     wgs84_anchor_ = makeGeodeticCoordinates(
       reference_latitude / 180. * M_PI,
@@ -80,59 +353,49 @@ void PathFile::loadHeader_()
       reference_altitude);
 
     world_to_path_ = ENUConverter(*wgs84_anchor_).getEnuToEcefTransform();
-  } else if (header.compare("ENU") == 0 || header.compare("PIXEL") == 0) {
+  } else if (coordinate_system_ == "ENU" || coordinate_system_ == "PIXEL") {
     world_to_path_ = Eigen::Affine3d::Identity();
   } else {
-    throw(std::runtime_error("Failed to extract path header"));
+    parser.fail("unknown path header " + coordinate_system_, parser.tokenColumn());
   }
+  parser.readEndOfLine();
 }
 
 //-----------------------------------------------------------------------------
-void PathFile::loadWayPoints_()
+void PathFile::loadWayPointsV1_(TextParser & parser)
 {
-  size_t number_of_sections;
-
-  std::string line;
-  // parse number of sections (a line with only one number)
-  if (file_.get() == '\n' && file_ >> number_of_sections && file_.get() == '\n') {
-    std::cout << " number of sections " << number_of_sections << std::endl;
-  } else {
-    throw std::runtime_error{"Failed to parse the number of sections"};
-  }
+  auto number_of_sections = parser.readNumber<size_t>("the number of sections");
+  parser.readEndOfLine();
 
-  way_points_.resize(number_of_sections);
+  way_point_columns_.resize(number_of_sections);
   for (size_t i = 0; i < number_of_sections; ++i) {
-    size_t number_of_way_points, number_of_columns;
-    if (!(file_ >> number_of_way_points && file_ >> number_of_columns && file_.get() == '\n')) {
-      throw std::runtime_error{"Failed to parse the section header"};
+    parser.skipBlankLines();
+    auto number_of_way_points = parser.readNumber<size_t>("the number of way points");
+    auto number_of_columns = parser.readNumber<size_t>("the number of columns");
+    if (number_of_columns < 2 || number_of_columns > 4) {
+      parser.fail("the number of columns must be 2, 3 or 4", parser.tokenColumn());
     }
-
-    std::cout << " number of way points " << number_of_way_points << std::endl;
-    std::cout << " number of columns " << number_of_columns << std::endl;
-
-    way_points_[i].resize(number_of_way_points);
-    for (size_t j = 0; j < number_of_way_points; ++j) {
-      auto & wp = way_points_[i][j];
-
-      file_ >> wp.position.x();
-      file_ >> wp.position.y();
-
-      if (number_of_columns >= 3) {
-        file_ >> wp.desired_speed;
-      }
-
-      // The 4th column correspond to a marker counter (incremented using joystick)
-      if (number_of_columns >= 4) {
-        int marker_count;
-        file_ >> marker_count;
-      }
-
-      // std::cout << j <<" "
-      //           << wp.position.x() << " "
-      //           << wp.position.y()<<" "
-      //           << wp.desired_speed<<std::endl;
+    parser.readEndOfLine();
+
+    // each column is allocated once, at its final size
+    auto & section_way_points = way_point_columns_[i];
+    section_way_points.x.resize(number_of_way_points);
+    section_way_points.y.resize(number_of_way_points);
+    section_way_points.speeds.resize(
+      number_of_way_points, std::numeric_limits<double>::quiet_NaN());
+    if (!parser.readWayPointsConcurrently(
+        section_way_points, number_of_columns, number_of_threads_))
+    {
+      parser.readWayPoints(section_way_points, 0, number_of_way_points, number_of_columns);
     }
   }
+
+  parser.skipBlankLines();
+  if (!parser.atEnd()) {
+    parser.fail(
+      "unexpected content after the " + std::to_string(number_of_sections) + " declared sections",
+      parser.column());
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -183,28 +446,36 @@ void PathFile::loadWayPointsV2_(const nlohmann::json & data)
   }
   bool has_speed = col_indexes.count("speed");
 
-  way_points_.reserve(values.size());
+  std::size_t x_index = col_indexes["x"];
+  std::size_t y_index = col_indexes["y"];
+  std::size_t speed_index = has_speed ? col_indexes["speed"] : 0;
+
+  way_point_columns_.reserve(section_indexes.size());
 
   auto section_it = section_indexes.cbegin();
   i = 0;
   for (const auto & point : values) {
     // Create a new section when the point index reaches the next index in the section list
     if (section_it != section_indexes.cend() && i == *section_it) {
-      way_points_.emplace_back();
       ++section_it;
+      std::size_t section_end = section_it != section_indexes.cend() ?
+        section_it->get<std::size_t>() : values.size();
+
+      auto & section_way_points = way_point_columns_.emplace_back();
+      section_way_points.x.reserve(section_end - i);
+      section_way_points.y.reserve(section_end - i);
+      section_way_points.speeds.reserve(section_end - i);
     }
 
-    if (way_points_.empty()) {
+    if (way_point_columns_.empty()) {
       throw std::runtime_error("The first section index of the traj must be 0");
     }
 
-    Eigen::Vector2d pos;
-    pos << point[col_indexes["x"]], point[col_indexes["y"]];
-    if (has_speed) {
-      way_points_.back().emplace_back(pos, point[col_indexes["speed"]]);
-    } else {
-      way_points_.back().emplace_back(pos);
-    }
+    auto & section_way_points = way_point_columns_.back();
+    section_way_points.x.push_back(point[x_index]);
+    section_way_points.y.push_back(point[y_index]);
+    section_way_points.speeds.push_back(
+      has_speed ? point[speed_index].get<double>() : std::numeric_limits<double>::quiet_NaN());
 
     ++i;
   }
@@ -226,9 +497,33 @@ void PathFile::loadAnnotations(const nlohmann::json & data)
 //-----------------------------------------------------------------------------
 const std::vector<std::vector<PathWayPoint2D>> & PathFile::getWayPoints() const
 {
+  // way points are stored by columns, they are only gathered when asked
+  if (way_points_.size() != way_point_columns_.size()) {
+    way_points_.resize(way_point_columns_.size());
+    for (size_t i = 0; i < way_point_columns_.size(); ++i) {
+      const auto & columns = way_point_columns_[i];
+      way_points_[i].reserve(columns.x.size());
+      for (size_t n = 0; n < columns.x.size(); ++n) {
+        way_points_[i].emplace_back(Eigen::Vector2d(columns.x[n], columns.y[n]), columns.speeds[n]);
+      }
+    }
+  }
   return way_points_;
 }
 
+//-----------------------------------------------------------------------------
+const Path2D::WayPointColumns & PathFile::getWayPointColumns() const
+{
+  return way_point_columns_;
+}
+
+//-----------------------------------------------------------------------------
+Path2D::WayPointColumns PathFile::releaseWayPointColumns()
+{
+  way_points_.clear();
+  return std::move(way_point_columns_);
+}
+
 //-----------------------------------------------------------------------------
 const std::string & PathFile::getCoordinateSystemDescription() const {return coordinate_system_;}
 
@@ -55,5 +55,40 @@ PathFrenetPose2D reverse(const PathFrenetPose2D & frenetPose)
   return reversedFrenetPose;
 }
 
+//-----------------------------------------------------------------------------
+PathCompactFrenetPose2D::PathCompactFrenetPose2D()
+: curvilinearAbscissa(0.),
+  lateralDeviation(0.),
+  courseDeviation(0.)
+{
+}
+
+//-----------------------------------------------------------------------------
+PathCompactFrenetPose2D::PathCompactFrenetPose2D(const PathFrenetPose2D & frenetPose)
+: curvilinearAbscissa(frenetPose.curvilinearAbscissa),
+  lateralDeviation(frenetPose.lateralDeviation),
+  courseDeviation(frenetPose.courseDeviation)
+{
+}
+
+//-----------------------------------------------------------------------------
+std::ostream & operator<<(std::ostream & os, const PathCompactFrenetPose2D & frenetPose)
+{
+  os << "Frenet pose " << std::endl;
+  os << " curvilinear abscissa = " << frenetPose.curvilinearAbscissa << std::endl;
+  os << " lateral deviation = " << frenetPose.lateralDeviation << std::endl;
+  os << " course deviation = " << frenetPose.courseDeviation << std::endl;
+  return os;
+}
+
+//-----------------------------------------------------------------------------
+PathCompactFrenetPose2D reverse(const PathCompactFrenetPose2D & frenetPose)
+{
+  PathCompactFrenetPose2D reversedFrenetPose = frenetPose;
+  reversedFrenetPose.lateralDeviation = -frenetPose.lateralDeviation;
+  reversedFrenetPose.courseDeviation = -betweenMinusPiAndPi(frenetPose.courseDeviation + M_PI);
+  return reversedFrenetPose;
+}
+
 }  // namespace core
 }  // namespace romea
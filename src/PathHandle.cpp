@@ -0,0 +1,278 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_path/PathHandle.hpp"
+
+namespace
+{
+
+// States of a hazard slot besides the address of the version it protects
+constexpr std::uintptr_t IDLE = 0;
+constexpr std::uintptr_t ACQUIRING = 1;
+
+//-----------------------------------------------------------------------------
+// Index of the way point at the given position in the section, size when none
+size_t findWayPointIndex(
+  const romea::core::PathSection2D & section,
+  const Eigen::Vector2d & position,
+  const size_t & hint)
+{
+  if (hint < section.size() &&
+    section.getX()[hint] == position.x() && section.getY()[hint] == position.y())
+  {
+    return hint;
+  }
+
+  for (size_t n = 0; n < section.size(); ++n) {
+    if (section.getX()[n] == position.x() && section.getY()[n] == position.y()) {
+      return n;
+    }
+  }
+  return section.size();
+}
+
+//-----------------------------------------------------------------------------
+// The curves are the same when their fitting windows hold the same way points
+bool shareCurveGeometry(
+  const romea::core::PathSection2D & previousSection,
+  const size_t & previousCurveIndex,
+  const romea::core::PathSection2D & section,
+  const size_t & curveIndex)
+{
+  auto previousInterval = previousSection.getCurve(previousCurveIndex).getIndexInterval();
+  auto interval = section.getCurve(curveIndex).getIndexInterval();
+  if (previousCurveIndex - previousInterval.lower() != curveIndex - interval.lower() ||
+    previousInterval.width() != interval.width())
+  {
+    return false;
+  }
+
+  for (size_t k = 0; k <= interval.width(); ++k) {
+    size_t previousIndex = previousInterval.lower() + k;
+    size_t index = interval.lower() + k;
+    if (previousSection.getX()[previousIndex] != section.getX()[index] ||
+      previousSection.getY()[previousIndex] != section.getY()[index])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+PathHandle::Reader::Reader(PathHandle * handle, size_t slotIndex)
+: handle_(handle),
+  slotIndex_(slotIndex)
+{
+}
+
+//-----------------------------------------------------------------------------
+PathHandle::Reader::Reader(Reader && reader)
+: handle_(std::exchange(reader.handle_, nullptr)),
+  slotIndex_(reader.slotIndex_)
+{
+}
+
+//-----------------------------------------------------------------------------
+PathHandle::Reader::~Reader()
+{
+  if (handle_ != nullptr) {
+    release();
+    std::lock_guard<std::mutex> lock(handle_->writerMutex_);
+    handle_->usedSlots_[slotIndex_] = false;
+  }
+}
+
+//-----------------------------------------------------------------------------
+const PathHandle::Version * PathHandle::Reader::acquire()
+{
+  auto & slot = handle_->slots_[slotIndex_].value;
+
+  // Announce the acquisition before reading the current version. A writer
+  // replacing the version in between finds the slot acquiring and hands the
+  // new version over, so the reader never loops.
+  slot.store(ACQUIRING);
+  auto version = reinterpret_cast<std::uintptr_t>(handle_->current_.load());
+  std::uintptr_t expected = ACQUIRING;
+  if (!slot.compare_exchange_strong(expected, version)) {
+    version = expected;
+  }
+  return reinterpret_cast<const Version *>(version);
+}
+
+//-----------------------------------------------------------------------------
+void PathHandle::Reader::release()
+{
+  handle_->slots_[slotIndex_].value.store(IDLE, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+PathHandle::PathHandle(size_t maximalNumberOfReaders)
+: current_(nullptr),
+  slots_(maximalNumberOfReaders),
+  writerMutex_(),
+  usedSlots_(maximalNumberOfReaders, false),
+  retiredVersions_()
+{
+  for (auto & slot : slots_) {
+    slot.value.store(IDLE);
+  }
+}
+
+//-----------------------------------------------------------------------------
+PathHandle::~PathHandle()
+{
+  delete current_.load();
+}
+
+//-----------------------------------------------------------------------------
+PathHandle::Reader PathHandle::makeReader()
+{
+  std::lock_guard<std::mutex> lock(writerMutex_);
+  auto it = std::find(usedSlots_.begin(), usedSlots_.end(), false);
+  if (it == usedSlots_.end()) {
+    throw std::runtime_error("Maximal number of path handle readers reached");
+  }
+
+  *it = true;
+  return Reader(this, std::distance(usedSlots_.begin(), it));
+}
+
+//-----------------------------------------------------------------------------
+std::uint64_t PathHandle::publish(Path2D && path)
+{
+  std::lock_guard<std::mutex> lock(writerMutex_);
+  Version * previousVersion = current_.load();
+  std::uint64_t generation = previousVersion != nullptr ? previousVersion->generation + 1 : 1;
+  auto version = new Version{std::move(path), generation};
+  current_.store(version);
+
+  // Readers caught between their announcement and their read of the previous
+  // version get the new one instead
+  for (auto & slot : slots_) {
+    std::uintptr_t expected = ACQUIRING;
+    slot.value.compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(version));
+  }
+
+  if (previousVersion != nullptr) {
+    retiredVersions_.emplace_back(previousVersion);
+  }
+  reclaim_();
+  return generation;
+}
+
+//-----------------------------------------------------------------------------
+std::uint64_t PathHandle::getGeneration() const
+{
+  const Version * version = current_.load();
+  return version != nullptr ? version->generation : 0;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathHandle::reclaim()
+{
+  std::lock_guard<std::mutex> lock(writerMutex_);
+  return reclaim_();
+}
+
+//-----------------------------------------------------------------------------
+size_t PathHandle::reclaim_()
+{
+  auto isProtected = [this](const std::unique_ptr<Version> & version) {
+      auto address = reinterpret_cast<std::uintptr_t>(version.get());
+      return std::any_of(
+        slots_.begin(), slots_.end(), [address](const Slot & slot) {
+          return slot.value.load() == address;
+        });
+    };
+
+  retiredVersions_.erase(
+    std::partition(retiredVersions_.begin(), retiredVersions_.end(), isProtected),
+    retiredVersions_.end());
+  return retiredVersions_.size();
+}
+
+//-----------------------------------------------------------------------------
+std::optional<PathMatchedPoint2D> remapMatchedPoint(
+  const PathMatchedPoint2D & matchedPoint,
+  const Path2D & previousPath,
+  const Path2D & path)
+{
+  if (matchedPoint.sectionIndex >= previousPath.size()) {
+    return std::nullopt;
+  }
+
+  const auto & previousSection = previousPath.getSection(matchedPoint.sectionIndex);
+  const size_t & previousCurveIndex = matchedPoint.curveIndex;
+  if (previousCurveIndex >= previousSection.size()) {
+    return std::nullopt;
+  }
+
+  Eigen::Vector2d position(
+    previousSection.getX()[previousCurveIndex], previousSection.getY()[previousCurveIndex]);
+
+  // the section of the same index is checked first, paths are mostly edited
+  // by changing speeds or appending sections
+  std::vector<size_t> sectionIndexes;
+  path.findNearbySections(position, 1e-6, sectionIndexes);
+  auto sameIndex = std::find(
+    sectionIndexes.begin(), sectionIndexes.end(), matchedPoint.sectionIndex);
+  if (sameIndex != sectionIndexes.end()) {
+    std::rotate(sectionIndexes.begin(), sameIndex, sameIndex + 1);
+  }
+
+  for (const size_t & sectionIndex : sectionIndexes) {
+    const auto & section = path.getSection(sectionIndex);
+    size_t curveIndex = findWayPointIndex(section, position, previousCurveIndex);
+    if (curveIndex == section.size() ||
+      !shareCurveGeometry(previousSection, previousCurveIndex, section, curveIndex))
+    {
+      continue;
+    }
+
+    double abscissaOffset = section.getCurvilinearAbscissa()[curveIndex] -
+      previousSection.getCurvilinearAbscissa()[previousCurveIndex];
+
+    PathMatchedPoint2D remappedPoint = matchedPoint;
+    remappedPoint.sectionIndex = sectionIndex;
+    remappedPoint.curveIndex = curveIndex;
+    remappedPoint.frenetPose.curvilinearAbscissa += abscissaOffset;
+    remappedPoint.sectionMinimalCurvilinearAbscissa =
+      section.getCurvilinearAbscissa().initialValue();
+    remappedPoint.sectionMaximalCurvilinearAbscissa =
+      section.getCurvilinearAbscissa().finalValue();
+    remappedPoint.desiredSpeed = section.getSpeeds()[curveIndex];
+    return remappedPoint;
+  }
+
+  return std::nullopt;
+}
+
+}  // namespace core
+}  // namespace romea
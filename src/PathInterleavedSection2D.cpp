@@ -0,0 +1,228 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+// romea
+#include "romea_core_path/PathInterleavedSection2D.hpp"
+#include "romea_core_path/PathMatchingInstrumentation.hpp"
+
+namespace
+{
+constexpr Eigen::Index POINT_STRIDE =
+  sizeof(romea::core::PathInterleavedSection2D::Point) / sizeof(double);
+
+static_assert(
+  sizeof(romea::core::PathInterleavedSection2D::Point) == POINT_STRIDE * sizeof(double),
+  "interleaved point record must not be padded");
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+PathInterleavedSection2D::PathInterleavedSection2D(
+  const double & interpolationWindowLength,
+  const double & initialCurvilinearAbcissa,
+  size_t initialPointIndex)
+: points_(),
+  curves_(),
+  initial_point_index_(initialPointIndex),
+  initialCurvilinearAbscissa_(initialCurvilinearAbcissa),
+  interpolationWindowLength_(interpolationWindowLength),
+  length_(0),
+  curvilinearAbscissa_(initialCurvilinearAbcissa)
+{
+}
+
+//-----------------------------------------------------------------------------
+void PathInterleavedSection2D::addWayPoint(const PathWayPoint2D & wayPoint)
+{
+  if (!points_.empty()) {
+    const auto & previous = points_.back();
+    double dx = wayPoint.position.x() - previous.x;
+    double dy = wayPoint.position.y() - previous.y;
+    double ds = std::sqrt(dx * dx + dy * dy);
+    curvilinearAbscissa_.add(ds);
+    length_ = curvilinearAbscissa_.value() - initialCurvilinearAbscissa_;
+  }
+
+  points_.push_back(
+    {wayPoint.position.x(), wayPoint.position.y(), curvilinearAbscissa_.value(),
+      wayPoint.desired_speed});
+  curves_.push_back(std::optional<PathCurve2D>());
+}
+
+//-----------------------------------------------------------------------------
+void PathInterleavedSection2D::addWayPoints(const std::vector<PathWayPoint2D> & wayPoints)
+{
+  reserve(size() + wayPoints.size());
+  for (const auto & wayPoint : wayPoints) {
+    addWayPoint(wayPoint);
+  }
+}
+
+//-----------------------------------------------------------------------------
+const PathCurve2D & PathInterleavedSection2D::getCurve(const size_t & pointIndex)const
+{
+  if (!curves_[pointIndex].has_value()) {
+    computePathCurve_(pointIndex);
+  }
+
+  return *curves_[pointIndex];
+}
+
+//-----------------------------------------------------------------------------
+void PathInterleavedSection2D::computePathCurve_(const size_t & pointIndex) const
+{
+  ROMEA_PATH_COUNT(CURVES_FITTED, 1);
+  curves_[pointIndex].emplace();
+
+  const double & s = points_[pointIndex].curvilinearAbscissa;
+  Interval<double> curvilinearAbscissaInterval(
+    s - interpolationWindowLength_ / 2., s + interpolationWindowLength_ / 2.);
+
+  Interval<size_t> indexRange = findIntervalBoundIndexes(pointIndex, curvilinearAbscissaInterval);
+
+  [[maybe_unused]] bool estimated = curves_[pointIndex]->estimate(
+    column_(&Point::x, indexRange),
+    column_(&Point::y, indexRange),
+    column_(&Point::curvilinearAbscissa, indexRange),
+    indexRange,
+    curvilinearAbscissaInterval);
+
+  assert(estimated);
+}
+
+//-----------------------------------------------------------------------------
+PathCurve2D::ConstStridedArray PathInterleavedSection2D::column_(
+  const double Point::* member,
+  const Interval<size_t> & indexRange) const
+{
+  return Eigen::Map<const Eigen::ArrayXd, 0, Eigen::InnerStride<>>(
+    &(points_[indexRange.lower()].*member),
+    indexRange.width() + 1,
+    Eigen::InnerStride<>(POINT_STRIDE));
+}
+
+//-----------------------------------------------------------------------------
+void PathInterleavedSection2D::reserve(size_t n)
+{
+  points_.reserve(n);
+  curves_.reserve(n);
+}
+
+//-----------------------------------------------------------------------------
+const PathInterleavedSection2D::Points & PathInterleavedSection2D::getPoints()const
+{
+  return points_;
+}
+
+//-----------------------------------------------------------------------------
+const double & PathInterleavedSection2D::getInitialCurvilinearAbscissa()const
+{
+  return initialCurvilinearAbscissa_;
+}
+
+//-----------------------------------------------------------------------------
+const double & PathInterleavedSection2D::getFinalCurvilinearAbscissa()const
+{
+  return points_.empty() ? initialCurvilinearAbscissa_ : points_.back().curvilinearAbscissa;
+}
+
+//-----------------------------------------------------------------------------
+const double & PathInterleavedSection2D::getLength()const
+{
+  return length_;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathInterleavedSection2D::getInitialPointIndex()const
+{
+  return initial_point_index_;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathInterleavedSection2D::size()const
+{
+  return points_.size();
+}
+
+//-----------------------------------------------------------------------------
+void PathInterleavedSection2D::clear()
+{
+  points_.clear();
+  curves_.clear();
+  length_ = 0;
+  curvilinearAbscissa_ = CompensatedSummation::Accumulator<double>(initialCurvilinearAbscissa_);
+}
+
+//-----------------------------------------------------------------------------
+size_t PathInterleavedSection2D::findIndex(
+  const double & value,
+  const size_t & startSearchIndex) const
+{
+  size_t n = startSearchIndex;
+  while (n < points_.size() - 1 && points_[n].curvilinearAbscissa < value) {
+    n++;
+  }
+  return n;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathInterleavedSection2D::findIndex(const double & value) const
+{
+  return findIndex(value, 0);
+}
+
+//-----------------------------------------------------------------------------
+Interval<size_t> PathInterleavedSection2D::findIntervalBoundIndexes(
+  const size_t & intervalCenterIndex,
+  const double & intervalWidth) const
+{
+  const double & s = points_[intervalCenterIndex].curvilinearAbscissa;
+  return findIntervalBoundIndexes(
+    intervalCenterIndex, Interval<double>(s - intervalWidth / 2., s + intervalWidth / 2.));
+}
+
+//-----------------------------------------------------------------------------
+Interval<size_t> PathInterleavedSection2D::findIntervalBoundIndexes(
+  const size_t & intervalCenterIndex,
+  const Interval<double> & interval)const
+{
+  size_t minimalIndex = intervalCenterIndex;
+  size_t maximalIndex = intervalCenterIndex;
+
+  while (minimalIndex != 0 &&
+    interval.inside(points_[minimalIndex].curvilinearAbscissa))
+  {
+    minimalIndex--;
+  }
+
+  while (maximalIndex != points_.size() - 1 &&
+    interval.inside(points_[maximalIndex].curvilinearAbscissa))
+  {
+    maximalIndex++;
+  }
+
+  return {minimalIndex, maximalIndex};
+}
+
+}  // namespace core
+}  // namespace romea
@@ -13,8 +13,10 @@
 // limitations under the License.
 
 // std
+#include <algorithm>
 #include <limits>
 #include <ostream>
+#include <type_traits>
 #include <vector>
 
 // romea
@@ -22,11 +24,35 @@
 #include "romea_core_common/math/EulerAngles.hpp"
 #include "romea_core_common/math/Algorithm.hpp"
 
+namespace
+{
+
+//-----------------------------------------------------------------------------
+template<typename MatchedPoint>
+const MatchedPoint * findBySectionIndex(
+  const MatchedPoint * first,
+  const MatchedPoint * last,
+  const size_t & sectionIndex)
+{
+  auto it = std::find_if(
+    first, last,
+    [sectionIndex](const MatchedPoint & matchedPoint) {
+      return matchedPoint.sectionIndex == sectionIndex;
+    }
+  );
+
+  return it != last ? it : nullptr;
+}
+
+}  // namespace
+
 namespace romea
 {
 namespace core
 {
 
+static_assert(std::is_trivially_copyable<PathCompactMatchedPoint2D>::value);
+
 //-----------------------------------------------------------------------------
 PathMatchedPoint2D::PathMatchedPoint2D()
 : pathPosture(),
@@ -56,23 +82,28 @@ std::ostream & operator<<(std::ostream & os, const PathMatchedPoint2D & matchedP
 
 //-----------------------------------------------------------------------------
 std::optional<PathMatchedPoint2D> findMatchedPointBySectionIndex(
-  const std::vector<PathMatchedPoint2D> matchedPoints,
+  const std::vector<PathMatchedPoint2D> & matchedPoints,
   const size_t & sectionIndex)
 {
-  auto it = std::find_if(
-    matchedPoints.begin(), matchedPoints.end(),
-    [sectionIndex](const PathMatchedPoint2D & matchedPoint) {
-      return matchedPoint.sectionIndex == sectionIndex;
-    }
-  );
+  const auto * matchedPoint = findMatchedPointBySectionIndex(
+    matchedPoints.data(), matchedPoints.data() + matchedPoints.size(), sectionIndex);
 
-  if (it != matchedPoints.end()) {
-    return *it;
+  if (matchedPoint != nullptr) {
+    return *matchedPoint;
   } else {
     return {};
   }
 }
 
+//-----------------------------------------------------------------------------
+const PathMatchedPoint2D * findMatchedPointBySectionIndex(
+  const PathMatchedPoint2D * first,
+  const PathMatchedPoint2D * last,
+  const size_t & sectionIndex)
+{
+  return findBySectionIndex(first, last, sectionIndex);
+}
+
 //-----------------------------------------------------------------------------
 Eigen::Vector2d globalPosition(const PathMatchedPoint2D & matchedPoint)
 {
@@ -90,5 +121,112 @@ double direction(const PathMatchedPoint2D & matchedPoint)
   return std::isfinite(matchedPoint.desiredSpeed) ? sign(matchedPoint.desiredSpeed) : 1;
 }
 
+//-----------------------------------------------------------------------------
+PathCompactMatchedPoint2D::PathCompactMatchedPoint2D()
+: x(0.),
+  y(0.),
+  course(0.),
+  curvature(0.),
+  frenetPose(),
+  futureCurvature(0.),
+  desiredSpeed(std::numeric_limits<double>::quiet_NaN()),
+  sectionMinimalCurvilinearAbscissa(0.),
+  sectionMaximalCurvilinearAbscissa(0.),
+  sectionIndex(std::numeric_limits<std::uint64_t>::max()),
+  curveIndex(std::numeric_limits<std::uint64_t>::max())
+{
+}
+
+//-----------------------------------------------------------------------------
+PathCompactMatchedPoint2D::PathCompactMatchedPoint2D(const PathMatchedPoint2D & matchedPoint)
+: x(matchedPoint.pathPosture.position.x()),
+  y(matchedPoint.pathPosture.position.y()),
+  course(matchedPoint.pathPosture.course),
+  curvature(matchedPoint.pathPosture.curvature),
+  frenetPose(matchedPoint.frenetPose),
+  futureCurvature(matchedPoint.futureCurvature),
+  desiredSpeed(matchedPoint.desiredSpeed),
+  sectionMinimalCurvilinearAbscissa(matchedPoint.sectionMinimalCurvilinearAbscissa),
+  sectionMaximalCurvilinearAbscissa(matchedPoint.sectionMaximalCurvilinearAbscissa),
+  sectionIndex(matchedPoint.sectionIndex),
+  curveIndex(matchedPoint.curveIndex)
+{
+}
+
+//-----------------------------------------------------------------------------
+std::ostream & operator<<(std::ostream & os, const PathCompactMatchedPoint2D & matchedPoint)
+{
+  os << "Matched point " << std::endl;
+  os << " position = " << matchedPoint.x << " " << matchedPoint.y << std::endl;
+  os << " course = " << matchedPoint.course << std::endl;
+  os << " curvature = " << matchedPoint.curvature << std::endl;
+  os << matchedPoint.frenetPose;
+  os << "speed : " << matchedPoint.desiredSpeed << std::endl;
+  os << "section index : " << matchedPoint.sectionIndex << std::endl;
+  os << "section minimal curvilinear abscissa : " <<
+    matchedPoint.sectionMinimalCurvilinearAbscissa << std::endl;
+  os << "section maximal curvilinear abscissa : " <<
+    matchedPoint.sectionMaximalCurvilinearAbscissa << std::endl;
+  os << "curve index : " << matchedPoint.curveIndex;
+  return os;
+}
+
+//-----------------------------------------------------------------------------
+PathMatchedPoint2D toMatchedPoint(const PathCompactMatchedPoint2D & compactMatchedPoint)
+{
+  PathMatchedPoint2D matchedPoint;
+  matchedPoint.pathPosture.position.x() = compactMatchedPoint.x;
+  matchedPoint.pathPosture.position.y() = compactMatchedPoint.y;
+  matchedPoint.pathPosture.course = compactMatchedPoint.course;
+  matchedPoint.pathPosture.curvature = compactMatchedPoint.curvature;
+  matchedPoint.frenetPose.curvilinearAbscissa = compactMatchedPoint.frenetPose.curvilinearAbscissa;
+  matchedPoint.frenetPose.lateralDeviation = compactMatchedPoint.frenetPose.lateralDeviation;
+  matchedPoint.frenetPose.courseDeviation = compactMatchedPoint.frenetPose.courseDeviation;
+  matchedPoint.futureCurvature = compactMatchedPoint.futureCurvature;
+  matchedPoint.desiredSpeed = compactMatchedPoint.desiredSpeed;
+  matchedPoint.sectionIndex = compactMatchedPoint.sectionIndex;
+  matchedPoint.sectionMinimalCurvilinearAbscissa =
+    compactMatchedPoint.sectionMinimalCurvilinearAbscissa;
+  matchedPoint.sectionMaximalCurvilinearAbscissa =
+    compactMatchedPoint.sectionMaximalCurvilinearAbscissa;
+  matchedPoint.curveIndex = compactMatchedPoint.curveIndex;
+  return matchedPoint;
+}
+
+//-----------------------------------------------------------------------------
+double direction(const PathCompactMatchedPoint2D & matchedPoint)
+{
+  return std::isfinite(matchedPoint.desiredSpeed) ? sign(matchedPoint.desiredSpeed) : 1;
+}
+
+//-----------------------------------------------------------------------------
+Eigen::Vector2d globalPosition(const PathCompactMatchedPoint2D & matchedPoint)
+{
+  const double & lateralDeviation = matchedPoint.frenetPose.lateralDeviation;
+  return Eigen::Vector2d(
+    matchedPoint.x - std::sin(matchedPoint.course) * lateralDeviation,
+    matchedPoint.y + std::cos(matchedPoint.course) * lateralDeviation);
+}
+
+//-----------------------------------------------------------------------------
+const PathCompactMatchedPoint2D * findMatchedPointBySectionIndex(
+  const PathCompactMatchedPoint2D * first,
+  const PathCompactMatchedPoint2D * last,
+  const size_t & sectionIndex)
+{
+  return findBySectionIndex(first, last, sectionIndex);
+}
+
+//-----------------------------------------------------------------------------
+void compact(
+  const std::vector<PathMatchedPoint2D> & matchedPoints,
+  std::vector<PathCompactMatchedPoint2D> & compactMatchedPoints)
+{
+  compactMatchedPoints.clear();
+  for (const auto & matchedPoint : matchedPoints) {
+    compactMatchedPoints.emplace_back(matchedPoint);
+  }
+}
+
 }  // namespace core
 }  // namespace romea
@@ -0,0 +1,170 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// romea
+#include "romea_core_path/PathHandle.hpp"
+#include "romea_core_path/PathMatcher.hpp"
+#include "romea_core_path/PathMatching2D.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+PathMatcher::PathMatcher(
+  const Path2D & path,
+  const PathMatcherParameters & parameters)
+: path_(&path),
+  parameters_(parameters),
+  trackedPoint_(),
+  previousStamp_(0),
+  matchedPoints_(),
+  sectionIndexes_()
+{
+  matchedPoints_.reserve(std::max<size_t>(path.size(), 3));
+  sectionIndexes_.reserve(path.size());
+}
+
+//-----------------------------------------------------------------------------
+const std::vector<PathMatchedPoint2D> & PathMatcher::match(
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const double & stamp)
+{
+  if (trackedPoint_.has_value()) {
+    double s = trackedPoint_->frenetPose.curvilinearAbscissa;
+    double halfResearchLength = computeResearchLength_(vehicleSpeed, stamp) / 2.;
+    Interval<double> researchInterval(s - halfResearchLength, s + halfResearchLength);
+
+    std::optional<PathMatchedPoint2D> matchedPoint;
+    if (parameters_.newtonWarmStart) {
+      matchedPoint = warmStartedMatch(
+        *path_,
+        vehiclePose,
+        vehicleSpeed,
+        *trackedPoint_,
+        researchInterval,
+        parameters_.timeHorizon,
+        parameters_.researchRadius,
+        parameters_.propagateCovariance);
+    }
+
+    if (matchedPoint.has_value()) {
+      matchedPoints_.clear();
+      matchedPoints_.push_back(*matchedPoint);
+    } else {
+      core::match(
+        *path_,
+        vehiclePose,
+        vehicleSpeed,
+        trackedPoint_->sectionIndex,
+        trackedPoint_->curveIndex,
+        researchInterval,
+        parameters_.timeHorizon,
+        parameters_.researchRadius,
+        matchedPoints_,
+        parameters_.propagateCovariance,
+        parameters_.outwardCandidateSearch);
+    }
+  }
+
+  if (!trackedPoint_.has_value() ||
+    (matchedPoints_.empty() && parameters_.globalMatchingOnLoss))
+  {
+    core::match(
+      *path_,
+      vehiclePose,
+      vehicleSpeed,
+      parameters_.timeHorizon,
+      parameters_.researchRadius,
+      matchedPoints_,
+      sectionIndexes_,
+      parameters_.propagateCovariance);
+  }
+
+  if (matchedPoints_.empty()) {
+    trackedPoint_.reset();
+  } else {
+    trackedPoint_ = matchedPoints_.front();
+  }
+  previousStamp_ = stamp;
+
+  return matchedPoints_;
+}
+
+//-----------------------------------------------------------------------------
+double PathMatcher::computeResearchLength_(
+  const double & vehicleSpeed,
+  const double & stamp) const
+{
+  double travelledDistance = std::abs(vehicleSpeed * (stamp - previousStamp_));
+  return std::clamp(
+    parameters_.researchLengthFactor * travelledDistance,
+    parameters_.minimalResearchLength,
+    parameters_.maximalResearchLength);
+}
+
+//-----------------------------------------------------------------------------
+bool PathMatcher::isTracking() const
+{
+  return trackedPoint_.has_value();
+}
+
+//-----------------------------------------------------------------------------
+const std::optional<PathMatchedPoint2D> & PathMatcher::getTrackedPoint() const
+{
+  return trackedPoint_;
+}
+
+//-----------------------------------------------------------------------------
+void PathMatcher::reset()
+{
+  trackedPoint_.reset();
+  matchedPoints_.clear();
+}
+
+//-----------------------------------------------------------------------------
+void PathMatcher::setPath(const Path2D & path)
+{
+  if (trackedPoint_.has_value()) {
+    trackedPoint_ = remapMatchedPoint(*trackedPoint_, *path_, path);
+  }
+
+  path_ = &path;
+  matchedPoints_.clear();
+  matchedPoints_.reserve(std::max<size_t>(path.size(), 3));
+  sectionIndexes_.reserve(path.size());
+}
+
+//-----------------------------------------------------------------------------
+const Path2D & PathMatcher::getPath() const
+{
+  return *path_;
+}
+
+//-----------------------------------------------------------------------------
+const PathMatcherParameters & PathMatcher::getParameters() const
+{
+  return parameters_;
+}
+
+}  // namespace core
+}  // namespace romea
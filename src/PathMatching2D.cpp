@@ -15,12 +15,11 @@
 // std
 #include <algorithm>
 #include <cassert>
-#include <iostream>
-#include <list>
 #include <vector>
 
 // romea
 #include "romea_core_path/PathMatching2D.hpp"
+#include "romea_core_path/PathMatchingInstrumentation.hpp"
 #include "romea_core_path/PathSectionMatching2D.hpp"
 #include "romea_core_common/math/EulerAngles.hpp"
 #include "romea_core_common/math/Algorithm.hpp"
@@ -30,56 +29,101 @@ namespace
 {
 
 //----------------------------------------------------------------------------
-// try to match for the first time (no current matched points)
+bool isNearby(
+  const romea::core::PathSection2D & section,
+  const romea::core::Pose2D & vehiclePose,
+  const double & researchRadius)
+{
+  return section.getBoundingBox().squaredExteriorDistance(vehiclePose.position) <
+         researchRadius * researchRadius;
+}
+
+//----------------------------------------------------------------------------
+// Stable insertion sort, matching yields at most three points and the buffer
+// must not be reallocated
+template<typename MatchedPoint>
+void sortByLateralDeviation(
+  std::vector<MatchedPoint> & matchedPoints,
+  const double & vehicleSpeed)
+{
+  auto score = [vehicleSpeed](const MatchedPoint & matchedPoint) {
+      double lateralDeviation = std::abs(matchedPoint.frenetPose.lateralDeviation);
+      if (std::signbit(matchedPoint.desiredSpeed) != std::signbit(vehicleSpeed)) {
+        lateralDeviation += 1000;
+      }
+      return lateralDeviation;
+    };
+
+  for (size_t i = 1; i < matchedPoints.size(); ++i) {
+    for (size_t j = i; j > 0 && score(matchedPoints[j]) < score(matchedPoints[j - 1]); --j) {
+      std::swap(matchedPoints[j], matchedPoints[j - 1]);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void setSection(
+  romea::core::PathMatchedPoint2D & matchedPoint,
+  const romea::core::Path2D & path,
+  const size_t & sectionIndex)
+{
+  const auto & section = path.getSection(sectionIndex);
+  matchedPoint.sectionIndex = sectionIndex;
+  matchedPoint.sectionMinimalCurvilinearAbscissa =
+    section.getCurvilinearAbscissa().initialValue();
+  matchedPoint.sectionMaximalCurvilinearAbscissa =
+    section.getCurvilinearAbscissa().finalValue();
+}
+
+//----------------------------------------------------------------------------
+// try to match for the first time (no current matched points), MatchedPoint is
+// either PathMatchedPoint2D or PathCompactMatchedPoint2D
+template<typename MatchedPoint>
 void match_impl(
   const romea::core::Path2D & path,
   const romea::core::Pose2D & vehiclePose,
   const double & vehicleSpeed,
   const double & time_horizon,
   const double & researchRadius,
-  std::list<romea::core::PathMatchedPoint2D> & matchedPoints)
+  bool propagateCovariance,
+  std::vector<MatchedPoint> & matchedPoints,
+  std::vector<size_t> & sectionIndexes)
 {
-  std::vector<romea::core::PathMatchedPoint2D> all_points;
+  matchedPoints.clear();
+
+  // only the sections with a point in the research radius can be matched
+  path.findNearbySections(vehiclePose.position, researchRadius, sectionIndexes);
 
-  // std::cout << "match_impl: for the first time (no current matched point)\n";
-  for (size_t n = 0; n < path.size(); ++n) {
-    // std::cout << "  - section index: " << n;
+  ROMEA_PATH_COUNT(SECTIONS_PROBED, sectionIndexes.size());
+  for (const size_t & n : sectionIndexes) {
     auto matchedPoint = match(
       path.getSection(n),
       vehiclePose,
       vehicleSpeed,
       time_horizon,
-      researchRadius);
+      researchRadius,
+      propagateCovariance);
 
     if (matchedPoint.has_value()) {
-      matchedPoint->sectionIndex = n;
-      matchedPoint->sectionMinimalCurvilinearAbscissa =
-        path.getSection(n).getCurvilinearAbscissa().initialValue();
-      matchedPoint->sectionMaximalCurvilinearAbscissa =
-        path.getSection(n).getCurvilinearAbscissa().finalValue();
-      // matchedPoints.push_back(*matchedPoint);
-      all_points.push_back(*matchedPoint);
-      // std::cout << "  match found! lat dist: " << matchedPoint->frenetPose.lateralDeviation;
+      setSection(*matchedPoint, path, n);
+      matchedPoints.emplace_back(*matchedPoint);
     }
-
-    // std::cout << "\n";
   }
 
-  // only add the closest point
-  if (!all_points.empty()) {
+  // only keep the closest point
+  ROMEA_PATH_TIME_SCOPE(SORT);
+  if (!matchedPoints.empty()) {
     auto closest_point_it = std::min_element(
-      begin(all_points),
-      end(all_points),
+      begin(matchedPoints),
+      end(matchedPoints),
       [] (auto const & a, auto const & b) {
         return std::abs(a.frenetPose.lateralDeviation) < std::abs(b.frenetPose.lateralDeviation);
       }
     );
-    // std::cout << "closest point: " << closest_point_it->sectionIndex << "\n";
 
-    matchedPoints.push_back(*closest_point_it);
+    std::swap(matchedPoints.front(), *closest_point_it);
+    matchedPoints.resize(1);
   }
-
-  // std::cout.flush();
 }
 
 // //-----------------------------------------------------------------------------
@@ -112,6 +156,7 @@ void match_impl(
 
 
 //-----------------------------------------------------------------------------
+template<typename MatchedPoint>
 void match_impl(
   const romea::core::Path2D & path,
   const romea::core::Pose2D & vehiclePose,
@@ -121,11 +166,14 @@ void match_impl(
   const romea::core::Interval<double> & curvilinearAbscissaResearchInterval,
   const double & time_horizon,
   const double & researchRadius,
-  std::list<romea::core::PathMatchedPoint2D> & matchedPoints)
+  bool propagateCovariance,
+  bool outwardSearch,
+  std::vector<MatchedPoint> & matchedPoints)
 {
-  // std::cout << "\n\n local" << std::endl;
+  matchedPoints.clear();
   const auto & section = path.getSection(sectionIndex);
 
+  ROMEA_PATH_COUNT(SECTIONS_PROBED, 1);
   auto matched_point = match(
     section,
     vehiclePose,
@@ -133,26 +181,36 @@ void match_impl(
     curveIndex,
     curvilinearAbscissaResearchInterval,
     time_horizon,
-    researchRadius);
+    researchRadius,
+    propagateCovariance,
+    outwardSearch);
 
   if (matched_point.has_value()) {
-    matched_point->sectionIndex = sectionIndex;
-    matched_point->sectionMinimalCurvilinearAbscissa =
-      section.getCurvilinearAbscissa().initialValue();
-    matched_point->sectionMaximalCurvilinearAbscissa =
-      section.getCurvilinearAbscissa().finalValue();
-    matchedPoints.push_back(*matched_point);
+    setSection(*matched_point, path, sectionIndex);
+    matchedPoints.emplace_back(*matched_point);
   }
 
-  romea::core::Interval<size_t> rangeIndex = section.
-    findIntervalBoundIndexes(curveIndex, curvilinearAbscissaResearchInterval);
+  // neighbouring sections are probed when the research interval goes beyond the
+  // section ends, the outward search compares the abscissae directly to stay
+  // independent of the research length
+  bool reachesPreviousSection =
+    curvilinearAbscissaResearchInterval.lower() < section.getCurvilinearAbscissa().initialValue();
+  bool reachesNextSection =
+    curvilinearAbscissaResearchInterval.upper() > section.getCurvilinearAbscissa().finalValue();
+  if (!outwardSearch) {
+    romea::core::Interval<size_t> rangeIndex = section.
+      findIntervalBoundIndexes(curveIndex, curvilinearAbscissaResearchInterval);
+    reachesPreviousSection = reachesPreviousSection && rangeIndex.lower() == 0;
+    reachesNextSection = reachesNextSection && rangeIndex.upper() == section.size() - 1;
+  }
 
-  if (rangeIndex.lower() == 0 && sectionIndex != 0 &&
-    curvilinearAbscissaResearchInterval.lower() < section.getCurvilinearAbscissa().initialValue())
+  if (reachesPreviousSection && sectionIndex != 0 &&
+    isNearby(path.getSection(sectionIndex - 1), vehiclePose, researchRadius))
   {
     const auto & previousSection = path.getSection(sectionIndex - 1);
     const size_t previousCurveIndex = path.getSection(sectionIndex - 1).size() - 1;
 
+    ROMEA_PATH_COUNT(SECTIONS_PROBED, 1);
     auto previousMatchedPoint = match(
       previousSection,
       vehiclePose,
@@ -160,23 +218,22 @@ void match_impl(
       previousCurveIndex,
       curvilinearAbscissaResearchInterval,
       time_horizon,
-      researchRadius);
+      researchRadius,
+      propagateCovariance,
+      outwardSearch);
 
     if (previousMatchedPoint.has_value()) {
-      previousMatchedPoint->sectionIndex = sectionIndex - 1;
-      previousMatchedPoint->sectionMinimalCurvilinearAbscissa =
-        previousSection.getCurvilinearAbscissa().initialValue();
-      previousMatchedPoint->sectionMaximalCurvilinearAbscissa =
-        previousSection.getCurvilinearAbscissa().finalValue();
-      matchedPoints.push_front(*previousMatchedPoint);
+      setSection(*previousMatchedPoint, path, sectionIndex - 1);
+      matchedPoints.emplace(matchedPoints.begin(), *previousMatchedPoint);
     }
   }
 
-  if (rangeIndex.upper() == section.size() - 1 && sectionIndex != path.size() - 1 &&
-    curvilinearAbscissaResearchInterval.upper() > section.getCurvilinearAbscissa().finalValue())
+  if (reachesNextSection && sectionIndex != path.size() - 1 &&
+    isNearby(path.getSection(sectionIndex + 1), vehiclePose, researchRadius))
   {
     const auto & nextSection = path.getSection(sectionIndex + 1);
 
+    ROMEA_PATH_COUNT(SECTIONS_PROBED, 1);
     auto nextMatchedPoint = match(
       nextSection,
       vehiclePose,
@@ -184,35 +241,19 @@ void match_impl(
       0,
       curvilinearAbscissaResearchInterval,
       time_horizon,
-      researchRadius);
+      researchRadius,
+      propagateCovariance,
+      outwardSearch);
 
     if (nextMatchedPoint.has_value()) {
-      nextMatchedPoint->sectionIndex = sectionIndex + 1;
-      nextMatchedPoint->sectionMinimalCurvilinearAbscissa =
-        nextSection.getCurvilinearAbscissa().initialValue();
-      nextMatchedPoint->sectionMaximalCurvilinearAbscissa =
-        nextSection.getCurvilinearAbscissa().finalValue();
-      matchedPoints.push_back(*nextMatchedPoint);
+      setSection(*nextMatchedPoint, path, sectionIndex + 1);
+      matchedPoints.emplace_back(*nextMatchedPoint);
     }
   }
 
   // reorder
-  matchedPoints.sort(
-    [vehicleSpeed](
-      const romea::core::PathMatchedPoint2D & first,
-      const romea::core::PathMatchedPoint2D & second)
-    {
-      double firstlateralDeviation = std::abs(first.frenetPose.lateralDeviation);
-      if (std::signbit(first.desiredSpeed) != std::signbit(vehicleSpeed)) {
-        firstlateralDeviation += 1000;
-      }
-      double secondlateralDeviation = std::abs(second.frenetPose.lateralDeviation);
-      if (std::signbit(second.desiredSpeed) != std::signbit(vehicleSpeed)) {
-        secondlateralDeviation += 1000;
-      }
-
-      return firstlateralDeviation < secondlateralDeviation;
-    });
+  ROMEA_PATH_TIME_SCOPE(SORT);
+  sortByLateralDeviation(matchedPoints, vehicleSpeed);
 }
 
 }  // namespace
@@ -228,19 +269,21 @@ std::vector<PathMatchedPoint2D> match(
   const Pose2D & vehiclePose,
   const double & vehicleSpeed,
   const double & time_horizon,
-  const double & researchRadius)
+  const double & researchRadius,
+  bool propagateCovariance)
 {
-  std::list<PathMatchedPoint2D> matchedPoints;
-
-  match_impl(
+  std::vector<PathMatchedPoint2D> matchedPoints;
+  std::vector<size_t> sectionIndexes;
+  match(
     path,
     vehiclePose,
     vehicleSpeed,
     time_horizon,
     researchRadius,
-    matchedPoints);
-
-  return std::vector<PathMatchedPoint2D>(matchedPoints.begin(), matchedPoints.end());
+    matchedPoints,
+    sectionIndexes,
+    propagateCovariance);
+  return matchedPoints;
 }
 
 //----------------------------------------------------------------------------
@@ -251,7 +294,8 @@ std::vector<PathMatchedPoint2D> match(
   const PathMatchedPoint2D & previousMatchedPoint,
   const double & expectedTravelledDistance,
   const double & time_horizon,
-  const double & researchRadius)
+  const double & researchRadius,
+  bool propagateCovariance)
 {
   double s = previousMatchedPoint.frenetPose.curvilinearAbscissa;
   double mins = s - expectedTravelledDistance / 2.;
@@ -265,7 +309,8 @@ std::vector<PathMatchedPoint2D> match(
     previousMatchedPoint.curveIndex,
     Interval<double>(mins, maxs),
     time_horizon,
-    researchRadius);
+    researchRadius,
+    propagateCovariance);
 }
 
 
@@ -278,10 +323,126 @@ std::vector<PathMatchedPoint2D> match(
   const size_t & previousCurveIndex,
   const Interval<double> & curvilinearAbscissaResearchInterval,
   const double & time_horizon,
-  const double & researchRadius)
+  const double & researchRadius,
+  bool propagateCovariance,
+  bool outwardSearch)
 {
-  std::list<PathMatchedPoint2D> matchedPoints;
+  std::vector<PathMatchedPoint2D> matchedPoints;
+  match(
+    path,
+    vehiclePose,
+    vehicleSpeed,
+    previousSectionIndex,
+    previousCurveIndex,
+    curvilinearAbscissaResearchInterval,
+    time_horizon,
+    researchRadius,
+    matchedPoints,
+    propagateCovariance,
+    outwardSearch);
+  return matchedPoints;
+}
 
+//----------------------------------------------------------------------------
+void match(
+  const Path2D & path,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const double & time_horizon,
+  const double & researchRadius,
+  std::vector<PathMatchedPoint2D> & matchedPoints,
+  std::vector<size_t> & sectionIndexes,
+  bool propagateCovariance)
+{
+  ROMEA_PATH_TIME_SCOPE(MATCH);
+  match_impl(
+    path,
+    vehiclePose,
+    vehicleSpeed,
+    time_horizon,
+    researchRadius,
+    propagateCovariance,
+    matchedPoints,
+    sectionIndexes);
+
+  if (matchedPoints.empty()) {
+    ROMEA_PATH_COUNT(MATCH_LOSSES, 1);
+  }
+}
+
+//----------------------------------------------------------------------------
+void match(
+  const Path2D & path,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const size_t & previousSectionIndex,
+  const size_t & previousCurveIndex,
+  const Interval<double> & curvilinearAbscissaResearchInterval,
+  const double & time_horizon,
+  const double & researchRadius,
+  std::vector<PathMatchedPoint2D> & matchedPoints,
+  bool propagateCovariance,
+  bool outwardSearch)
+{
+  ROMEA_PATH_TIME_SCOPE(MATCH);
+  match_impl(
+    path,
+    vehiclePose,
+    vehicleSpeed,
+    previousSectionIndex,
+    previousCurveIndex,
+    curvilinearAbscissaResearchInterval,
+    time_horizon,
+    researchRadius,
+    propagateCovariance,
+    outwardSearch,
+    matchedPoints);
+
+  if (matchedPoints.empty()) {
+    ROMEA_PATH_COUNT(MATCH_LOSSES, 1);
+  }
+}
+
+//----------------------------------------------------------------------------
+void match(
+  const Path2D & path,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const double & time_horizon,
+  const double & researchRadius,
+  std::vector<PathCompactMatchedPoint2D> & matchedPoints,
+  std::vector<size_t> & sectionIndexes)
+{
+  ROMEA_PATH_TIME_SCOPE(MATCH);
+  match_impl(
+    path,
+    vehiclePose,
+    vehicleSpeed,
+    time_horizon,
+    researchRadius,
+    false,
+    matchedPoints,
+    sectionIndexes);
+
+  if (matchedPoints.empty()) {
+    ROMEA_PATH_COUNT(MATCH_LOSSES, 1);
+  }
+}
+
+//----------------------------------------------------------------------------
+void match(
+  const Path2D & path,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const size_t & previousSectionIndex,
+  const size_t & previousCurveIndex,
+  const Interval<double> & curvilinearAbscissaResearchInterval,
+  const double & time_horizon,
+  const double & researchRadius,
+  std::vector<PathCompactMatchedPoint2D> & matchedPoints,
+  bool outwardSearch)
+{
+  ROMEA_PATH_TIME_SCOPE(MATCH);
   match_impl(
     path,
     vehiclePose,
@@ -291,9 +452,55 @@ std::vector<PathMatchedPoint2D> match(
     curvilinearAbscissaResearchInterval,
     time_horizon,
     researchRadius,
+    false,
+    outwardSearch,
     matchedPoints);
 
-  return std::vector<PathMatchedPoint2D>(matchedPoints.begin(), matchedPoints.end());
+  if (matchedPoints.empty()) {
+    ROMEA_PATH_COUNT(MATCH_LOSSES, 1);
+  }
+}
+
+//----------------------------------------------------------------------------
+std::optional<PathMatchedPoint2D> warmStartedMatch(
+  const Path2D & path,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const PathMatchedPoint2D & previousMatchedPoint,
+  const Interval<double> & curvilinearAbscissaInterval,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance)
+{
+  ROMEA_PATH_TIME_SCOPE(MATCH);
+  const size_t & sectionIndex = previousMatchedPoint.sectionIndex;
+  const auto & section = path.getSection(sectionIndex);
+
+  // only the tracked match looks for the neighbouring sections
+  if (curvilinearAbscissaInterval.lower() < section.getCurvilinearAbscissa().initialValue() ||
+    curvilinearAbscissaInterval.upper() > section.getCurvilinearAbscissa().finalValue())
+  {
+    return std::nullopt;
+  }
+
+  ROMEA_PATH_COUNT(SECTIONS_PROBED, 1);
+  auto matchedPoint = warmStartedMatch(
+    section,
+    vehiclePose,
+    vehicleSpeed,
+    previousMatchedPoint,
+    time_horizon,
+    researchRadius,
+    propagateCovariance);
+
+  if (!matchedPoint.has_value() ||
+    !curvilinearAbscissaInterval.inside(matchedPoint->frenetPose.curvilinearAbscissa))
+  {
+    return std::nullopt;
+  }
+
+  setSection(*matchedPoint, path, sectionIndex);
+  return matchedPoint;
 }
 
 }  // namespace core
@@ -0,0 +1,156 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <atomic>
+
+// romea
+#include "romea_core_path/PathMatchingInstrumentation.hpp"
+
+namespace
+{
+
+using romea::core::LatencyHistogram;
+
+constexpr size_t NUMBER_OF_STAGES = size_t(romea::core::MatchingStage::NUMBER_OF_STAGES);
+constexpr size_t NUMBER_OF_COUNTERS = size_t(romea::core::MatchingCounter::NUMBER_OF_COUNTERS);
+
+// relaxed atomics, a snapshot taken during matching may mix two calls
+struct AtomicLatencyHistogram
+{
+  std::array<std::atomic<std::uint64_t>, LatencyHistogram::NUMBER_OF_BINS> bins;
+  std::atomic<std::uint64_t> count;
+  std::atomic<std::uint64_t> totalNanoseconds;
+  std::atomic<std::uint64_t> maximalNanoseconds;
+};
+
+// zero initialized as objects with static storage duration
+std::array<AtomicLatencyHistogram, NUMBER_OF_STAGES> stages_;
+std::array<std::atomic<std::uint64_t>, NUMBER_OF_COUNTERS> counters_;
+
+//-----------------------------------------------------------------------------
+size_t binIndex(const std::uint64_t & nanoseconds)
+{
+  size_t bitWidth = nanoseconds == 0 ? 0 : 64 - __builtin_clzll(nanoseconds);
+  return std::min(bitWidth, LatencyHistogram::NUMBER_OF_BINS - 1);
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+double LatencyHistogram::meanNanoseconds() const
+{
+  return count == 0 ? 0. : double(totalNanoseconds) / count;
+}
+
+//-----------------------------------------------------------------------------
+std::uint64_t LatencyHistogram::quantileNanoseconds(const double & q) const
+{
+  std::uint64_t rank = static_cast<std::uint64_t>(q * count);
+  std::uint64_t cumulativeCount = 0;
+  for (size_t n = 0; n < NUMBER_OF_BINS; ++n) {
+    cumulativeCount += bins[n];
+    if (cumulativeCount > rank) {
+      return std::min(std::uint64_t(1) << n, maximalNanoseconds);
+    }
+  }
+  return maximalNanoseconds;
+}
+
+//-----------------------------------------------------------------------------
+const LatencyHistogram & MatchingInstrumentationSnapshot::stage(
+  const MatchingStage & stage) const
+{
+  return stages[size_t(stage)];
+}
+
+//-----------------------------------------------------------------------------
+std::uint64_t MatchingInstrumentationSnapshot::counter(const MatchingCounter & counter) const
+{
+  return counters[size_t(counter)];
+}
+
+//-----------------------------------------------------------------------------
+MatchingInstrumentationSnapshot getMatchingInstrumentationSnapshot()
+{
+  MatchingInstrumentationSnapshot snapshot;
+  for (size_t i = 0; i < NUMBER_OF_STAGES; ++i) {
+    auto & histogram = snapshot.stages[i];
+    for (size_t n = 0; n < LatencyHistogram::NUMBER_OF_BINS; ++n) {
+      histogram.bins[n] = stages_[i].bins[n].load(std::memory_order_relaxed);
+    }
+    histogram.count = stages_[i].count.load(std::memory_order_relaxed);
+    histogram.totalNanoseconds = stages_[i].totalNanoseconds.load(std::memory_order_relaxed);
+    histogram.maximalNanoseconds = stages_[i].maximalNanoseconds.load(std::memory_order_relaxed);
+  }
+
+  for (size_t i = 0; i < NUMBER_OF_COUNTERS; ++i) {
+    snapshot.counters[i] = counters_[i].load(std::memory_order_relaxed);
+  }
+
+  return snapshot;
+}
+
+//-----------------------------------------------------------------------------
+void resetMatchingInstrumentation()
+{
+  for (auto & histogram : stages_) {
+    for (auto & bin : histogram.bins) {
+      bin.store(0, std::memory_order_relaxed);
+    }
+    histogram.count.store(0, std::memory_order_relaxed);
+    histogram.totalNanoseconds.store(0, std::memory_order_relaxed);
+    histogram.maximalNanoseconds.store(0, std::memory_order_relaxed);
+  }
+
+  for (auto & counter : counters_) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+}
+
+namespace instrumentation
+{
+
+//-----------------------------------------------------------------------------
+void record(const MatchingStage & stage, const std::uint64_t & nanoseconds)
+{
+  auto & histogram = stages_[size_t(stage)];
+  histogram.bins[binIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+  histogram.count.fetch_add(1, std::memory_order_relaxed);
+  histogram.totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+  std::uint64_t maximum = histogram.maximalNanoseconds.load(std::memory_order_relaxed);
+  while (nanoseconds > maximum &&
+    !histogram.maximalNanoseconds.compare_exchange_weak(
+      maximum, nanoseconds, std::memory_order_relaxed))
+  {
+  }
+}
+
+//-----------------------------------------------------------------------------
+void add(const MatchingCounter & counter, const std::uint64_t & value)
+{
+  counters_[size_t(counter)].fetch_add(value, std::memory_order_relaxed);
+}
+
+}  // namespace instrumentation
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,260 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_core_path/PathMatcher.hpp"
+#include "romea_core_path/PathMatchingReplay.hpp"
+
+namespace
+{
+
+constexpr size_t NUMBER_OF_COLUMNS = 5;
+
+//-----------------------------------------------------------------------------
+bool endsWith(const std::string & str, const std::string & suffix)
+{
+  return str.size() >= suffix.size() &&
+         0 == str.compare(str.size() - suffix.size(), suffix.size(), suffix);
+}
+
+//-----------------------------------------------------------------------------
+romea::core::PoseLogRecord makeRecord(const double (& values)[NUMBER_OF_COLUMNS])
+{
+  romea::core::PoseLogRecord record;
+  record.stamp = values[0];
+  record.pose.position.x() = values[1];
+  record.pose.position.y() = values[2];
+  record.pose.yaw = values[3];
+  record.speed = values[4];
+  return record;
+}
+
+//-----------------------------------------------------------------------------
+romea::core::PoseLog loadBinaryPoseLog(std::ifstream & file)
+{
+  romea::core::PoseLog log;
+  double values[NUMBER_OF_COLUMNS];
+  while (file.read(reinterpret_cast<char *>(values), sizeof(values))) {
+    log.push_back(makeRecord(values));
+  }
+
+  if (file.gcount() != 0) {
+    throw std::runtime_error("Truncated record at the end of binary pose log");
+  }
+  return log;
+}
+
+//-----------------------------------------------------------------------------
+romea::core::PoseLog loadCsvPoseLog(std::ifstream & file)
+{
+  romea::core::PoseLog log;
+  std::string line;
+  size_t lineNumber = 0;
+  while (std::getline(file, line)) {
+    ++lineNumber;
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::replace(line.begin(), line.end(), ',', ' ');
+    std::istringstream stream(line);
+    double values[NUMBER_OF_COLUMNS];
+    for (auto & value : values) {
+      stream >> value;
+    }
+
+    if (stream.fail()) {
+      // the first line may hold the column names
+      if (lineNumber == 1) {
+        continue;
+      }
+      throw std::runtime_error(
+              "Failed to parse pose log line " + std::to_string(lineNumber));
+    }
+    log.push_back(makeRecord(values));
+  }
+  return log;
+}
+
+//-----------------------------------------------------------------------------
+std::uint64_t quantile(const std::vector<std::uint64_t> & sortedValues, const double & q)
+{
+  if (sortedValues.empty()) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(q * sortedValues.size());
+  return sortedValues[std::min(index, sortedValues.size() - 1)];
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+PoseLog loadPoseLog(const std::string & filename)
+{
+  std::ifstream file;
+  if (endsWith(filename, ".bin")) {
+    file.open(filename, std::ios::binary);
+  } else {
+    file.open(filename);
+  }
+
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open pose log " + filename);
+  }
+
+  return endsWith(filename, ".bin") ? loadBinaryPoseLog(file) : loadCsvPoseLog(file);
+}
+
+//-----------------------------------------------------------------------------
+void savePoseLog(const std::string & filename, const PoseLog & log)
+{
+  bool binary = endsWith(filename, ".bin");
+  std::ofstream file(filename, binary ? std::ios::binary : std::ios::out);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open pose log " + filename);
+  }
+
+  if (!binary) {
+    file << "stamp,x,y,yaw,speed\n";
+    file.precision(17);
+  }
+
+  for (const auto & record : log) {
+    double values[NUMBER_OF_COLUMNS] = {
+      record.stamp,
+      record.pose.position.x(),
+      record.pose.position.y(),
+      record.pose.yaw,
+      record.speed};
+
+    if (binary) {
+      file.write(reinterpret_cast<const char *>(values), sizeof(values));
+    } else {
+      file << values[0] << ',' << values[1] << ',' << values[2] << ',' <<
+        values[3] << ',' << values[4] << '\n';
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+MatchingReplayResult replayMatching(
+  const Path2D & path,
+  const PoseLog & log,
+  const MatchingReplayParameters & parameters)
+{
+  MatchingReplayResult result;
+  result.matchedPoints.reserve(log.size());
+  result.latencyNanoseconds.reserve(log.size());
+
+  PathMatcherParameters matcherParameters;
+  matcherParameters.timeHorizon = parameters.timeHorizon;
+  matcherParameters.researchRadius = parameters.researchRadius;
+  matcherParameters.minimalResearchLength = parameters.minimalResearchLength;
+  matcherParameters.newtonWarmStart = parameters.newtonWarmStart;
+  matcherParameters.outwardCandidateSearch = parameters.outwardCandidateSearch;
+  PathMatcher matcher(path, matcherParameters);
+
+  for (size_t n = 0; n < log.size(); ++n) {
+    const auto & record = log[n];
+    bool wasTracking = matcher.isTracking();
+
+    auto start = std::chrono::steady_clock::now();
+    const auto & matchedPoints = matcher.match(record.pose, record.speed, record.stamp);
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    result.latencyNanoseconds.push_back(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+
+    if (matchedPoints.empty()) {
+      if (wasTracking) {
+        result.matchLosses.push_back(n);
+      }
+      result.matchedPoints.emplace_back();
+    } else {
+      result.matchedPoints.push_back(matchedPoints.front());
+    }
+  }
+
+  return result;
+}
+
+//-----------------------------------------------------------------------------
+MatchingReplayStatistics computeStatistics(const MatchingReplayResult & result)
+{
+  MatchingReplayStatistics statistics;
+  statistics.numberOfPoses = result.matchedPoints.size();
+  statistics.numberOfMatchLosses = result.matchLosses.size();
+
+  std::vector<std::uint64_t> latencies = result.latencyNanoseconds;
+  std::sort(latencies.begin(), latencies.end());
+
+  std::uint64_t totalNanoseconds = 0;
+  for (const auto & latency : latencies) {
+    totalNanoseconds += latency;
+  }
+
+  if (totalNanoseconds != 0) {
+    statistics.matchesPerSecond = latencies.size() * 1e9 / totalNanoseconds;
+  }
+  statistics.p50Nanoseconds = quantile(latencies, 0.5);
+  statistics.p99Nanoseconds = quantile(latencies, 0.99);
+  statistics.maximalNanoseconds = latencies.empty() ? 0 : latencies.back();
+  return statistics;
+}
+
+//-----------------------------------------------------------------------------
+void saveMatchedFrenetPoses(
+  const std::string & filename,
+  const PoseLog & log,
+  const MatchingReplayResult & result)
+{
+  std::ofstream file(filename);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + filename);
+  }
+
+  file << "stamp,section,curve,s,lateral_deviation,course_deviation\n";
+  file.precision(10);
+  for (size_t n = 0; n < result.matchedPoints.size(); ++n) {
+    file << log[n].stamp << ',';
+    if (const auto & matchedPoint = result.matchedPoints[n]) {
+      file << matchedPoint->sectionIndex << ',' <<
+        matchedPoint->curveIndex << ',' <<
+        matchedPoint->frenetPose.curvilinearAbscissa << ',' <<
+        matchedPoint->frenetPose.lateralDeviation << ',' <<
+        matchedPoint->frenetPose.courseDeviation << '\n';
+    } else {
+      file << ",,,,\n";
+    }
+  }
+}
+
+}  // namespace core
+}  // namespace romea
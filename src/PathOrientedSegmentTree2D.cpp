@@ -0,0 +1,413 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_common/math/EulerAngles.hpp"
+#include "romea_core_path/PathOrientedSegmentTree2D.hpp"
+
+namespace
+{
+
+// margin on the orientation cone rejection absorbing atan2 rounding
+constexpr double CONE_REJECTION_MARGIN = 1e-9;
+
+//-----------------------------------------------------------------------------
+void mergeAngle(romea::core::PathOrientedSegmentTree2D::Node & node, const double & angle)
+{
+  if (node.coneWidth >= M_PI) {
+    return;
+  }
+
+  if (node.coneWidth < 0) {
+    node.coneStart = angle;
+    node.coneWidth = 0;
+    return;
+  }
+
+  double delta = std::fmod(angle - node.coneStart, 2 * M_PI);
+  if (delta < 0) {
+    delta += 2 * M_PI;
+  }
+
+  if (delta > node.coneWidth) {
+    // extend the cone on the closest side
+    double highExtension = delta - node.coneWidth;
+    double lowExtension = 2 * M_PI - delta;
+    if (highExtension <= lowExtension) {
+      node.coneWidth = delta;
+    } else {
+      node.coneStart = angle;
+      node.coneWidth += lowExtension;
+    }
+  }
+
+  node.coneWidth = std::min(node.coneWidth, M_PI);
+}
+
+//-----------------------------------------------------------------------------
+bool coneRejects(const romea::core::PathOrientedSegmentTree2D::Node & node, const double & yaw)
+{
+  if (node.coneWidth < 0 || node.coneWidth >= M_PI) {
+    return false;
+  }
+
+  double halfWidth = node.coneWidth / 2;
+  double distance = std::abs(romea::core::betweenMinusPiAndPi(yaw - node.coneStart - halfWidth));
+  return distance - halfWidth > M_PI_2 + CONE_REJECTION_MARGIN;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+struct PathOrientedSegmentTree2D::Query
+{
+  Eigen::Vector2d position;
+  Eigen::Vector2d heading;
+  double yaw;
+  const double * X;
+  const double * Y;
+  size_t lower;
+  size_t upper;
+  double minSqDist;
+  size_t nearestPointIndex;
+  size_t numberOfVisitedPoints;
+};
+
+//-----------------------------------------------------------------------------
+PathOrientedSegmentTree2D::Node::Node()
+: box(),
+  coneStart(0),
+  coneWidth(-1)
+{
+}
+
+//-----------------------------------------------------------------------------
+PathOrientedSegmentTree2D::PathOrientedSegmentTree2D()
+: directions_(),
+  backward_(),
+  levels_(1),
+  lastPosition_(Eigen::Vector2d::Zero())
+{
+}
+
+//-----------------------------------------------------------------------------
+void PathOrientedSegmentTree2D::addPoint(const Eigen::Vector2d & position, const double & speed)
+{
+  size_t n = size();
+  if (n % 64 == 0) {
+    backward_.push_back(0);
+  }
+  if (std::signbit(speed)) {
+    backward_[n / 64] |= std::uint64_t(1) << (n % 64);
+  }
+
+  if (n == 0) {
+    directions_.push_back(Eigen::Vector2d::Zero());
+    extendBoxes_(n, position);
+  } else {
+    Eigen::Vector2d direction = (position - lastPosition_).normalized();
+    directions_[n - 1] = direction;
+    directions_.push_back(direction);
+    extendBoxes_(n, position);
+    extendCones_(n - 1);
+    extendCones_(n);
+  }
+  lastPosition_ = position;
+
+  while (levels_.back().size() > 1) {
+    addLevel_();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void PathOrientedSegmentTree2D::addPoints(
+  const double * X,
+  const double * Y,
+  const double * speeds,
+  const size_t & size)
+{
+  if (this->size() != 0 || size == 0) {
+    for (size_t n = 0; n < size; ++n) {
+      addPoint(Eigen::Vector2d(X[n], Y[n]), speeds[n]);
+    }
+    return;
+  }
+
+  backward_.assign(size / 64 + 1, 0);
+  for (size_t n = 0; n < size; ++n) {
+    if (std::signbit(speeds[n])) {
+      backward_[n / 64] |= std::uint64_t(1) << (n % 64);
+    }
+  }
+
+  directions_.resize(size, Eigen::Vector2d::Zero());
+  for (size_t n = 0; n + 1 < size; ++n) {
+    directions_[n] = Eigen::Vector2d(X[n + 1] - X[n], Y[n + 1] - Y[n]).normalized();
+  }
+  if (size > 1) {
+    directions_[size - 1] = directions_[size - 2];
+  }
+  lastPosition_ = Eigen::Vector2d(X[size - 1], Y[size - 1]);
+
+  // the bottom level is built from the points, the upper ones from their children
+  levels_.assign(1, std::vector<Node>((size + BRANCHING_FACTOR - 1) / BRANCHING_FACTOR));
+  for (size_t n = 0; n < size; ++n) {
+    levels_[0][n / BRANCHING_FACTOR].box.extend(Eigen::Vector2d(X[n], Y[n]));
+  }
+  while (levels_.back().size() > 1) {
+    const auto & children = levels_.back();
+    std::vector<Node> nodes((children.size() + BRANCHING_FACTOR - 1) / BRANCHING_FACTOR);
+    for (size_t i = 0; i < children.size(); ++i) {
+      nodes[i / BRANCHING_FACTOR].box.extend(children[i].box);
+    }
+    levels_.push_back(std::move(nodes));
+  }
+
+  // cones are merged point by point as a cone cannot be merged into another one
+  for (size_t n = 0; size > 1 && n < size; ++n) {
+    bool degenerated;
+    double angle = travelAngle_(n, degenerated);
+
+    size_t span = BRANCHING_FACTOR;
+    for (auto & nodes : levels_) {
+      auto & node = nodes[n / span];
+      if (degenerated) {
+        node.coneWidth = M_PI;
+      } else {
+        mergeAngle(node, angle);
+      }
+      span *= BRANCHING_FACTOR;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void PathOrientedSegmentTree2D::reserve(size_t n)
+{
+  directions_.reserve(n);
+  backward_.reserve(n / 64 + 1);
+  levels_.front().reserve(n / BRANCHING_FACTOR + 1);
+}
+
+//-----------------------------------------------------------------------------
+void PathOrientedSegmentTree2D::clear()
+{
+  directions_.clear();
+  backward_.clear();
+  levels_.assign(1, {});
+}
+
+//-----------------------------------------------------------------------------
+size_t PathOrientedSegmentTree2D::size()const
+{
+  return directions_.size();
+}
+
+//-----------------------------------------------------------------------------
+const PathOrientedSegmentTree2D::Directions & PathOrientedSegmentTree2D::getDirections()const
+{
+  return directions_;
+}
+
+//-----------------------------------------------------------------------------
+Eigen::AlignedBox2d PathOrientedSegmentTree2D::getBoundingBox()const
+{
+  // the top level always has a single node once a point has been added
+  return size() == 0 ? Eigen::AlignedBox2d() : levels_.back().front().box;
+}
+
+//-----------------------------------------------------------------------------
+bool PathOrientedSegmentTree2D::isBackward(const size_t & pointIndex)const
+{
+  return (backward_[pointIndex / 64] >> (pointIndex % 64)) & 1;
+}
+
+//-----------------------------------------------------------------------------
+double PathOrientedSegmentTree2D::travelAngle_(
+  const size_t & pointIndex,
+  bool & degenerated)const
+{
+  Eigen::Vector2d direction = directions_[pointIndex];
+  degenerated = direction.isZero();
+  if (isBackward(pointIndex)) {
+    direction = -direction;
+  }
+  return std::atan2(direction.y(), direction.x());
+}
+
+//-----------------------------------------------------------------------------
+void PathOrientedSegmentTree2D::extendBoxes_(
+  const size_t & pointIndex,
+  const Eigen::Vector2d & position)
+{
+  size_t span = BRANCHING_FACTOR;
+  for (auto & nodes : levels_) {
+    size_t nodeIndex = pointIndex / span;
+    if (nodeIndex == nodes.size()) {
+      nodes.emplace_back();
+    }
+    nodes[nodeIndex].box.extend(position);
+    span *= BRANCHING_FACTOR;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void PathOrientedSegmentTree2D::extendCones_(const size_t & pointIndex)
+{
+  bool degenerated;
+  double angle = travelAngle_(pointIndex, degenerated);
+
+  size_t span = BRANCHING_FACTOR;
+  for (auto & nodes : levels_) {
+    auto & node = nodes[pointIndex / span];
+    if (degenerated) {
+      // a null direction matches any forward pose
+      node.coneWidth = M_PI;
+    } else {
+      mergeAngle(node, angle);
+    }
+    span *= BRANCHING_FACTOR;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void PathOrientedSegmentTree2D::addLevel_()
+{
+  Node root;
+  for (const auto & child : levels_.back()) {
+    root.box.extend(child.box);
+  }
+
+  // the points with a direction are all but a lonely first point
+  for (size_t n = 0; size() > 1 && n < size(); ++n) {
+    bool degenerated;
+    double angle = travelAngle_(n, degenerated);
+    if (degenerated) {
+      root.coneWidth = M_PI;
+    } else {
+      mergeAngle(root, angle);
+    }
+  }
+
+  levels_.emplace_back(1, root);
+}
+
+//-----------------------------------------------------------------------------
+size_t PathOrientedSegmentTree2D::findNearestOrientedPointIndex(
+  const double * X,
+  const double * Y,
+  const Pose2D & pose,
+  const Interval<size_t> & indexRange,
+  const double & researchRadius)const
+{
+  size_t numberOfVisitedPoints;
+  return findNearestOrientedPointIndex(
+    X, Y, pose, indexRange, researchRadius, numberOfVisitedPoints);
+}
+
+//-----------------------------------------------------------------------------
+size_t PathOrientedSegmentTree2D::findNearestOrientedPointIndex(
+  const double * X,
+  const double * Y,
+  const Pose2D & pose,
+  const Interval<size_t> & indexRange,
+  const double & researchRadius,
+  size_t & numberOfVisitedPoints)const
+{
+  numberOfVisitedPoints = 0;
+  if (size() == 0) {
+    return 0;
+  }
+
+  Query query;
+  query.position = pose.position;
+  query.heading = Eigen::Vector2d(std::cos(pose.yaw), std::sin(pose.yaw));
+  query.yaw = pose.yaw;
+  query.X = X;
+  query.Y = Y;
+  query.lower = indexRange.lower();
+  query.upper = std::min(indexRange.upper(), size() - 1);
+  query.minSqDist = researchRadius * researchRadius;
+  query.nearestPointIndex = size();
+  query.numberOfVisitedPoints = 0;
+
+  size_t span = BRANCHING_FACTOR;
+  for (size_t level = 1; level < levels_.size(); ++level) {
+    span *= BRANCHING_FACTOR;
+  }
+
+  for (size_t n = 0; n < levels_.back().size(); ++n) {
+    search_(levels_.size() - 1, n, span, query);
+  }
+
+  numberOfVisitedPoints = query.numberOfVisitedPoints;
+  return query.nearestPointIndex;
+}
+
+//-----------------------------------------------------------------------------
+void PathOrientedSegmentTree2D::search_(
+  const size_t & level,
+  const size_t & nodeIndex,
+  const size_t & nodeSpan,
+  Query & query)const
+{
+  size_t begin = std::max(nodeIndex * nodeSpan, query.lower);
+  size_t end = std::min((nodeIndex + 1) * nodeSpan - 1, query.upper);
+  if (begin > end) {
+    return;
+  }
+
+  const Node & node = levels_[level][nodeIndex];
+  if (node.box.squaredExteriorDistance(query.position) >= query.minSqDist ||
+    coneRejects(node, query.yaw))
+  {
+    return;
+  }
+
+  if (level == 0) {
+    query.numberOfVisitedPoints += end - begin + 1;
+    for (size_t n = begin; n <= end; ++n) {
+      Eigen::Vector2d point(query.X[n], query.Y[n]);
+      double sqDist = (query.position - point).squaredNorm();
+      if (sqDist < query.minSqDist &&
+        std::signbit(query.heading.dot(directions_[n])) == isBackward(n))
+      {
+        query.minSqDist = sqDist;
+        query.nearestPointIndex = n;
+      }
+    }
+    return;
+  }
+
+  size_t childSpan = nodeSpan / BRANCHING_FACTOR;
+  size_t firstChild = nodeIndex * BRANCHING_FACTOR;
+  size_t lastChild = std::min(firstChild + BRANCHING_FACTOR, levels_[level - 1].size());
+  for (size_t child = firstChild; child < lastChild; ++child) {
+    search_(level - 1, child, childSpan, query);
+  }
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,71 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_CORE_PATH__PATHPOLYNOMIAL_HPP_
+#define ROMEA_CORE_PATH__PATHPOLYNOMIAL_HPP_
+
+// Eigen
+#include <Eigen/Core>
+
+// std
+#include <cmath>
+
+namespace romea
+{
+namespace core
+{
+namespace detail
+{
+
+// Evaluations of the cubics c[0] + c[1] s + c[2] s^2 + c[3] s^3 shared by the
+// local curves and the splines. They are written for a scalar abscissa and for
+// an Eigen array of abscissae, in which case they return a vectorized expression
+
+//-----------------------------------------------------------------------------
+template<typename Coefficients, typename T>
+inline auto evaluate(const Coefficients & c, const T & s)
+{
+  return c[0] + s * (c[1] + s * (c[2] + s * c[3]));
+}
+
+//-----------------------------------------------------------------------------
+template<typename Coefficients, typename T>
+inline auto evaluateFirstDerivative(const Coefficients & c, const T & s)
+{
+  return c[1] + s * (2 * c[2] + s * 3 * c[3]);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Coefficients, typename T>
+inline auto evaluateSecondDerivative(const Coefficients & c, const T & s)
+{
+  return 2 * c[2] + 6 * c[3] * s;
+}
+
+//-----------------------------------------------------------------------------
+// Normalised derivative vector, along x for a degenerated derivative like atan2(0, 0)
+inline Eigen::Vector2d unitDirection(const double & Xdot, const double & Ydot)
+{
+  double norm = std::sqrt(Xdot * Xdot + Ydot * Ydot);
+  if (norm == 0) {
+    return Eigen::Vector2d::UnitX();
+  }
+  return {Xdot / norm, Ydot / norm};
+}
+
+}  // namespace detail
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_PATH__PATHPOLYNOMIAL_HPP_
@@ -0,0 +1,179 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// romea
+#include "romea_core_path/PathResampling.hpp"
+
+namespace
+{
+
+// Resampled points whose remaining arc length to the last way point is below
+// this fraction of the step are dropped, the last step would be degenerated
+constexpr double MINIMAL_LAST_STEP_RATIO = 0.01;
+
+constexpr int MAXIMAL_NUMBER_OF_ITERATIONS = 20;
+constexpr double STEP_TOLERANCE = 1e-12;
+
+//-----------------------------------------------------------------------------
+// Way point whose abscissa is the closest to s, the search starts from index
+// and index is moved forward for the next call
+size_t findNearestIndex(
+  const romea::core::PathSection2D & section,
+  const double & curvilinearAbscissa,
+  size_t & index)
+{
+  const auto & S = section.getCurvilinearAbscissa();
+  index = section.findIndex(curvilinearAbscissa, index);
+  if (index > 0 && curvilinearAbscissa - S[index - 1] < S[index] - curvilinearAbscissa) {
+    return index - 1;
+  }
+  return index;
+}
+
+//-----------------------------------------------------------------------------
+Eigen::Vector2d computePosition(
+  const romea::core::PathSection2D & section,
+  const double & curvilinearAbscissa,
+  size_t & index)
+{
+  const auto & curve = section.getCurve(findNearestIndex(section, curvilinearAbscissa, index));
+  return {curve.computeX(curvilinearAbscissa), curve.computeY(curvilinearAbscissa)};
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+std::vector<PathWayPoint2D> resampleWayPoints(
+  const std::vector<PathWayPoint2D> & wayPoints,
+  const double & step,
+  const double & interpolationWindowLength,
+  const size_t & polynomialDegree)
+{
+  if (wayPoints.size() < 2 || !(step > 0)) {
+    return wayPoints;
+  }
+
+  PathSection2D section(interpolationWindowLength);
+  section.setPolynomialDegree(polynomialDegree);
+  section.addWayPoints(wayPoints);
+
+  // the loop stops on the arc length, the ends of a closed or U-turn path can be close
+  const double finalCurvilinearAbscissa = section.getCurvilinearAbscissa().finalValue();
+
+  std::vector<PathWayPoint2D> resampledWayPoints;
+  resampledWayPoints.reserve(static_cast<size_t>(section.getLength() / step) + 2);
+  resampledWayPoints.push_back(wayPoints.front());
+
+  size_t index = 0;
+  double s = section.getCurvilinearAbscissa().initialValue();
+  Eigen::Vector2d position = wayPoints.front().position;
+  while (s + step < finalCurvilinearAbscissa) {
+    // the chord to the next point is a little shorter than the arc, the
+    // abscissa is corrected until the chord is the step
+    double next = s + step;
+    size_t nextIndex = index;
+    Eigen::Vector2d nextPosition = computePosition(section, next, nextIndex);
+    for (int i = 0; i < MAXIMAL_NUMBER_OF_ITERATIONS; ++i) {
+      double error = (nextPosition - position).norm() - step;
+      if (std::abs(error) < STEP_TOLERANCE) {
+        break;
+      }
+      next -= error;
+      nextIndex = index;
+      nextPosition = computePosition(section, next, nextIndex);
+    }
+
+    if (finalCurvilinearAbscissa - next < MINIMAL_LAST_STEP_RATIO * step) {
+      break;
+    }
+
+    s = next;
+    index = nextIndex;
+    position = nextPosition;
+    size_t speedIndex = index;
+    resampledWayPoints.emplace_back(
+      position, wayPoints[findNearestIndex(section, s, speedIndex)].desired_speed);
+  }
+
+  resampledWayPoints.push_back(wayPoints.back());
+  return resampledWayPoints;
+}
+
+//-----------------------------------------------------------------------------
+Path2D resamplePath(
+  const Path2D::WayPoints & wayPoints,
+  const double & step,
+  const double & interpolationWindowLength,
+  const Path2D::Annotations & annotations,
+  const size_t & polynomialDegree)
+{
+  Path2D::WayPoints resampledWayPoints;
+  resampledWayPoints.reserve(wayPoints.size());
+  for (const auto & sectionWayPoints : wayPoints) {
+    resampledWayPoints.push_back(
+      resampleWayPoints(sectionWayPoints, step, interpolationWindowLength, polynomialDegree));
+  }
+
+  Path2D path(
+    resampledWayPoints, interpolationWindowLength, Path2D::Annotations(), polynomialDegree);
+  if (annotations.empty()) {
+    return path;
+  }
+
+  // abscissa of the original points, from the original sections
+  Path2D::Annotations resampledAnnotations;
+  size_t initialPointIndex = 0;
+  for (size_t i = 0; i < wayPoints.size(); ++i) {
+    const auto & section = path.getSection(i);
+    size_t numberOfWayPoints = wayPoints[i].size();
+    auto first = annotations.lower_bound(initialPointIndex);
+    auto last = annotations.lower_bound(initialPointIndex + numberOfWayPoints);
+    if (first != last) {
+      PathSection2D originalSection(interpolationWindowLength);
+      originalSection.addWayPoints(wayPoints[i]);
+      const auto & S = originalSection.getCurvilinearAbscissa();
+      double scale = S.finalValue() > 0 ? section.getLength() / S.finalValue() : 0;
+
+      for (auto it = first; it != last; ++it) {
+        double s = section.getCurvilinearAbscissa().initialValue() +
+          S[it->first - initialPointIndex] * scale;
+        size_t index = 0;
+        size_t resampledIndex =
+          section.getInitialPointIndex() + findNearestIndex(section, s, index);
+
+        auto annotation = it->second;
+        annotation.point_index = resampledIndex;
+        resampledAnnotations.emplace(resampledIndex, annotation);
+      }
+    }
+    initialPointIndex += numberOfWayPoints;
+  }
+
+  path.setAnnotations(resampledAnnotations);
+  return path;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -15,12 +15,24 @@
 // std
 #include <iostream>
 #include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
 #include <vector>
 
 // romea
+#include "romea_core_path/PathMatchingInstrumentation.hpp"
 #include "romea_core_path/PathSection2D.hpp"
 
 
+namespace
+{
+
+// Relative difference below which two steps are considered equal
+constexpr double UNIFORM_STEP_TOLERANCE = 1e-9;
+
+}  // namespace
+
 namespace romea
 {
 namespace core
@@ -35,9 +47,14 @@ PathSection2D::PathSection2D(
   Y_(),
   curvilinearAbscissa_(initialCurvilinearAbcissa),
   curves_(),
+  speeds_(),
+  segmentTree_(),
   initial_point_index_(initialPointIndex),
   interpolationWindowLength_(interpolationWindowLength),
-  length_(0)
+  polynomialDegree_(2),
+  length_(0),
+  uniformStep_(0),
+  hasShortLastStep_(false)
 {
 }
 
@@ -49,14 +66,93 @@ void PathSection2D::addWayPoint(const PathWayPoint2D & wayPoint)
   incrementCurvilinearAbscissa_();
   curves_.push_back(std::optional<PathCurve2D>());
   speeds_.push_back(wayPoint.desired_speed);
+  segmentTree_.addPoint(wayPoint.position, wayPoint.desired_speed);
 }
 
 //-----------------------------------------------------------------------------
 void PathSection2D::addWayPoints(const std::vector<PathWayPoint2D> & wayPoints)
 {
-  reserve(size() + wayPoints.size());
-  for (const auto & wayPoint : wayPoints) {
-    addWayPoint(wayPoint);
+  if (size() != 0) {
+    reserve(size() + wayPoints.size());
+    for (const auto & wayPoint : wayPoints) {
+      addWayPoint(wayPoint);
+    }
+    return;
+  }
+
+  X_.resize(wayPoints.size());
+  Y_.resize(wayPoints.size());
+  speeds_.resize(wayPoints.size());
+  for (size_t n = 0; n < wayPoints.size(); ++n) {
+    X_[n] = wayPoints[n].position.x();
+    Y_[n] = wayPoints[n].position.y();
+    speeds_[n] = wayPoints[n].desired_speed;
+  }
+  initializeFromColumns_();
+}
+
+//-----------------------------------------------------------------------------
+void PathSection2D::addWayPoints(WayPointColumns && wayPoints)
+{
+  assert(wayPoints.x.size() == wayPoints.y.size());
+  assert(wayPoints.x.size() == wayPoints.speeds.size());
+
+  if (size() != 0) {
+    addWayPoints(
+      wayPoints.x.data(), wayPoints.y.data(), wayPoints.speeds.data(), wayPoints.x.size());
+    return;
+  }
+
+  X_ = std::move(wayPoints.x);
+  Y_ = std::move(wayPoints.y);
+  speeds_ = std::move(wayPoints.speeds);
+  initializeFromColumns_();
+}
+
+//-----------------------------------------------------------------------------
+void PathSection2D::addWayPoints(
+  const double * x,
+  const double * y,
+  const double * speeds,
+  const size_t & size)
+{
+  if (this->size() != 0) {
+    reserve(this->size() + size);
+    for (size_t n = 0; n < size; ++n) {
+      addWayPoint({{x[n], y[n]}, speeds[n]});
+    }
+    return;
+  }
+
+  X_.assign(x, x + size);
+  Y_.assign(y, y + size);
+  speeds_.assign(speeds, speeds + size);
+  initializeFromColumns_();
+}
+
+//-----------------------------------------------------------------------------
+void PathSection2D::initializeFromColumns_()
+{
+  size_t size = X_.size();
+  curves_.resize(size);
+  segmentTree_.addPoints(X_.data(), Y_.data(), speeds_.data(), size);
+  if (size < 2) {
+    return;
+  }
+
+  // segment lengths are computed on whole columns to be vectorized, with the
+  // same operations as incrementCurvilinearAbscissa_ so that values are equal
+  Eigen::Map<const Eigen::ArrayXd> X(X_.data(), size);
+  Eigen::Map<const Eigen::ArrayXd> Y(Y_.data(), size);
+  Vector ds(size - 1);
+  Eigen::Map<Eigen::ArrayXd>(ds.data(), size - 1) =
+    ((X.tail(size - 1) - X.head(size - 1)).square() +
+    (Y.tail(size - 1) - Y.head(size - 1)).square()).sqrt();
+
+  curvilinearAbscissa_.assignFromDeltas(ds.data(), ds.size());
+  length_ = curvilinearAbscissa_.finalValue() - curvilinearAbscissa_.initialValue();
+  for (size_t n = 0; n < ds.size(); ++n) {
+    updateUniformStep_(ds[n], n == 0);
   }
 }
 
@@ -70,7 +166,25 @@ void PathSection2D::incrementCurvilinearAbscissa_()
     double ds = std::sqrt(dx * dx + dy * dy);
     //    std::cout << ds <<" "<< dx <<" "<<dy << std::endl;
     curvilinearAbscissa_.increment(ds);
-    length_ += ds;
+    // the length is derived from the compensated abscissae to be consistent with them
+    length_ = curvilinearAbscissa_.finalValue() - curvilinearAbscissa_.initialValue();
+    updateUniformStep_(ds, n == 1);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void PathSection2D::updateUniformStep_(const double & ds, bool firstStep)
+{
+  // only the last step may differ from the uniform one, and only be shorter
+  if (firstStep) {
+    uniformStep_ = ds;
+  } else if (uniformStep_ > 0) {
+    if (hasShortLastStep_) {
+      uniformStep_ = 0;
+    } else if (std::abs(ds - uniformStep_) > UNIFORM_STEP_TOLERANCE * uniformStep_) {
+      hasShortLastStep_ = ds < uniformStep_;
+      uniformStep_ = hasShortLastStep_ ? uniformStep_ : 0;
+    }
   }
 }
 
@@ -84,9 +198,30 @@ const PathCurve2D & PathSection2D::getCurve(const size_t & pointIndex)const
   return *curves_[pointIndex];
 }
 
+//-----------------------------------------------------------------------------
+void PathSection2D::setCurve(const size_t & pointIndex, const PathCurve2D & curve)
+{
+  curves_[pointIndex] = curve;
+}
+
+//-----------------------------------------------------------------------------
+void PathSection2D::setPolynomialDegree(const size_t & polynomialDegree)
+{
+  assert(polynomialDegree == 2 || polynomialDegree == 3);
+  polynomialDegree_ = polynomialDegree;
+  curves_.assign(curves_.size(), std::nullopt);
+}
+
+//-----------------------------------------------------------------------------
+size_t PathSection2D::getPolynomialDegree()const
+{
+  return polynomialDegree_;
+}
+
 //-----------------------------------------------------------------------------
 void PathSection2D::computePathCurve_(const size_t & pointIndex) const
 {
+  ROMEA_PATH_COUNT(CURVES_FITTED, 1);
   curves_[pointIndex].emplace();
 
   Interval<double> curvilinearAbscissaInterval =
@@ -94,13 +229,15 @@ void PathSection2D::computePathCurve_(const size_t & pointIndex) const
 
   Interval<size_t> indexRange = findIntervalBoundIndexes(pointIndex, curvilinearAbscissaInterval);
 
-  assert(
-    curves_[pointIndex]->estimate(
-      X_,
-      Y_,
-      curvilinearAbscissa_.data(),
-      indexRange,
-      curvilinearAbscissaInterval));
+  [[maybe_unused]] bool estimated = curves_[pointIndex]->estimate(
+    X_,
+    Y_,
+    curvilinearAbscissa_.data(),
+    indexRange,
+    curvilinearAbscissaInterval,
+    polynomialDegree_);
+
+  assert(estimated);
 }
 
 //-----------------------------------------------------------------------------
@@ -111,6 +248,7 @@ void PathSection2D::reserve(size_t n)
   curvilinearAbscissa_.reserve(n);
   curves_.reserve(n);
   speeds_.reserve(n);
+  segmentTree_.reserve(n);
 }
 
 //-----------------------------------------------------------------------------
@@ -137,6 +275,18 @@ const PathSection2D::Vector & PathSection2D::getSpeeds() const
   return speeds_;
 }
 
+//-----------------------------------------------------------------------------
+const PathOrientedSegmentTree2D & PathSection2D::getSegmentTree() const
+{
+  return segmentTree_;
+}
+
+//-----------------------------------------------------------------------------
+Eigen::AlignedBox2d PathSection2D::getBoundingBox() const
+{
+  return segmentTree_.getBoundingBox();
+}
+
 
 //-----------------------------------------------------------------------------
 const double & PathSection2D::getLength()const
@@ -144,6 +294,12 @@ const double & PathSection2D::getLength()const
   return length_;
 }
 
+//-----------------------------------------------------------------------------
+const double & PathSection2D::getUniformStep()const
+{
+  return uniformStep_;
+}
+
 size_t PathSection2D::getInitialPointIndex()const
 {
   return initial_point_index_;
@@ -162,13 +318,21 @@ void PathSection2D::clear()
   Y_.clear();
   curvilinearAbscissa_.clear();
   curves_.clear();
+  speeds_.clear();
+  segmentTree_.clear();
   length_ = 0;
+  uniformStep_ = 0;
+  hasShortLastStep_ = false;
 }
 
 
 //-----------------------------------------------------------------------------
 size_t PathSection2D::findIndex(const double & value, const size_t & startSearchIndex) const
 {
+  if (uniformStep_ > 0) {
+    return std::max(findUniformIndex_(value, false), startSearchIndex);
+  }
+
   size_t n = startSearchIndex;
   while (n < curvilinearAbscissa_.size() - 1 && curvilinearAbscissa_[n] < value) {
     n++;
@@ -182,6 +346,33 @@ size_t PathSection2D::findIndex(const double & value) const
   return findIndex(value, 0);
 }
 
+//-----------------------------------------------------------------------------
+// First index whose abscissa is not lower (greater when strict) than value, the
+// last one when there is none. The estimate given by the uniform step is only
+// corrected for the rounding of the abscissae and for the shorter last step.
+size_t PathSection2D::findUniformIndex_(const double & value, bool strict) const
+{
+  const auto & S = curvilinearAbscissa_;
+  auto isBefore = [&](const size_t & n) {return strict ? S[n] <= value : S[n] < value;};
+
+  size_t lastIndex = S.size() - 1;
+  double position = (value - S.initialValue()) / uniformStep_;
+  size_t n = lastIndex;
+  if (position <= 0) {
+    n = 0;
+  } else if (position < lastIndex) {
+    n = static_cast<size_t>(std::ceil(position));
+  }
+
+  while (n > 0 && !isBefore(n - 1)) {
+    --n;
+  }
+  while (n < lastIndex && isBefore(n)) {
+    ++n;
+  }
+  return n;
+}
+
 
 //-----------------------------------------------------------------------------
 Interval<double> PathSection2D::computeCurvilinearAbscissaInterval_(
@@ -217,6 +408,15 @@ Interval<size_t> PathSection2D::findIntervalBoundIndexes(
   size_t minimalIndex = intervalCenterIndex;
   size_t maximalIndex = intervalCenterIndex;
 
+  // same bounds as the walks below: the last point before the interval and
+  // the first one after it, or the section ends
+  if (uniformStep_ > 0 && interval.inside(curvilinearAbscissa_[intervalCenterIndex])) {
+    minimalIndex = findUniformIndex_(interval.lower(), false);
+    minimalIndex = minimalIndex == 0 ? 0 : minimalIndex - 1;
+    maximalIndex = findUniformIndex_(interval.upper(), true);
+    return {minimalIndex, maximalIndex};
+  }
+
   while (minimalIndex != 0 &&
     interval.inside(curvilinearAbscissa_[minimalIndex]))
   {
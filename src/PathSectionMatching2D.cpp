@@ -24,28 +24,265 @@
 // romea
 #include "romea_core_common/math/Algorithm.hpp"
 #include "romea_core_common/math/EulerAngles.hpp"
+#include "romea_core_path/PathMatchingInstrumentation.hpp"
 #include "romea_core_path/PathSectionMatching2D.hpp"
 
 namespace
 {
 
 //-----------------------------------------------------------------------------
+inline Eigen::Vector2d pointPosition(const romea::core::PathSection2D & section, size_t n)
+{
+  return {section.getX()[n], section.getY()[n]};
+}
+
+//-----------------------------------------------------------------------------
+inline Eigen::Vector2d pointPosition(
+  const romea::core::PathInterleavedSection2D & section, size_t n)
+{
+  const auto & point = section.getPoints()[n];
+  return {point.x, point.y};
+}
+
+//-----------------------------------------------------------------------------
+inline Eigen::Vector2d pointPosition(
+  const romea::core::PathCompactSection2D & section, size_t n)
+{
+  return section.getPosition(n);
+}
+
+//-----------------------------------------------------------------------------
+inline Eigen::Vector2d pointPosition(
+  const romea::core::PathSplineSection2D & section, size_t n)
+{
+  return {section.getX()[n], section.getY()[n]};
+}
+
+//-----------------------------------------------------------------------------
+inline double pointSpeed(const romea::core::PathSection2D & section, size_t n)
+{
+  return section.getSpeeds()[n];
+}
+
+//-----------------------------------------------------------------------------
+inline double pointSpeed(const romea::core::PathInterleavedSection2D & section, size_t n)
+{
+  return section.getPoints()[n].speed;
+}
+
+//-----------------------------------------------------------------------------
+inline double pointSpeed(const romea::core::PathCompactSection2D & section, size_t n)
+{
+  return section.getSpeed(n);
+}
+
+//-----------------------------------------------------------------------------
+inline double pointSpeed(const romea::core::PathSplineSection2D & section, size_t n)
+{
+  return section.getSpeeds()[n];
+}
+
+//-----------------------------------------------------------------------------
+inline double pointCurvilinearAbscissa(const romea::core::PathSection2D & section, size_t n)
+{
+  return section.getCurvilinearAbscissa()[n];
+}
+
+//-----------------------------------------------------------------------------
+inline double pointCurvilinearAbscissa(
+  const romea::core::PathInterleavedSection2D & section, size_t n)
+{
+  return section.getPoints()[n].curvilinearAbscissa;
+}
+
+//-----------------------------------------------------------------------------
+inline double pointCurvilinearAbscissa(
+  const romea::core::PathCompactSection2D & section, size_t n)
+{
+  return section.getCurvilinearAbscissa(n);
+}
+
+//-----------------------------------------------------------------------------
+inline double pointCurvilinearAbscissa(
+  const romea::core::PathSplineSection2D & section, size_t n)
+{
+  return section.getCurvilinearAbscissa()[n];
+}
+
+//-----------------------------------------------------------------------------
+// The path heading is given as a unit vector so that the deviations and the
+// covariance rotation only need the cos and sin of the vehicle yaw, atan2 is
+// computed once for the course of accepted points
+std::optional<romea::core::PathMatchedPoint2D> makeMatchedPoint(
+  const double & curvilinearAbscissa,
+  const double & xp,
+  const double & yp,
+  const Eigen::Vector2d & direction,
+  double curvature,
+  const romea::core::Pose2D & vehiclePose,
+  const double & desiredSpeed,
+  bool propagateCovariance)
+{
+  const double & xv = vehiclePose.position.x();
+  const double & yv = vehiclePose.position.y();
+  const double & o = vehiclePose.yaw;
+  const double & cost = direction.x();
+  const double & sint = direction.y();
+  const double coso = std::cos(o);
+  const double sino = std::sin(o);
+
+  // cos and sin of the course deviation o - tangent
+  double cosd = coso * cost + sino * sint;
+  double sind = sino * cost - coso * sint;
+  double lateralDeviation = (yv - yp) * cost - (xv - xp) * sint;
+
+  if (desiredSpeed < 0 ? cosd < 0 : cosd > 0) {
+    // Singularity
+    if (
+      (std::abs(curvature) > 10e-6) && (std::abs(lateralDeviation - (1 / curvature)) <= 10e-6)) {
+      curvature = 0;
+    }
+
+    double tangent = std::atan2(sint, cost);
+
+    romea::core::PathMatchedPoint2D matchedPoint;
+    matchedPoint.pathPosture.position.x() = xp;
+    matchedPoint.pathPosture.position.y() = yp;
+    matchedPoint.pathPosture.course = tangent;
+    matchedPoint.pathPosture.curvature = curvature;
+    matchedPoint.frenetPose.curvilinearAbscissa = curvilinearAbscissa;
+    matchedPoint.frenetPose.lateralDeviation = lateralDeviation;
+    matchedPoint.frenetPose.courseDeviation = romea::core::betweenMinusPiAndPi(o - tangent);
+
+    // the covariance is left null when the caller does not use it
+    if (propagateCovariance) {
+      Eigen::Matrix3d J = Eigen::Matrix3d::Identity();
+      J.block<2, 2>(0, 0) << cosd, -sind, sind, cosd;
+      matchedPoint.frenetPose.covariance = J * vehiclePose.covariance * J.transpose();
+    }
+    return matchedPoint;
+  }
+
+  return {};
+}
+
+//-----------------------------------------------------------------------------
+// Geometry of the sections storing one PathCurve2D per way point
+template<typename Section>
+std::optional<romea::core::PathMatchedPoint2D> matchNearestCurve(
+  const Section & section,
+  const size_t & nearestCurveIndex,
+  const romea::core::Pose2D & vehiclePose,
+  const double & desiredSpeed,
+  bool propagateCovariance)
+{
+  const romea::core::PathCurve2D * curve;
+  {
+    ROMEA_PATH_TIME_SCOPE(CURVE_LOOKUP);
+    curve = &section.getCurve(nearestCurveIndex);
+  }
+
+  ROMEA_PATH_TIME_SCOPE(ROOT_SOLVE);
+  return match(*curve, vehiclePose, desiredSpeed, propagateCovariance);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Section>
+romea::core::Interval<size_t> nearestCurveIndexRange(
+  const Section & section,
+  const size_t & nearestCurveIndex)
+{
+  return section.getCurve(nearestCurveIndex).getIndexInterval();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Section>
+double computeCurvature(
+  const Section & section,
+  const size_t & curveIndex,
+  const double & curvilinearAbscissa)
+{
+  return section.getCurve(curveIndex).computeCurvature(curvilinearAbscissa);
+}
+
+//-----------------------------------------------------------------------------
+// Geometry of the spline section, the way point index is used as segment hint
+std::optional<romea::core::PathMatchedPoint2D> matchNearestCurve(
+  const romea::core::PathSplineSection2D & section,
+  const size_t & nearestCurveIndex,
+  const romea::core::Pose2D & vehiclePose,
+  const double & desiredSpeed,
+  bool propagateCovariance)
+{
+  const romea::core::PathSpline2D * spline;
+  {
+    ROMEA_PATH_TIME_SCOPE(CURVE_LOOKUP);
+    spline = &section.getSpline();
+  }
+
+  ROMEA_PATH_TIME_SCOPE(ROOT_SOLVE);
+  if (spline->size() == 0) {
+    return {};
+  }
+
+  // the projection lies on one of the segments around the nearest way point
+  size_t lower = nearestCurveIndex > 1 ? nearestCurveIndex - 2 : 0;
+  auto s = spline->findNearestCurvilinearAbscissa(
+    vehiclePose.position, romea::core::Interval<size_t>(lower, nearestCurveIndex + 1));
+
+  if (!s.has_value()) {
+    return {};
+  }
+
+  size_t segmentIndex = spline->findSegmentIndex(*s, nearestCurveIndex);
+  Eigen::Vector2d position = spline->computePosition(*s, segmentIndex);
+  return makeMatchedPoint(
+    *s,
+    position.x(),
+    position.y(),
+    spline->computeDirection(*s, segmentIndex),
+    spline->computeCurvature(*s, segmentIndex),
+    vehiclePose,
+    desiredSpeed,
+    propagateCovariance);
+}
+
+//-----------------------------------------------------------------------------
+romea::core::Interval<size_t> nearestCurveIndexRange(
+  const romea::core::PathSplineSection2D & section,
+  const size_t & nearestCurveIndex)
+{
+  size_t lower = nearestCurveIndex > 1 ? nearestCurveIndex - 2 : 0;
+  size_t upper = std::min(nearestCurveIndex + 2, section.size() - 1);
+  return {lower, upper};
+}
+
+//-----------------------------------------------------------------------------
+double computeCurvature(
+  const romea::core::PathSplineSection2D & section,
+  const size_t & curveIndex,
+  const double & curvilinearAbscissa)
+{
+  const auto & spline = section.getSpline();
+  size_t segmentIndex = spline.findSegmentIndex(curvilinearAbscissa, curveIndex);
+  return spline.computeCurvature(curvilinearAbscissa, segmentIndex);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Section>
 size_t findNearestCurveIndex(
-  const romea::core::PathSection2D & section,
+  const Section & section,
   const Eigen::Vector2d & vehiclePosition,
   const romea::core::Interval<size_t> indexRange,
   const double & researchRadius)
 {
   assert(indexRange.upper() < section.size());
 
-  const auto & X = section.getX();
-  const auto & Y = section.getY();
-
   size_t nearestPointIndex = section.size();
   double minSqDist = researchRadius * researchRadius;
 
   for (size_t n = indexRange.lower(); n <= indexRange.upper(); ++n) {
-    double sqDist = (vehiclePosition - Eigen::Vector2d(X[n], Y[n])).squaredNorm();
+    double sqDist = (vehiclePosition - pointPosition(section, n)).squaredNorm();
 
     if (sqDist < minSqDist) {
       minSqDist = sqDist;
@@ -60,17 +297,15 @@ size_t findNearestCurveIndex(
 /// The point orientation is computed using the direction to the next point.
 /// This function rejects all the points that do not match the pose orientation.
 /// If the speed is negative, it will match only if the pose orientation is the opposite.
+template<typename Section>
 size_t findNearestOrientedCurveIndex(
-  const romea::core::PathSection2D & section,
+  const Section & section,
   const romea::core::Pose2D & pose,
   const romea::core::Interval<size_t> indexRange,
   double researchRadius)
 {
   assert(indexRange.upper() < section.size());
 
-  const auto & x = section.getX();
-  const auto & y = section.getY();
-  const auto & speeds = section.getSpeeds();
   Eigen::Vector2d dir{std::cos(pose.yaw), std::sin(pose.yaw)};
 
   size_t nearestPointIndex = section.size();
@@ -81,19 +316,20 @@ size_t findNearestOrientedCurveIndex(
     return nearestPointIndex;
   }
 
-  Eigen::Vector2d curSectionDir;
+  ROMEA_PATH_COUNT(POINTS_SCANNED, indexRange.width() + 1);
+
   for (size_t n = indexRange.lower(); n <= indexRange.upper(); ++n) {
-    Eigen::Vector2d point{x[n], y[n]};
+    Eigen::Vector2d point = pointPosition(section, n);
     double sqDist = (pose.position - point).squaredNorm();
 
     if (sqDist < minSqDist) {
-      // this condition keeps the same direction than the previous one for the last point
-      if (n < indexRange.upper()) {
-        curSectionDir = Eigen::Vector2d{x[n + 1], y[n + 1]} - point;
-      }
+      // the last point keeps the same direction than the previous one
+      Eigen::Vector2d curSectionDir = n < indexRange.upper() ?
+        Eigen::Vector2d(pointPosition(section, n + 1) - point) :
+        Eigen::Vector2d(point - pointPosition(section, n - 1));
 
       // if the pose orientation is the same as the section or the opposite if the speed is negative
-      if (std::signbit(dir.dot(curSectionDir)) == std::signbit(speeds[n])) {
+      if (std::signbit(dir.dot(curSectionDir)) == std::signbit(pointSpeed(section, n))) {
         minSqDist = sqDist;
         nearestPointIndex = n;
       }
@@ -104,54 +340,187 @@ size_t findNearestOrientedCurveIndex(
 }
 
 //-----------------------------------------------------------------------------
-std::optional<romea::core::PathMatchedPoint2D> match_impl(
+// The default section skips whole chunks of points using its segment tree
+size_t findNearestOrientedCurveIndex(
   const romea::core::PathSection2D & section,
+  const romea::core::Pose2D & pose,
+  const romea::core::Interval<size_t> indexRange,
+  double researchRadius)
+{
+  assert(indexRange.upper() < section.size());
+
+  if (indexRange.width() < 2) {
+    return section.size();
+  }
+
+  size_t numberOfVisitedPoints;
+  size_t nearestPointIndex = section.getSegmentTree().findNearestOrientedPointIndex(
+    section.getX().data(), section.getY().data(), pose, indexRange, researchRadius,
+    numberOfVisitedPoints);
+
+  ROMEA_PATH_COUNT(POINTS_SCANNED, numberOfVisitedPoints);
+  return nearestPointIndex;
+}
+
+//-----------------------------------------------------------------------------
+// Same search over the points of curvilinearAbscissaInterval, expanding outward
+// from hintIndex one point on each side at a time, so that the range bounds are
+// never searched beforehand. Like findIntervalBoundIndexes, a side stops after
+// its first point outside the interval. It also stops once the arc length from
+// the hint minus the distance between the vehicle and the hint exceeds the best
+// distance found. The chord between two way points is taken equal to their arc
+// length, which only holds when the section does not bend back on itself within
+// the interval: this is a heuristic bound, not an exact one.
+template<typename Section>
+size_t findNearestOrientedCurveIndexFromHint(
+  const Section & section,
+  const romea::core::Pose2D & pose,
+  const romea::core::Interval<double> & curvilinearAbscissaInterval,
+  const size_t & hintIndex,
+  double researchRadius)
+{
+  assert(hintIndex < section.size());
+
+  if (section.size() < 3) {
+    return section.size();
+  }
+
+  Eigen::Vector2d dir{std::cos(pose.yaw), std::sin(pose.yaw)};
+  size_t nearestPointIndex = section.size();
+  double minSqDist = researchRadius * researchRadius;
+  size_t numberOfScannedPoints = 0;
+
+  auto scan = [&](const size_t & n) {
+      ++numberOfScannedPoints;
+      double sqDist = (pose.position - pointPosition(section, n)).squaredNorm();
+      if (sqDist < minSqDist) {
+        // direction to the next point, from the previous one for the last point
+        size_t next = std::min(n + 1, section.size() - 1);
+        Eigen::Vector2d sectionDir =
+          pointPosition(section, next) - pointPosition(section, next - 1);
+        if (std::signbit(dir.dot(sectionDir)) == std::signbit(pointSpeed(section, n))) {
+          minSqDist = sqDist;
+          nearestPointIndex = n;
+        }
+      }
+    };
+
+  double hintCurvilinearAbscissa = pointCurvilinearAbscissa(section, hintIndex);
+  double hintDistance = (pose.position - pointPosition(section, hintIndex)).norm();
+
+  // scan the point and tell whether the search continues beyond it
+  auto visit = [&](const size_t & n) {
+      double s = pointCurvilinearAbscissa(section, n);
+      double bound = std::abs(s - hintCurvilinearAbscissa) - hintDistance;
+      if (bound > 0 && bound * bound > minSqDist) {
+        return false;
+      }
+      scan(n);
+      return curvilinearAbscissaInterval.inside(s);
+    };
+
+  scan(hintIndex);
+  size_t lower = hintIndex;
+  size_t upper = hintIndex;
+  bool searchLower = lower > 0;
+  bool searchUpper = upper + 1 < section.size();
+  while (searchLower || searchUpper) {
+    if (searchLower) {
+      searchLower = visit(--lower) && lower > 0;
+    }
+    if (searchUpper) {
+      searchUpper = visit(++upper) && upper + 1 < section.size();
+    }
+  }
+
+  ROMEA_PATH_COUNT(POINTS_SCANNED, numberOfScannedPoints);
+  return nearestPointIndex;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Section>
+void setFutureCurvature(
+  const Section & section,
+  const double & vehicleSpeed,
+  const double & time_horizon,
+  romea::core::PathMatchedPoint2D & matchedPoint)
+{
+  ROMEA_PATH_TIME_SCOPE(FUTURE_CURVATURE);
+  double futureCurvilinearAbscissa =
+    matchedPoint.frenetPose.curvilinearAbscissa + std::abs(vehicleSpeed) * time_horizon;
+
+  size_t futureCurveIndex =
+    section.findIndex(futureCurvilinearAbscissa, matchedPoint.curveIndex);
+
+  matchedPoint.futureCurvature =
+    computeCurvature(section, futureCurveIndex, futureCurvilinearAbscissa);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Section>
+std::optional<romea::core::PathMatchedPoint2D> matchNearestCurve_impl(
+  const Section & section,
+  const size_t & nearestCurveIndex,
   const romea::core::Pose2D & vehiclePose,
   const double & vehicleSpeed,
   const double & time_horizon,
-  const romea::core::Interval<size_t> & rangeIndex,
-  const double & researchRadius)
+  const double & researchRadius,
+  bool propagateCovariance)
 {
   std::optional<romea::core::PathMatchedPoint2D> matchedPoint;
 
-  size_t nearestCurveIndex =
-    findNearestOrientedCurveIndex(section, vehiclePose, rangeIndex, researchRadius);
-
   if (nearestCurveIndex != section.size()) {
-    const auto & curve = section.getCurve(nearestCurveIndex);
-    double pathSpeed = section.getSpeeds()[nearestCurveIndex];
-    matchedPoint = match(curve, vehiclePose, pathSpeed);
+    double pathSpeed = pointSpeed(section, nearestCurveIndex);
+    matchedPoint = matchNearestCurve(
+      section, nearestCurveIndex, vehiclePose, pathSpeed, propagateCovariance);
   }
 
   if (matchedPoint.has_value()) {
     matchedPoint->curveIndex = findNearestCurveIndex(
       section,
       matchedPoint->pathPosture.position,
-      section.getCurve(nearestCurveIndex).getIndexInterval(),
+      nearestCurveIndexRange(section, nearestCurveIndex),
       researchRadius);
 
-    matchedPoint->desiredSpeed = section.getSpeeds()[matchedPoint->curveIndex];
-
-    double futureCurvilinearAbscissa =
-      matchedPoint->frenetPose.curvilinearAbscissa + std::abs(vehicleSpeed) * time_horizon;
+    matchedPoint->desiredSpeed = pointSpeed(section, matchedPoint->curveIndex);
+    setFutureCurvature(section, vehicleSpeed, time_horizon, *matchedPoint);
+  }
 
-    size_t futureCurveIndex =
-      section.findIndex(futureCurvilinearAbscissa, matchedPoint->curveIndex);
+  return matchedPoint;
+}
 
-    matchedPoint->futureCurvature =
-      section.getCurve(futureCurveIndex).computeCurvature(futureCurvilinearAbscissa);
+//-----------------------------------------------------------------------------
+template<typename Section>
+std::optional<romea::core::PathMatchedPoint2D> match_impl(
+  const Section & section,
+  const romea::core::Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const double & time_horizon,
+  const romea::core::Interval<size_t> & rangeIndex,
+  const double & researchRadius,
+  bool propagateCovariance)
+{
+  size_t nearestCurveIndex;
+  {
+    ROMEA_PATH_TIME_SCOPE(CANDIDATE_SEARCH);
+    nearestCurveIndex =
+      findNearestOrientedCurveIndex(section, vehiclePose, rangeIndex, researchRadius);
   }
 
-  return matchedPoint;
+  return matchNearestCurve_impl(
+    section, nearestCurveIndex, vehiclePose, vehicleSpeed, time_horizon, researchRadius,
+    propagateCovariance);
 }
 
 //-----------------------------------------------------------------------------
+template<typename Section>
 std::optional<romea::core::PathMatchedPoint2D> match_impl(
-  const romea::core::PathSection2D & section,
+  const Section & section,
   const romea::core::Pose2D & vehiclePose,
   const double & vehicleSpeed,
   const double & time_horizon,
-  const double & researchRadius)
+  const double & researchRadius,
+  bool propagateCovariance)
 {
   return match_impl(
     section,
@@ -159,7 +528,136 @@ std::optional<romea::core::PathMatchedPoint2D> match_impl(
     vehicleSpeed,
     time_horizon,
     romea::core::Interval<size_t>(0, section.size() - 1),
-    researchRadius);
+    researchRadius,
+    propagateCovariance);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Section>
+std::optional<romea::core::PathMatchedPoint2D> match_impl(
+  const Section & section,
+  const romea::core::Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const size_t & previousCurveIndex,
+  const romea::core::Interval<double> & curvilinearAbscissaInterval,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance,
+  bool outwardSearch = false)
+{
+  if (outwardSearch) {
+    size_t nearestCurveIndex;
+    {
+      ROMEA_PATH_TIME_SCOPE(CANDIDATE_SEARCH);
+      nearestCurveIndex = findNearestOrientedCurveIndexFromHint(
+        section, vehiclePose, curvilinearAbscissaInterval, previousCurveIndex, researchRadius);
+    }
+
+    return matchNearestCurve_impl(
+      section, nearestCurveIndex, vehiclePose, vehicleSpeed, time_horizon, researchRadius,
+      propagateCovariance);
+  }
+
+  romea::core::Interval<size_t> rangeIndex =
+    section.findIntervalBoundIndexes(previousCurveIndex, curvilinearAbscissaInterval);
+
+  return match_impl(
+    section, vehiclePose, vehicleSpeed, time_horizon, rangeIndex, researchRadius,
+    propagateCovariance);
+}
+
+//-----------------------------------------------------------------------------
+// Way point whose abscissa is the closest to s, walking from a nearby index
+size_t findNearestAbscissaIndex(
+  const romea::core::PathSection2D & section,
+  const double & curvilinearAbscissa,
+  size_t index)
+{
+  const auto & S = section.getCurvilinearAbscissa();
+  auto distance = [&](size_t n) {return std::abs(S[n] - curvilinearAbscissa);};
+
+  while (index + 1 < section.size() && distance(index + 1) < distance(index)) {
+    ++index;
+  }
+  while (index > 0 && distance(index - 1) < distance(index)) {
+    --index;
+  }
+  return index;
+}
+
+//-----------------------------------------------------------------------------
+std::optional<romea::core::PathMatchedPoint2D> warmStartedMatch_impl(
+  const romea::core::PathSection2D & section,
+  const romea::core::Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const romea::core::PathMatchedPoint2D & previousMatchedPoint,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance)
+{
+  constexpr size_t MAXIMAL_NUMBER_OF_CURVE_CHANGES = 3;
+
+  size_t curveIndex = previousMatchedPoint.curveIndex;
+  double s = previousMatchedPoint.frenetPose.curvilinearAbscissa;
+  if (curveIndex >= section.size()) {
+    return {};
+  }
+
+  for (size_t n = 0; n <= MAXIMAL_NUMBER_OF_CURVE_CHANGES; ++n) {
+    const romea::core::PathCurve2D * curve;
+    {
+      ROMEA_PATH_TIME_SCOPE(CURVE_LOOKUP);
+      curve = &section.getCurve(curveIndex);
+    }
+
+    std::optional<double> refinedCurvilinearAbscissa;
+    {
+      ROMEA_PATH_TIME_SCOPE(ROOT_SOLVE);
+      refinedCurvilinearAbscissa = curve->refineNearestCurvilinearAbscissa(
+        vehiclePose.position, s);
+    }
+    if (!refinedCurvilinearAbscissa.has_value()) {
+      return {};
+    }
+    s = *refinedCurvilinearAbscissa;
+
+    // the solution belongs to the curve of another way point, the Newton steps
+    // are restarted on this neighbouring curve
+    size_t nearestCurveIndex = findNearestAbscissaIndex(section, s, curveIndex);
+    if (nearestCurveIndex != curveIndex) {
+      curveIndex = nearestCurveIndex;
+      continue;
+    }
+
+    // the vehicle has left the section
+    if (!curve->getCurvilinearAbscissaInterval().inside(s)) {
+      return {};
+    }
+
+    double desiredSpeed = pointSpeed(section, curveIndex);
+    auto matchedPoint = makeMatchedPoint(
+      s,
+      curve->computeX(s),
+      curve->computeY(s),
+      curve->computeDirection(s),
+      curve->computeCurvature(s),
+      vehiclePose,
+      desiredSpeed,
+      propagateCovariance);
+
+    if (!matchedPoint.has_value() ||
+      std::abs(matchedPoint->frenetPose.lateralDeviation) > researchRadius)
+    {
+      return {};
+    }
+
+    matchedPoint->curveIndex = curveIndex;
+    matchedPoint->desiredSpeed = desiredSpeed;
+    setFutureCurvature(section, vehicleSpeed, time_horizon, *matchedPoint);
+    return matchedPoint;
+  }
+
+  return {};
 }
 
 }  // namespace
@@ -176,9 +674,11 @@ std::optional<PathMatchedPoint2D> match(
   const Pose2D & vehiclePose,
   const double & vehicleSpeed,
   const double & time_horizon,
-  const double & researchRadius)
+  const double & researchRadius,
+  bool propagateCovariance)
 {
-  return match_impl(section, vehiclePose, vehicleSpeed, time_horizon, researchRadius);
+  return match_impl(
+    section, vehiclePose, vehicleSpeed, time_horizon, researchRadius, propagateCovariance);
 }
 
 //-----------------------------------------------------------------------------
@@ -189,7 +689,8 @@ std::optional<PathMatchedPoint2D> match(
   const PathMatchedPoint2D & previousMatchedPoint,
   const double & expectedTravelledDistance,
   const double & time_horizon,
-  const double & researchRadius)
+  const double & researchRadius,
+  bool propagateCovariance)
 {
   double s = previousMatchedPoint.frenetPose.curvilinearAbscissa;
   double mins = s - expectedTravelledDistance / 2.;
@@ -202,7 +703,8 @@ std::optional<PathMatchedPoint2D> match(
     previousMatchedPoint.curveIndex,
     Interval<double>(mins, maxs),
     time_horizon,
-    researchRadius);
+    researchRadius,
+    propagateCovariance);
 }
 
 //-----------------------------------------------------------------------------
@@ -213,67 +715,199 @@ std::optional<PathMatchedPoint2D> match(
   const size_t & previousCurveIndex,
   const Interval<double> & curvilinearAbscissaInterval,
   const double & time_horizon,
-  const double & researchRadius)
+  const double & researchRadius,
+  bool propagateCovariance,
+  bool outwardSearch)
 {
-  Interval<size_t> rangeIndex =
-    section.findIntervalBoundIndexes(previousCurveIndex, curvilinearAbscissaInterval);
+  return match_impl(
+    section,
+    vehiclePose,
+    vehicleSpeed,
+    previousCurveIndex,
+    curvilinearAbscissaInterval,
+    time_horizon,
+    researchRadius,
+    propagateCovariance,
+    outwardSearch);
+}
+
+//-----------------------------------------------------------------------------
+std::optional<PathMatchedPoint2D> match(
+  const PathInterleavedSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance)
+{
+  return match_impl(
+    section, vehiclePose, vehicleSpeed, time_horizon, researchRadius, propagateCovariance);
+}
+
+//-----------------------------------------------------------------------------
+std::optional<PathMatchedPoint2D> match(
+  const PathInterleavedSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const PathMatchedPoint2D & previousMatchedPoint,
+  const double & expectedTravelledDistance,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance)
+{
+  double s = previousMatchedPoint.frenetPose.curvilinearAbscissa;
+  double mins = s - expectedTravelledDistance / 2.;
+  double maxs = s + expectedTravelledDistance / 2.;
+
+  return match_impl(
+    section,
+    vehiclePose,
+    vehicleSpeed,
+    previousMatchedPoint.curveIndex,
+    Interval<double>(mins, maxs),
+    time_horizon,
+    researchRadius,
+    propagateCovariance);
+}
+
+//-----------------------------------------------------------------------------
+std::optional<PathMatchedPoint2D> match(
+  const PathCompactSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance)
+{
+  return match_impl(
+    section, vehiclePose, vehicleSpeed, time_horizon, researchRadius, propagateCovariance);
+}
+
+//-----------------------------------------------------------------------------
+std::optional<PathMatchedPoint2D> match(
+  const PathCompactSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const PathMatchedPoint2D & previousMatchedPoint,
+  const double & expectedTravelledDistance,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance)
+{
+  double s = previousMatchedPoint.frenetPose.curvilinearAbscissa;
+  double mins = s - expectedTravelledDistance / 2.;
+  double maxs = s + expectedTravelledDistance / 2.;
+
+  return match_impl(
+    section,
+    vehiclePose,
+    vehicleSpeed,
+    previousMatchedPoint.curveIndex,
+    Interval<double>(mins, maxs),
+    time_horizon,
+    researchRadius,
+    propagateCovariance);
+}
+
+//-----------------------------------------------------------------------------
+std::optional<PathMatchedPoint2D> match(
+  const PathSplineSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance)
+{
+  return match_impl(
+    section, vehiclePose, vehicleSpeed, time_horizon, researchRadius, propagateCovariance);
+}
+
+//-----------------------------------------------------------------------------
+std::optional<PathMatchedPoint2D> match(
+  const PathSplineSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const PathMatchedPoint2D & previousMatchedPoint,
+  const double & expectedTravelledDistance,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance)
+{
+  double s = previousMatchedPoint.frenetPose.curvilinearAbscissa;
+  double mins = s - expectedTravelledDistance / 2.;
+  double maxs = s + expectedTravelledDistance / 2.;
 
-  return match_impl(section, vehiclePose, vehicleSpeed, time_horizon, rangeIndex, researchRadius);
+  return match_impl(
+    section,
+    vehiclePose,
+    vehicleSpeed,
+    previousMatchedPoint.curveIndex,
+    Interval<double>(mins, maxs),
+    time_horizon,
+    researchRadius,
+    propagateCovariance);
+}
+
+//-----------------------------------------------------------------------------
+std::optional<PathMatchedPoint2D> warmStartedMatch(
+  const PathSection2D & section,
+  const Pose2D & vehiclePose,
+  const double & vehicleSpeed,
+  const PathMatchedPoint2D & previousMatchedPoint,
+  const double & time_horizon,
+  const double & researchRadius,
+  bool propagateCovariance)
+{
+  return warmStartedMatch_impl(
+    section,
+    vehiclePose,
+    vehicleSpeed,
+    previousMatchedPoint,
+    time_horizon,
+    researchRadius,
+    propagateCovariance);
 }
 
 //-----------------------------------------------------------------------------
 std::optional<PathMatchedPoint2D> match(
-  const PathCurve2D & curve, const Pose2D & vehiclePose, const double & desiredSpeed)
+  const PathCurve2D & curve,
+  const Pose2D & vehiclePose,
+  const double & desiredSpeed,
+  bool propagateCovariance)
 {
   // std::cout << " search nearest curvilinear abscissa " << std::endl;
   auto nearestCurvilinearAbscissa = curve.findNearestCurvilinearAbscissa(vehiclePose.position);
 
   if (nearestCurvilinearAbscissa.has_value()) {
     // std::cout << " has nearest curvilinear abscissa" << std::endl;
-    double xp = curve.computeX(nearestCurvilinearAbscissa.value());
-    double yp = curve.computeY(nearestCurvilinearAbscissa.value());
-    double tangent = curve.computeTangent(nearestCurvilinearAbscissa.value());
-    double curvature = curve.computeCurvature(nearestCurvilinearAbscissa.value());
-
-    const double & xv = vehiclePose.position.x();
-    const double & yv = vehiclePose.position.y();
-    const double & o = vehiclePose.yaw;
-    const double & cost = std::cos(tangent);
-    const double & sint = std::sin(tangent);
-
-    double courseDeviation = betweenMinusPiAndPi(o - tangent);
-    double lateralDeviation = (yv - yp) * cost - (xv - xp) * sint;
-
-    double tangentOffset = desiredSpeed < 0 ? M_PI : 0;
-    if (std::abs(betweenMinusPiAndPi(courseDeviation + tangentOffset)) < M_PI_2) {
-      Eigen::Matrix3d J = Eigen::Matrix3d::Identity();
-      J.block<2, 2>(0, 0) = eulerAngleToRotation2D(courseDeviation);
-      Eigen::Matrix3d frenetPoseCovariance = J * vehiclePose.covariance * J.transpose();
+    return makeMatchedPoint(
+      nearestCurvilinearAbscissa.value(),
+      curve.computeX(nearestCurvilinearAbscissa.value()),
+      curve.computeY(nearestCurvilinearAbscissa.value()),
+      curve.computeDirection(nearestCurvilinearAbscissa.value()),
+      curve.computeCurvature(nearestCurvilinearAbscissa.value()),
+      vehiclePose,
+      desiredSpeed,
+      propagateCovariance);
+  }
 
-      // Singularity
-      if (
-        (std::abs(curvature) > 10e-6) && (std::abs(lateralDeviation - (1 / curvature)) <= 10e-6)) {
-        curvature = 0;
-      }
+  return {};
+}
 
-      PathMatchedPoint2D matchedPoint;
-      matchedPoint.pathPosture.position.x() = xp;
-      matchedPoint.pathPosture.position.y() = yp;
-      matchedPoint.pathPosture.course = tangent;
-      matchedPoint.pathPosture.curvature = curvature;
-      matchedPoint.frenetPose.curvilinearAbscissa = nearestCurvilinearAbscissa.value();
-      matchedPoint.frenetPose.lateralDeviation = lateralDeviation;
-      matchedPoint.frenetPose.courseDeviation = courseDeviation;
-      matchedPoint.frenetPose.covariance = frenetPoseCovariance;
-      return matchedPoint;
-    }
-    //    else
-    //    {
-    //      std::cout <<" cap rejection "<< std::endl;
-    //    }
+//-----------------------------------------------------------------------------
+bool match(
+  const PathCurve2D & curve,
+  const Pose2D & vehiclePose,
+  const double & desiredSpeed,
+  PathCompactFrenetPose2D & frenetPose)
+{
+  auto matchedPoint = match(curve, vehiclePose, desiredSpeed, false);
+  if (!matchedPoint.has_value()) {
+    return false;
   }
 
-  return {};
+  frenetPose = PathCompactFrenetPose2D(matchedPoint->frenetPose);
+  return true;
 }
 
 }  // namespace core
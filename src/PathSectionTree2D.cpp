@@ -0,0 +1,137 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// romea
+#include "romea_core_path/PathSectionTree2D.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+PathSectionTree2D::PathSectionTree2D()
+: boxes_(),
+  order_(),
+  nodes_()
+{
+}
+
+//-----------------------------------------------------------------------------
+PathSectionTree2D::PathSectionTree2D(const Boxes & sectionBoxes)
+: boxes_(sectionBoxes),
+  order_(sectionBoxes.size()),
+  nodes_()
+{
+  std::iota(order_.begin(), order_.end(), 0);
+  if (!boxes_.empty()) {
+    nodes_.reserve(2 * boxes_.size() / MAXIMAL_LEAF_SIZE + 1);
+    build_(0, boxes_.size());
+  }
+}
+
+//-----------------------------------------------------------------------------
+size_t PathSectionTree2D::build_(const size_t & first, const size_t & last)
+{
+  size_t nodeIndex = nodes_.size();
+  nodes_.emplace_back();
+
+  Eigen::AlignedBox2d box;
+  Eigen::AlignedBox2d centers;
+  for (size_t n = first; n < last; ++n) {
+    box.extend(boxes_[order_[n]]);
+    if (!boxes_[order_[n]].isEmpty()) {
+      centers.extend(boxes_[order_[n]].center());
+    }
+  }
+
+  if (last - first <= MAXIMAL_LEAF_SIZE) {
+    nodes_[nodeIndex] = {box, first, last - first, 0};
+    return nodeIndex;
+  }
+
+  int axis = 0;
+  if (!centers.isEmpty()) {
+    centers.sizes().maxCoeff(&axis);
+  }
+
+  size_t middle = first + (last - first) / 2;
+  std::nth_element(
+    order_.begin() + first, order_.begin() + middle, order_.begin() + last,
+    [&](const size_t & a, const size_t & b) {
+      // empty sections have no center, they are sent to the end
+      if (boxes_[a].isEmpty() || boxes_[b].isEmpty()) {
+        return !boxes_[a].isEmpty() && boxes_[b].isEmpty();
+      }
+      return boxes_[a].center()[axis] < boxes_[b].center()[axis];
+    });
+
+  build_(first, middle);
+  size_t right = build_(middle, last);
+  nodes_[nodeIndex] = {box, first, 0, right};
+  return nodeIndex;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathSectionTree2D::size()const
+{
+  return boxes_.size();
+}
+
+//-----------------------------------------------------------------------------
+void PathSectionTree2D::findSections(
+  const Eigen::Vector2d & position,
+  const double & researchRadius,
+  std::vector<size_t> & sectionIndexes)const
+{
+  sectionIndexes.clear();
+  if (nodes_.empty()) {
+    return;
+  }
+
+  double sqRadius = researchRadius * researchRadius;
+  size_t stack[64];
+  size_t stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize != 0) {
+    const Node & node = nodes_[stack[--stackSize]];
+    if (node.box.squaredExteriorDistance(position) >= sqRadius) {
+      continue;
+    }
+
+    if (node.count != 0) {
+      for (size_t n = node.first; n < node.first + node.count; ++n) {
+        if (boxes_[order_[n]].squaredExteriorDistance(position) < sqRadius) {
+          sectionIndexes.push_back(order_[n]);
+        }
+      }
+    } else {
+      size_t left = static_cast<size_t>(&node - nodes_.data()) + 1;
+      stack[stackSize++] = node.right;
+      stack[stackSize++] = left;
+    }
+  }
+
+  std::sort(sectionIndexes.begin(), sectionIndexes.end());
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,379 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_path/PathSerialization.hpp"
+
+// json
+#include "nlohmann/json.hpp"
+
+namespace
+{
+
+// The blob is a cache written and read on the same machine, values are stored
+// with the native byte order
+constexpr std::array<char, 8> MAGIC = {'R', 'O', 'M', 'E', 'A', 'P', 'T', 'H'};
+constexpr std::uint32_t VERSION = 2;
+
+// Blocks are read by chunks so that a corrupted size fails on the end of the
+// stream instead of allocating a huge buffer
+constexpr size_t READ_CHUNK_SIZE = 1 << 16;
+constexpr std::uint64_t MAXIMAL_STRING_SIZE = 1 << 20;
+
+//-----------------------------------------------------------------------------
+class Fnv1aHash
+{
+public:
+  void add(const void * data, size_t size)
+  {
+    auto bytes = static_cast<const unsigned char *>(data);
+    for (size_t n = 0; n < size; ++n) {
+      value_ = (value_ ^ bytes[n]) * 1099511628211ULL;
+    }
+  }
+
+  template<typename T>
+  void add(const T & value)
+  {
+    static_assert(std::is_trivially_copyable<T>::value);
+    add(&value, sizeof(T));
+  }
+
+  void add(const std::string & value)
+  {
+    add(value.size());
+    add(value.data(), value.size());
+  }
+
+  std::uint64_t value() const {return value_;}
+
+private:
+  std::uint64_t value_ = 14695981039346656037ULL;
+};
+
+//-----------------------------------------------------------------------------
+template<typename T>
+void write(std::ostream & os, const T & value)
+{
+  static_assert(std::is_trivially_copyable<T>::value);
+  os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+//-----------------------------------------------------------------------------
+void write(std::ostream & os, const std::string & value)
+{
+  write<std::uint64_t>(os, value.size());
+  os.write(value.data(), value.size());
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+bool read(std::istream & is, T & value)
+{
+  static_assert(std::is_trivially_copyable<T>::value);
+  return static_cast<bool>(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+//-----------------------------------------------------------------------------
+bool read(std::istream & is, std::string & value)
+{
+  std::uint64_t size;
+  if (!read(is, size) || size > MAXIMAL_STRING_SIZE) {
+    return false;
+  }
+  value.resize(size);
+  return static_cast<bool>(is.read(value.data(), size));
+}
+
+// Way points and curves are written as contiguous blocks of these records so
+// that a section is read back with a single call per block
+struct WayPointRecord
+{
+  double x;
+  double y;
+  double speed;
+};
+
+struct CurveRecord
+{
+  double fxPolynomCoefficient[4];
+  double fyPolynomCoefficient[4];
+  std::uint64_t polynomialDegree;
+  double origin[2];
+  double originCurvilinearAbscissa;
+  std::uint64_t indexInterval[2];
+  double curvilinearAbscissaInterval[2];
+};
+
+//-----------------------------------------------------------------------------
+template<typename T>
+void writeBlock(std::ostream & os, const std::vector<T> & records)
+{
+  static_assert(std::is_trivially_copyable<T>::value);
+  os.write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(T));
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+bool readBlock(std::istream & is, std::vector<T> & records, const size_t & size)
+{
+  static_assert(std::is_trivially_copyable<T>::value);
+  records.clear();
+  while (records.size() < size) {
+    size_t offset = records.size();
+    size_t count = std::min(size - offset, READ_CHUNK_SIZE);
+    records.resize(offset + count);
+    if (!is.read(reinterpret_cast<char *>(records.data() + offset), count * sizeof(T))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool isValidPolynomialDegree(const std::uint64_t & polynomialDegree)
+{
+  return polynomialDegree == 2 || polynomialDegree == 3;
+}
+
+//-----------------------------------------------------------------------------
+// A foreign blob whose hash happens to match must not build curves that could
+// not have been fitted on the section
+bool isValid(const CurveRecord & record, const size_t & numberOfWayPoints)
+{
+  return isValidPolynomialDegree(record.polynomialDegree) &&
+    record.indexInterval[0] <= record.indexInterval[1] &&
+    record.indexInterval[1] < numberOfWayPoints;
+}
+
+//-----------------------------------------------------------------------------
+CurveRecord toRecord(const romea::core::PathCurve2D & curve)
+{
+  const auto & fx = curve.getXPolynomCoefficients();
+  const auto & fy = curve.getYPolynomCoefficients();
+  return {
+    {fx[0], fx[1], fx[2], fx[3]},
+    {fy[0], fy[1], fy[2], fy[3]},
+    curve.getPolynomialDegree(),
+    {curve.getOrigin().x(), curve.getOrigin().y()},
+    curve.getOriginCurvilinearAbscissa(),
+    {curve.getIndexInterval().lower(), curve.getIndexInterval().upper()},
+    {curve.getCurvilinearAbscissaInterval().lower(),
+      curve.getCurvilinearAbscissaInterval().upper()}};
+}
+
+//-----------------------------------------------------------------------------
+romea::core::PathCurve2D fromRecord(const CurveRecord & record)
+{
+  return romea::core::PathCurve2D(
+    romea::core::PathCurve2D::PolynomCoefficients::Map(record.fxPolynomCoefficient),
+    romea::core::PathCurve2D::PolynomCoefficients::Map(record.fyPolynomCoefficient),
+    record.polynomialDegree,
+    Eigen::Vector2d::Map(record.origin),
+    record.originCurvilinearAbscissa,
+    romea::core::Interval<size_t>(record.indexInterval[0], record.indexInterval[1]),
+    romea::core::Interval<double>(
+      record.curvilinearAbscissaInterval[0], record.curvilinearAbscissaInterval[1]));
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+std::uint64_t computePathHash(
+  const Path2D::WayPoints & wayPoints,
+  const double & interpolationWindowLength,
+  const Path2D::Annotations & annotations,
+  const size_t & polynomialDegree)
+{
+  Fnv1aHash hash;
+  hash.add(VERSION);
+  hash.add(interpolationWindowLength);
+  hash.add(polynomialDegree);
+
+  hash.add(wayPoints.size());
+  for (const auto & sectionWayPoints : wayPoints) {
+    hash.add(sectionWayPoints.size());
+    for (const auto & wayPoint : sectionWayPoints) {
+      hash.add(wayPoint.position.x());
+      hash.add(wayPoint.position.y());
+      hash.add(wayPoint.desired_speed);
+    }
+  }
+
+  hash.add(annotations.size());
+  for (const auto & [index, annotation] : annotations) {
+    hash.add(index);
+    hash.add(annotation.type);
+    hash.add(annotation.value);
+  }
+
+  return hash.value();
+}
+
+//-----------------------------------------------------------------------------
+void savePath(
+  std::ostream & os,
+  const Path2D & path,
+  const std::uint64_t & hash)
+{
+  write(os, MAGIC);
+  write(os, VERSION);
+  write(os, hash);
+  write(os, path.getInterpolationWindowLength());
+  write<std::uint64_t>(os, path.getPolynomialDegree());
+
+  write<std::uint64_t>(os, path.size());
+  std::vector<WayPointRecord> wayPoints;
+  std::vector<CurveRecord> curves;
+  for (const auto & section : path.getSections()) {
+    wayPoints.resize(section.size());
+    curves.resize(section.size());
+    for (size_t n = 0; n < section.size(); ++n) {
+      wayPoints[n] = {section.getX()[n], section.getY()[n], section.getSpeeds()[n]};
+      curves[n] = toRecord(section.getCurve(n));
+    }
+
+    write<std::uint64_t>(os, section.size());
+    writeBlock(os, wayPoints);
+    writeBlock(os, curves);
+  }
+
+  write<std::uint64_t>(os, path.getAnnotations().size());
+  for (const auto & [index, annotation] : path.getAnnotations()) {
+    write<std::uint64_t>(os, index);
+    write(os, annotation.type);
+    write(os, annotation.value);
+  }
+}
+
+//-----------------------------------------------------------------------------
+std::optional<Path2D> loadPath(
+  std::istream & is,
+  const std::uint64_t & expectedHash)
+{
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint64_t hash;
+  double interpolationWindowLength;
+  std::uint64_t polynomialDegree;
+  std::uint64_t numberOfSections;
+
+  if (!read(is, magic) || magic != MAGIC ||
+    !read(is, version) || version != VERSION ||
+    !read(is, hash) || hash != expectedHash ||
+    !read(is, interpolationWindowLength) ||
+    !read(is, polynomialDegree) || !isValidPolynomialDegree(polynomialDegree) ||
+    !read(is, numberOfSections))
+  {
+    return std::nullopt;
+  }
+
+  Path2D::WayPoints wayPoints;
+  Path2D::Curves curves;
+  std::vector<WayPointRecord> wayPointRecords;
+  std::vector<CurveRecord> curveRecords;
+  for (size_t i = 0; i < numberOfSections; ++i) {
+    std::uint64_t numberOfWayPoints;
+    if (!read(is, numberOfWayPoints) ||
+      !readBlock(is, wayPointRecords, numberOfWayPoints) ||
+      !readBlock(is, curveRecords, numberOfWayPoints))
+    {
+      return std::nullopt;
+    }
+
+    for (const auto & record : curveRecords) {
+      if (!isValid(record, numberOfWayPoints)) {
+        return std::nullopt;
+      }
+    }
+
+    wayPoints.emplace_back();
+    curves.emplace_back();
+    wayPoints[i].reserve(numberOfWayPoints);
+    curves[i].reserve(numberOfWayPoints);
+    for (size_t n = 0; n < numberOfWayPoints; ++n) {
+      const auto & record = wayPointRecords[n];
+      wayPoints[i].emplace_back(Eigen::Vector2d(record.x, record.y), record.speed);
+      curves[i].push_back(fromRecord(curveRecords[n]));
+    }
+  }
+
+  std::uint64_t numberOfAnnotations;
+  if (!read(is, numberOfAnnotations)) {
+    return std::nullopt;
+  }
+
+  Path2D::Annotations annotations;
+  for (size_t i = 0; i < numberOfAnnotations; ++i) {
+    std::uint64_t index;
+    std::string type;
+    std::string value;
+    if (!read(is, index) || !read(is, type) || !read(is, value)) {
+      return std::nullopt;
+    }
+
+    nlohmann::json data;
+    data["type"] = type;
+    data["value"] = value;
+    data["point_index"] = index;
+    annotations.emplace(index, PathAnnotation(data));
+  }
+
+  return Path2D(wayPoints, interpolationWindowLength, annotations, curves, polynomialDegree);
+}
+
+//-----------------------------------------------------------------------------
+Path2D loadOrBuildPath(
+  const std::string & cacheFilename,
+  const Path2D::WayPoints & wayPoints,
+  const double & interpolationWindowLength,
+  const Path2D::Annotations & annotations,
+  const size_t & polynomialDegree)
+{
+  std::uint64_t hash = computePathHash(
+    wayPoints, interpolationWindowLength, annotations, polynomialDegree);
+
+  std::ifstream input(cacheFilename, std::ios::binary);
+  if (input.is_open()) {
+    if (auto path = loadPath(input, hash)) {
+      return std::move(*path);
+    }
+  }
+
+  Path2D path(wayPoints, interpolationWindowLength, annotations, polynomialDegree);
+
+  std::ofstream output(cacheFilename, std::ios::binary | std::ios::trunc);
+  if (output.is_open()) {
+    savePath(output, path, hash);
+  }
+
+  return path;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,227 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_path/PathSimplification.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+double distanceToChord(
+  const Eigen::Vector2d & position,
+  const Eigen::Vector2d & chordBegin,
+  const Eigen::Vector2d & chordEnd)
+{
+  Eigen::Vector2d chord = chordEnd - chordBegin;
+  double squaredLength = chord.squaredNorm();
+  if (squaredLength == 0) {
+    return (position - chordBegin).norm();
+  }
+
+  double t = std::clamp((position - chordBegin).dot(chord) / squaredLength, 0., 1.);
+  return (position - chordBegin - t * chord).norm();
+}
+
+//-----------------------------------------------------------------------------
+// Douglas-Peucker between two kept way points, with an explicit stack since
+// recorded sections can hold far more points than the call stack allows
+void simplify(
+  const std::vector<romea::core::PathWayPoint2D> & wayPoints,
+  const std::vector<double> & curvilinearAbscissa,
+  const romea::core::PathSimplificationParameters & parameters,
+  size_t first,
+  size_t last,
+  std::vector<bool> & kept)
+{
+  std::vector<std::pair<size_t, size_t>> stack = {{first, last}};
+  while (!stack.empty()) {
+    auto [begin, end] = stack.back();
+    stack.pop_back();
+    if (end - begin < 2) {
+      continue;
+    }
+
+    size_t farthestIndex = begin + 1;
+    double farthestDistance = 0;
+    // the speed of a removed way point is replaced by the one of begin or end, so
+    // splitting at the speed changes isolates them in a few way points
+    size_t beginSpeedChangeIndex = end;
+    size_t endSpeedChangeIndex = begin;
+    for (size_t n = begin + 1; n < end; ++n) {
+      double distance = distanceToChord(
+        wayPoints[n].position, wayPoints[begin].position, wayPoints[end].position);
+      if (distance > farthestDistance) {
+        farthestDistance = distance;
+        farthestIndex = n;
+      }
+
+      double speed = wayPoints[n].desired_speed;
+      if (beginSpeedChangeIndex == end &&
+        std::abs(speed - wayPoints[begin].desired_speed) > parameters.speedTolerance)
+      {
+        beginSpeedChangeIndex = n;
+      }
+      if (std::abs(speed - wayPoints[end].desired_speed) > parameters.speedTolerance) {
+        endSpeedChangeIndex = n;
+      }
+    }
+
+    size_t splitIndex;
+    if (farthestDistance > parameters.tolerance) {
+      splitIndex = farthestIndex;
+    } else if (beginSpeedChangeIndex < end) {
+      splitIndex = beginSpeedChangeIndex;
+    } else if (endSpeedChangeIndex > begin) {
+      splitIndex = endSpeedChangeIndex;
+    } else if (curvilinearAbscissa[end] - curvilinearAbscissa[begin] > parameters.maximalSpacing) {
+      // straight enough but too long, split at the middle abscissa
+      double middle = (curvilinearAbscissa[begin] + curvilinearAbscissa[end]) / 2.;
+      auto it = std::lower_bound(
+        curvilinearAbscissa.begin() + begin + 1, curvilinearAbscissa.begin() + end, middle);
+      splitIndex = std::min<size_t>(it - curvilinearAbscissa.begin(), end - 1);
+    } else {
+      continue;
+    }
+
+    kept[splitIndex] = true;
+    stack.emplace_back(begin, splitIndex);
+    stack.emplace_back(splitIndex, end);
+  }
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+std::vector<size_t> findSimplifiedWayPointIndexes(
+  const std::vector<PathWayPoint2D> & wayPoints,
+  const PathSimplificationParameters & parameters,
+  const std::vector<size_t> & requiredIndexes)
+{
+  std::vector<size_t> indexes;
+  if (wayPoints.empty()) {
+    return indexes;
+  }
+
+  std::vector<bool> kept(wayPoints.size(), false);
+  std::vector<double> curvilinearAbscissa(wayPoints.size(), 0.);
+  kept.front() = true;
+  kept.back() = true;
+  for (size_t n = 1; n < wayPoints.size(); ++n) {
+    curvilinearAbscissa[n] = curvilinearAbscissa[n - 1] +
+      (wayPoints[n].position - wayPoints[n - 1].position).norm();
+  }
+  for (const auto & index : requiredIndexes) {
+    if (index < wayPoints.size()) {
+      kept[index] = true;
+    }
+  }
+
+  size_t first = 0;
+  for (size_t n = 1; n < wayPoints.size(); ++n) {
+    if (kept[n]) {
+      simplify(wayPoints, curvilinearAbscissa, parameters, first, n, kept);
+      first = n;
+    }
+  }
+
+  for (size_t n = 0; n < wayPoints.size(); ++n) {
+    if (kept[n]) {
+      indexes.push_back(n);
+    }
+  }
+  return indexes;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<PathWayPoint2D> simplifyWayPoints(
+  const std::vector<PathWayPoint2D> & wayPoints,
+  const PathSimplificationParameters & parameters)
+{
+  std::vector<PathWayPoint2D> simplifiedWayPoints;
+  for (const auto & index : findSimplifiedWayPointIndexes(wayPoints, parameters)) {
+    simplifiedWayPoints.push_back(wayPoints[index]);
+  }
+  return simplifiedWayPoints;
+}
+
+//-----------------------------------------------------------------------------
+Path2D simplifyPath(
+  const Path2D::WayPoints & wayPoints,
+  const PathSimplificationParameters & parameters,
+  const double & interpolationWindowLength,
+  const Path2D::Annotations & annotations,
+  const size_t & polynomialDegree)
+{
+  Path2D::WayPoints simplifiedWayPoints;
+  simplifiedWayPoints.reserve(wayPoints.size());
+  Path2D::Annotations simplifiedAnnotations;
+
+  size_t initialPointIndex = 0;
+  size_t simplifiedInitialPointIndex = 0;
+  for (const auto & sectionWayPoints : wayPoints) {
+    auto first = annotations.lower_bound(initialPointIndex);
+    auto last = annotations.lower_bound(initialPointIndex + sectionWayPoints.size());
+
+    std::vector<size_t> requiredIndexes;
+    for (auto it = first; it != last; ++it) {
+      requiredIndexes.push_back(it->first - initialPointIndex);
+    }
+
+    auto indexes = findSimplifiedWayPointIndexes(sectionWayPoints, parameters, requiredIndexes);
+
+    simplifiedWayPoints.emplace_back();
+    simplifiedWayPoints.back().reserve(indexes.size());
+    for (const auto & index : indexes) {
+      simplifiedWayPoints.back().push_back(sectionWayPoints[index]);
+    }
+
+    // annotated way points are kept, their new index is their rank among the kept ones
+    for (auto it = first; it != last; ++it) {
+      size_t rank = std::lower_bound(
+        indexes.begin(), indexes.end(), it->first - initialPointIndex) - indexes.begin();
+      auto annotation = it->second;
+      annotation.point_index = simplifiedInitialPointIndex + rank;
+      simplifiedAnnotations.emplace(annotation.point_index, annotation);
+    }
+
+    initialPointIndex += sectionWayPoints.size();
+    simplifiedInitialPointIndex += indexes.size();
+  }
+
+  // annotations beyond the last way point keep their offset from the path end
+  for (auto it = annotations.lower_bound(initialPointIndex); it != annotations.end(); ++it) {
+    auto annotation = it->second;
+    annotation.point_index = simplifiedInitialPointIndex + it->first - initialPointIndex;
+    simplifiedAnnotations.emplace(annotation.point_index, annotation);
+  }
+
+  return Path2D(
+    simplifiedWayPoints, interpolationWindowLength, simplifiedAnnotations, polynomialDegree);
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,324 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// romea
+#include "romea_core_path/PathSpline2D.hpp"
+
+// local
+#include "PathPolynomial.hpp"
+
+namespace
+{
+
+using romea::core::detail::evaluate;
+using romea::core::detail::evaluateFirstDerivative;
+using romea::core::detail::evaluateSecondDerivative;
+using romea::core::detail::unitDirection;
+
+//-----------------------------------------------------------------------------
+inline std::array<double, 4> segmentCoefficients(
+  const double & v0,
+  const double & v1,
+  const double & m0,
+  const double & m1,
+  const double & h)
+{
+  return {v0, (v1 - v0) / h - h * (2 * m0 + m1) / 6., m0 / 2., (m1 - m0) / (6. * h)};
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+PathSpline2D::PathSpline2D()
+: knots_(),
+  segments_()
+{
+}
+
+//-----------------------------------------------------------------------------
+void PathSpline2D::estimate(const Vector & X, const Vector & Y, const Vector & S)
+{
+  assert(X.size() == S.size() && Y.size() == S.size());
+
+  size_t n = S.size();
+  knots_ = S;
+  segments_.clear();
+  if (n < 2) {
+    return;
+  }
+
+  // recorded paths often repeat way points, the system is solved on the distinct
+  // knots only and a repeated way point shares the second derivatives of its knot
+  std::vector<size_t> knotIndexes;
+  std::vector<size_t> wayPointKnots(n);
+  for (size_t i = 0; i < n; ++i) {
+    if (knotIndexes.empty() || S[i] > S[knotIndexes.back()]) {
+      knotIndexes.push_back(i);
+    }
+    wayPointKnots[i] = knotIndexes.size() - 1;
+  }
+
+  // second derivatives at the knots, tridiagonal system solved by the Thomas
+  // algorithm with natural boundary conditions (zero at both ends)
+  size_t m = knotIndexes.size();
+  Vector Mx(m, 0.);
+  Vector My(m, 0.);
+  if (m > 2) {
+    Vector c(m, 0.);
+    for (size_t k = 1; k < m - 1; ++k) {
+      size_t i0 = knotIndexes[k - 1];
+      size_t i = knotIndexes[k];
+      size_t i1 = knotIndexes[k + 1];
+      double h0 = S[i] - S[i0];
+      double h1 = S[i1] - S[i];
+
+      double denominator = 2 * (h0 + h1) - h0 * c[k - 1];
+      c[k] = h1 / denominator;
+      Mx[k] = (6 * ((X[i1] - X[i]) / h1 - (X[i] - X[i0]) / h0) - h0 * Mx[k - 1]) /
+        denominator;
+      My[k] = (6 * ((Y[i1] - Y[i]) / h1 - (Y[i] - Y[i0]) / h0) - h0 * My[k - 1]) /
+        denominator;
+    }
+
+    for (size_t k = m - 2; k > 0; --k) {
+      Mx[k] -= c[k] * Mx[k + 1];
+      My[k] -= c[k] * My[k + 1];
+    }
+  }
+
+  // a zero length segment keeps the position of its way point, it is never
+  // returned by findSegmentIndex since no abscissa is strictly inside it
+  segments_.resize(n - 1);
+  for (size_t i = 0; i < n - 1; ++i) {
+    double h = S[i + 1] - S[i];
+    if (h > 0) {
+      size_t k = wayPointKnots[i];
+      segments_[i].x = segmentCoefficients(X[i], X[i + 1], Mx[k], Mx[k + 1], h);
+      segments_[i].y = segmentCoefficients(Y[i], Y[i + 1], My[k], My[k + 1], h);
+    } else {
+      segments_[i].x = {X[i], 0., 0., 0.};
+      segments_[i].y = {Y[i], 0., 0., 0.};
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+size_t PathSpline2D::findSegmentIndex(const double & curvilinearAbscissa) const
+{
+  assert(!segments_.empty());
+
+  // abscissae outside of the knots are extrapolated by the first or the last segment
+  auto it = std::upper_bound(knots_.begin() + 1, knots_.end() - 1, curvilinearAbscissa);
+  return std::distance(knots_.begin(), it) - 1;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathSpline2D::findSegmentIndex(
+  const double & curvilinearAbscissa,
+  const size_t & segmentHint) const
+{
+  assert(!segments_.empty());
+
+  const double & s = curvilinearAbscissa;
+  size_t i = std::min(segmentHint, segments_.size() - 1);
+  if (knots_[i] <= s && s < knots_[i + 1]) {
+    return i;
+  }
+  if (i + 1 < segments_.size() && knots_[i + 1] <= s && s < knots_[i + 2]) {
+    return i + 1;
+  }
+  if (i > 0 && knots_[i - 1] <= s && s < knots_[i]) {
+    return i - 1;
+  }
+  return findSegmentIndex(s);
+}
+
+//-----------------------------------------------------------------------------
+std::optional<double> PathSpline2D::findNearestCurvilinearAbscissa(
+  const Eigen::Vector2d & vehiclePosition,
+  const Interval<size_t> & segmentRange) const
+{
+  std::optional<double> nearestCurvilinearAbscissa;
+  double minimalSquaredDistance = std::numeric_limits<double>::max();
+
+  size_t last = std::min(segmentRange.upper(), segments_.size() - 1);
+  for (size_t i = segmentRange.lower(); i <= last; ++i) {
+    auto s = findNearestCurvilinearAbscissa_(vehiclePosition, i);
+    if (s.has_value()) {
+      double squaredDistance = (computePosition(*s, i) - vehiclePosition).squaredNorm();
+      if (squaredDistance < minimalSquaredDistance) {
+        minimalSquaredDistance = squaredDistance;
+        nearestCurvilinearAbscissa = s;
+      }
+    }
+  }
+
+  return nearestCurvilinearAbscissa;
+}
+
+//-----------------------------------------------------------------------------
+std::optional<double> PathSpline2D::findNearestCurvilinearAbscissa_(
+  const Eigen::Vector2d & vehiclePosition,
+  const size_t & segmentIndex) const
+{
+  const auto & segment = segments_[segmentIndex];
+
+  // g(t) = 1/2 d(r^2)/dt, its root inside the segment is searched by Newton
+  // iterations kept inside a sign changing bracket
+  auto g = [&](const double & t, double & dg) {
+      double ex = evaluate(segment.x, t) - vehiclePosition.x();
+      double ey = evaluate(segment.y, t) - vehiclePosition.y();
+      double dx = evaluateFirstDerivative(segment.x, t);
+      double dy = evaluateFirstDerivative(segment.y, t);
+      dg = dx * dx + dy * dy +
+        ex * evaluateSecondDerivative(segment.x, t) +
+        ey * evaluateSecondDerivative(segment.y, t);
+      return ex * dx + ey * dy;
+    };
+
+  double lower = 0;
+  double upper = knots_[segmentIndex + 1] - knots_[segmentIndex];
+  if (!(upper > 0)) {
+    return std::nullopt;
+  }
+
+  double dg;
+  if (g(lower, dg) > 0 || g(upper, dg) < 0) {
+    return std::nullopt;
+  }
+
+  // start from the projection on the chord
+  Eigen::Vector2d chord(evaluate(segment.x, upper) - segment.x[0],
+    evaluate(segment.y, upper) - segment.y[0]);
+  Eigen::Vector2d offset(vehiclePosition.x() - segment.x[0], vehiclePosition.y() - segment.y[0]);
+  double t = std::clamp(upper * chord.dot(offset) / chord.squaredNorm(), lower, upper);
+
+  constexpr int MAXIMAL_NUMBER_OF_ITERATIONS = 30;
+  constexpr double TOLERANCE = 1e-9;
+  for (int i = 0; i < MAXIMAL_NUMBER_OF_ITERATIONS; ++i) {
+    double value = g(t, dg);
+    if (value == 0) {
+      break;
+    } else if (value < 0) {
+      lower = t;
+    } else {
+      upper = t;
+    }
+
+    double next = t - value / dg;
+    if (!(dg > 0) || next <= lower || next >= upper) {
+      next = 0.5 * (lower + upper);
+    }
+
+    bool converged = std::abs(next - t) < TOLERANCE;
+    t = next;
+    if (converged) {
+      break;
+    }
+  }
+
+  return knots_[segmentIndex] + t;
+}
+
+//-----------------------------------------------------------------------------
+Eigen::Vector2d PathSpline2D::computePosition(
+  const double & curvilinearAbscissa,
+  const size_t & segmentIndex) const
+{
+  const auto & segment = segments_[segmentIndex];
+  double t = curvilinearAbscissa - knots_[segmentIndex];
+  return {evaluate(segment.x, t), evaluate(segment.y, t)};
+}
+
+//-----------------------------------------------------------------------------
+double PathSpline2D::computeTangent(
+  const double & curvilinearAbscissa,
+  const size_t & segmentIndex) const
+{
+  const auto & segment = segments_[segmentIndex];
+  double t = curvilinearAbscissa - knots_[segmentIndex];
+  return std::atan2(evaluateFirstDerivative(segment.y, t), evaluateFirstDerivative(segment.x, t));
+}
+
+//-----------------------------------------------------------------------------
+Eigen::Vector2d PathSpline2D::computeDirection(
+  const double & curvilinearAbscissa,
+  const size_t & segmentIndex) const
+{
+  const auto & segment = segments_[segmentIndex];
+  double t = curvilinearAbscissa - knots_[segmentIndex];
+  return unitDirection(evaluateFirstDerivative(segment.x, t), evaluateFirstDerivative(segment.y, t));
+}
+
+//-----------------------------------------------------------------------------
+double PathSpline2D::computeCurvature(
+  const double & curvilinearAbscissa,
+  const size_t & segmentIndex) const
+{
+  const auto & segment = segments_[segmentIndex];
+  double t = curvilinearAbscissa - knots_[segmentIndex];
+
+  double Xdot = evaluateFirstDerivative(segment.x, t);
+  double Ydot = evaluateFirstDerivative(segment.y, t);
+  double Xdotdot = evaluateSecondDerivative(segment.x, t);
+  double Ydotdot = evaluateSecondDerivative(segment.y, t);
+  double denominator = Xdot * Ydotdot - Ydot * Xdotdot;
+
+  if (std::abs(denominator) <= std::numeric_limits<double>::epsilon()) {
+    return 0;
+  }
+
+  double tempo = std::sqrt(Xdot * Xdot + Ydot * Ydot);
+  return denominator / (tempo * tempo * tempo);
+}
+
+//-----------------------------------------------------------------------------
+const PathSpline2D::Vector & PathSpline2D::getKnots() const
+{
+  return knots_;
+}
+
+//-----------------------------------------------------------------------------
+const PathSpline2D::Segments & PathSpline2D::getSegments() const
+{
+  return segments_;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathSpline2D::size() const
+{
+  return segments_.size();
+}
+
+//-----------------------------------------------------------------------------
+void PathSpline2D::clear()
+{
+  knots_.clear();
+  segments_.clear();
+}
+
+}  // namespace core
+}  // namespace romea
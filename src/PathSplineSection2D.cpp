@@ -0,0 +1,193 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cmath>
+#include <vector>
+
+// romea
+#include "romea_core_path/PathSplineSection2D.hpp"
+
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+PathSplineSection2D::PathSplineSection2D(
+  const double & initialCurvilinearAbcissa,
+  size_t initialPointIndex)
+: X_(),
+  Y_(),
+  curvilinearAbscissa_(initialCurvilinearAbcissa),
+  speeds_(),
+  spline_(),
+  initial_point_index_(initialPointIndex),
+  length_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+void PathSplineSection2D::addWayPoint(const PathWayPoint2D & wayPoint)
+{
+  if (!X_.empty()) {
+    double dx = wayPoint.position.x() - X_.back();
+    double dy = wayPoint.position.y() - Y_.back();
+    double ds = std::sqrt(dx * dx + dy * dy);
+    curvilinearAbscissa_.increment(ds);
+    length_ = curvilinearAbscissa_.finalValue() - curvilinearAbscissa_.initialValue();
+  }
+
+  X_.push_back(wayPoint.position.x());
+  Y_.push_back(wayPoint.position.y());
+  speeds_.push_back(wayPoint.desired_speed);
+}
+
+//-----------------------------------------------------------------------------
+void PathSplineSection2D::addWayPoints(const std::vector<PathWayPoint2D> & wayPoints)
+{
+  reserve(size() + wayPoints.size());
+  for (const auto & wayPoint : wayPoints) {
+    addWayPoint(wayPoint);
+  }
+}
+
+//-----------------------------------------------------------------------------
+const PathSpline2D & PathSplineSection2D::getSpline()const
+{
+  if (spline_.getKnots().size() != size()) {
+    spline_.estimate(X_, Y_, curvilinearAbscissa_.data());
+  }
+
+  return spline_;
+}
+
+//-----------------------------------------------------------------------------
+void PathSplineSection2D::reserve(size_t n)
+{
+  X_.reserve(n);
+  Y_.reserve(n);
+  curvilinearAbscissa_.reserve(n);
+  speeds_.reserve(n);
+}
+
+//-----------------------------------------------------------------------------
+const PathSplineSection2D::Vector & PathSplineSection2D::getX()const
+{
+  return X_;
+}
+
+//-----------------------------------------------------------------------------
+const PathSplineSection2D::Vector & PathSplineSection2D::getY()const
+{
+  return Y_;
+}
+
+//-----------------------------------------------------------------------------
+const PathSplineSection2D::CurvilinearAbscissa &
+PathSplineSection2D::getCurvilinearAbscissa()const
+{
+  return curvilinearAbscissa_;
+}
+
+//-----------------------------------------------------------------------------
+const PathSplineSection2D::Vector & PathSplineSection2D::getSpeeds() const
+{
+  return speeds_;
+}
+
+//-----------------------------------------------------------------------------
+const double & PathSplineSection2D::getLength()const
+{
+  return length_;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathSplineSection2D::getInitialPointIndex()const
+{
+  return initial_point_index_;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathSplineSection2D::size()const
+{
+  return X_.size();
+}
+
+//-----------------------------------------------------------------------------
+void PathSplineSection2D::clear()
+{
+  double initialCurvilinearAbcissa = curvilinearAbscissa_.initialValue();
+  X_.clear();
+  Y_.clear();
+  curvilinearAbscissa_ = CurvilinearAbscissa(initialCurvilinearAbcissa);
+  speeds_.clear();
+  spline_.clear();
+  length_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathSplineSection2D::findIndex(
+  const double & value,
+  const size_t & startSearchIndex) const
+{
+  size_t n = startSearchIndex;
+  while (n < curvilinearAbscissa_.size() - 1 && curvilinearAbscissa_[n] < value) {
+    n++;
+  }
+  return n;
+}
+
+//-----------------------------------------------------------------------------
+size_t PathSplineSection2D::findIndex(const double & value) const
+{
+  return findIndex(value, 0);
+}
+
+//-----------------------------------------------------------------------------
+Interval<size_t> PathSplineSection2D::findIntervalBoundIndexes(
+  const size_t & intervalCenterIndex,
+  const double & intervalWidth) const
+{
+  double s = curvilinearAbscissa_[intervalCenterIndex];
+  return findIntervalBoundIndexes(
+    intervalCenterIndex, Interval<double>(s - intervalWidth / 2., s + intervalWidth / 2.));
+}
+
+//-----------------------------------------------------------------------------
+Interval<size_t> PathSplineSection2D::findIntervalBoundIndexes(
+  const size_t & intervalCenterIndex,
+  const Interval<double> & interval)const
+{
+  size_t minimalIndex = intervalCenterIndex;
+  size_t maximalIndex = intervalCenterIndex;
+
+  while (minimalIndex != 0 &&
+    interval.inside(curvilinearAbscissa_[minimalIndex]))
+  {
+    minimalIndex--;
+  }
+
+  while (maximalIndex != curvilinearAbscissa_.size() - 1 &&
+    interval.inside(curvilinearAbscissa_[maximalIndex]))
+  {
+    maximalIndex++;
+  }
+
+  return {minimalIndex, maximalIndex};
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,232 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+// posix
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// romea
+#include "romea_core_path/PathSerialization.hpp"
+#include "romea_core_path/PathVersionedCache.hpp"
+
+namespace
+{
+
+constexpr std::array<char, 8> CONTROL_MAGIC = {'R', 'O', 'M', 'E', 'A', 'S', 'H', 'M'};
+
+// The control block is shared by processes, its counter must not rely on a lock
+struct ControlBlock
+{
+  std::array<char, 8> magic;
+  std::atomic<std::uint64_t> generation;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+//-----------------------------------------------------------------------------
+std::string blobName(const std::string & name, const std::uint64_t & generation)
+{
+  return name + "." + std::to_string(generation);
+}
+
+//-----------------------------------------------------------------------------
+const ControlBlock * controlBlock(const void * control)
+{
+  return static_cast<const ControlBlock *>(control);
+}
+
+//-----------------------------------------------------------------------------
+// Return nothing when the blob has been removed by a newer publication
+std::optional<romea::core::Path2D> loadBlob(
+  const std::string & name,
+  const std::uint64_t & generation)
+{
+  std::ifstream input(blobName(name, generation), std::ios::binary);
+  if (!input.is_open()) {
+    return std::nullopt;
+  }
+
+  // the generation is used as hash so that a blob can not be mistaken for another one
+  return romea::core::loadPath(input, generation);
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+PathVersionedCacheWriter::PathVersionedCacheWriter(const std::string & name)
+: name_(name),
+  control_(nullptr)
+{
+  int fd = open(name_.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open versioned path cache " + name_);
+  }
+
+  if (ftruncate(fd, sizeof(ControlBlock)) != 0) {
+    close(fd);
+    throw std::runtime_error("Failed to resize versioned path cache " + name_);
+  }
+
+  void * control = mmap(
+    nullptr, sizeof(ControlBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (control == MAP_FAILED) {
+    throw std::runtime_error("Failed to map versioned path cache " + name_);
+  }
+
+  // a restarted writer goes on from the generation of the previous one
+  auto block = static_cast<ControlBlock *>(control);
+  if (block->magic != CONTROL_MAGIC) {
+    new (&block->generation) std::atomic<std::uint64_t>(0);
+    block->magic = CONTROL_MAGIC;
+  }
+  control_ = control;
+}
+
+//-----------------------------------------------------------------------------
+PathVersionedCacheWriter::~PathVersionedCacheWriter()
+{
+  munmap(control_, sizeof(ControlBlock));
+}
+
+//-----------------------------------------------------------------------------
+std::uint64_t PathVersionedCacheWriter::publish(const Path2D & path)
+{
+  auto block = static_cast<ControlBlock *>(control_);
+  std::uint64_t generation = block->generation.load(std::memory_order_relaxed) + 1;
+
+  {
+    std::ofstream output(blobName(name_, generation), std::ios::binary | std::ios::trunc);
+    savePath(output, path, generation);
+    if (!output.flush()) {
+      throw std::runtime_error("Failed to write versioned path cache " + blobName(name_, generation));
+    }
+  }
+
+  block->generation.store(generation, std::memory_order_release);
+
+  if (generation > 2) {
+    std::remove(blobName(name_, generation - 2).c_str());
+  }
+
+  return generation;
+}
+
+//-----------------------------------------------------------------------------
+std::uint64_t PathVersionedCacheWriter::getGeneration() const
+{
+  return static_cast<const ControlBlock *>(control_)->generation.load(std::memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+PathVersionedCacheReader::PathVersionedCacheReader(const std::string & name)
+: name_(name),
+  control_(nullptr)
+{
+}
+
+//-----------------------------------------------------------------------------
+PathVersionedCacheReader::~PathVersionedCacheReader()
+{
+  if (control_ != nullptr) {
+    munmap(const_cast<void *>(control_), sizeof(ControlBlock));
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool PathVersionedCacheReader::attach_() const
+{
+  if (control_ != nullptr) {
+    return true;
+  }
+
+  // the writer may not have been started yet
+  int fd = open(name_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat status;
+  if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(ControlBlock)) {
+    close(fd);
+    return false;
+  }
+
+  void * control = mmap(nullptr, sizeof(ControlBlock), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (control == MAP_FAILED) {
+    return false;
+  }
+
+  control_ = control;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+std::uint64_t PathVersionedCacheReader::getGeneration() const
+{
+  if (!attach_() || controlBlock(control_)->magic != CONTROL_MAGIC) {
+    return 0;
+  }
+  return controlBlock(control_)->generation.load(std::memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+std::optional<Path2D> PathVersionedCacheReader::load(std::uint64_t & generation) const
+{
+  // the blob read may be removed by newer publications, the last one is then loaded
+  for (std::uint64_t current = getGeneration(); current != 0; ) {
+    if (auto path = loadBlob(name_, current)) {
+      generation = current;
+      return path;
+    }
+
+    std::uint64_t latest = getGeneration();
+    if (latest == current) {
+      break;
+    }
+    current = latest;
+  }
+
+  return std::nullopt;
+}
+
+//-----------------------------------------------------------------------------
+std::optional<Path2D> PathVersionedCacheReader::loadIfUpdated(std::uint64_t & generation) const
+{
+  if (getGeneration() == generation) {
+    return std::nullopt;
+  }
+  return load(generation);
+}
+
+}  // namespace core
+}  // namespace romea
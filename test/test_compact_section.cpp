@@ -0,0 +1,170 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_core_path/PathSectionMatching2D.hpp"
+
+// local
+#include "../test/test_helper.h"
+#include "test_utils.hpp"
+
+class TestCompactSection : public ::testing::Test
+{
+public:
+  TestCompactSection()
+  : maximalRadiusResearch(10),
+    time_horizon(1)
+  {
+  }
+
+  void SetUp() override
+  {
+    // the recorded section is moved a few kilometres away from the ENU anchor
+    auto wayPoints = loadWayPoints("/section.txt");
+    for (auto & wayPoint : wayPoints) {
+      wayPoint.position += Eigen::Vector2d(2873.4, -1942.7);
+    }
+
+    section = std::make_unique<romea::core::PathSection2D>(3, 1500.);
+    section->addWayPoints(wayPoints);
+    compactSection = std::make_unique<romea::core::PathCompactSection2D>(3, 1500.);
+    compactSection->addWayPoints(wayPoints);
+  }
+
+  romea::core::Pose2D makeVehiclePose(size_t pointIndex, double lateralOffset, double yawOffset)
+  {
+    const auto & X = section->getX();
+    const auto & Y = section->getY();
+    Eigen::Vector2d tangent(X[pointIndex + 1] - X[pointIndex], Y[pointIndex + 1] - Y[pointIndex]);
+    tangent.normalize();
+
+    romea::core::Pose2D pose;
+    pose.position = Eigen::Vector2d(X[pointIndex], Y[pointIndex]) +
+      lateralOffset * Eigen::Vector2d(-tangent.y(), tangent.x());
+    pose.yaw = std::atan2(tangent.y(), tangent.x()) + yawOffset;
+    return pose;
+  }
+
+  std::unique_ptr<romea::core::PathSection2D> section;
+  std::unique_ptr<romea::core::PathCompactSection2D> compactSection;
+  double maximalRadiusResearch;
+  double time_horizon;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestCompactSection, isSizeOK)
+{
+  EXPECT_EQ(compactSection->size(), 2425);
+  EXPECT_DOUBLE_EQ(compactSection->getLength(), section->getLength());
+  EXPECT_EQ(sizeof(romea::core::PathCompactSection2D::Point), 16);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestCompactSection, storageErrorIsBelowMillimetre)
+{
+  for (size_t n = 0; n < section->size(); ++n) {
+    Eigen::Vector2d position(section->getX()[n], section->getY()[n]);
+    EXPECT_LT((compactSection->getPosition(n) - position).norm(), 1e-3);
+    EXPECT_NEAR(
+      compactSection->getCurvilinearAbscissa(n), section->getCurvilinearAbscissa()[n], 1e-3);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestLongCompactSection, abscissaResolutionDoesNotDependOnTheLength)
+{
+  // 20 km with a way point every 10 cm
+  std::vector<romea::core::PathWayPoint2D> wayPoints;
+  for (size_t n = 0; n < 200000; ++n) {
+    double x = 0.1 * n;
+    wayPoints.push_back({Eigen::Vector2d(x, 2. * std::sin(x / 20.)), 1.});
+  }
+
+  romea::core::PathSection2D section(3.);
+  section.addWayPoints(wayPoints);
+  romea::core::PathCompactSection2D compactSection(3.);
+  compactSection.addWayPoints(wayPoints);
+
+  for (size_t n = 0; n < section.size(); n += 101) {
+    EXPECT_NEAR(
+      compactSection.getCurvilinearAbscissa(n), section.getCurvilinearAbscissa()[n], 1e-5);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestCompactSection, onlyFittedCurvesAreStored)
+{
+  EXPECT_EQ(compactSection->getNumberOfFittedCurves(), 0u);
+
+  auto pose = makeVehiclePose(1000, 0.2, 0.);
+  auto matchedPoint = match(*compactSection, pose, 1., time_horizon, maximalRadiusResearch);
+  ASSERT_TRUE(matchedPoint.has_value());
+  EXPECT_GT(compactSection->getNumberOfFittedCurves(), 0u);
+  EXPECT_LT(compactSection->getNumberOfFittedCurves(), 5u);
+
+  compactSection->clear();
+  EXPECT_EQ(compactSection->getNumberOfFittedCurves(), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestCompactSection, hasSameIndexesThanSection)
+{
+  EXPECT_EQ(compactSection->findIndex(1542.36, 0), section->findIndex(1542.36, 0));
+
+  auto centerIndex = section->findIndex(1500. + section->getLength() / 2.);
+  auto range = section->findIntervalBoundIndexes(centerIndex, 2.);
+  auto compactRange = compactSection->findIntervalBoundIndexes(centerIndex, 2.);
+  EXPECT_EQ(compactRange.lower(), range.lower());
+  EXPECT_EQ(compactRange.upper(), range.upper());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestCompactSection, frenetErrorIsBelowMillimetre)
+{
+  for (size_t n = 10; n < section->size() - 10; n += 37) {
+    for (double lateralOffset : {-1.3, -0.2, 0.4, 2.1}) {
+      auto pose = makeVehiclePose(n, lateralOffset, 0.1);
+
+      auto matchedPoint = match(*section, pose, 1., time_horizon, maximalRadiusResearch);
+      auto compactMatchedPoint =
+        match(*compactSection, pose, 1., time_horizon, maximalRadiusResearch);
+
+      ASSERT_EQ(compactMatchedPoint.has_value(), matchedPoint.has_value());
+      if (!matchedPoint.has_value()) {
+        continue;
+      }
+
+      const auto & frenetPose = matchedPoint->frenetPose;
+      const auto & compactFrenetPose = compactMatchedPoint->frenetPose;
+      EXPECT_NEAR(compactFrenetPose.curvilinearAbscissa, frenetPose.curvilinearAbscissa, 1e-3);
+      EXPECT_NEAR(compactFrenetPose.lateralDeviation, frenetPose.lateralDeviation, 1e-3);
+      EXPECT_NEAR(compactFrenetPose.courseDeviation, frenetPose.courseDeviation, 1e-3);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -18,6 +18,8 @@
 
 // std
 #include <algorithm>
+#include <cmath>
+#include <vector>
 
 // gtest
 #include "gtest/gtest.h"
@@ -92,6 +94,121 @@ TEST_F(TestCumulativeSum, checkLowerBound)
   EXPECT_EQ(std::distance(std::cbegin(cumsum), it), 6);
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestCumulativeSum, assignFromDeltasGivesTheIncrementedValues)
+{
+  std::vector<double> deltas = {0.1, 0.13, 0.06, 0.3, 0.08, 0.4, 0.23, 0.27, 0.43};
+  romea::core::CumulativeSum<double, Eigen::aligned_allocator<double>> assigned(1);
+  assigned.increment(5.);
+  assigned.assignFromDeltas(deltas.data(), deltas.size());
+  EXPECT_EQ(assigned.data(), cumsum.data());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestCumulativeSum, incrementsStartFromTheAppendedValue)
+{
+  cumsum.append(10.);
+  cumsum.increment(0.5);
+  EXPECT_EQ(cumsum.size(), 12);
+  EXPECT_EQ(cumsum[10], 10.);
+  EXPECT_EQ(cumsum.finalValue(), 10.5);
+}
+
+//-----------------------------------------------------------------------------
+class TestLongCumulativeSum : public ::testing::Test
+{
+public:
+  using NaiveCumulativeSum =
+    romea::core::CumulativeSum<double, Eigen::aligned_allocator<double>>;
+  using CompensatedCumulativeSum = romea::core::CumulativeSum<
+    double, Eigen::aligned_allocator<double>, romea::core::CompensatedSummation>;
+
+  void SetUp() override
+  {
+    // 20 km sampled every centimetre or so, starting far from the origin
+    deltas.resize(2000000);
+    for (size_t n = 0; n < deltas.size(); ++n) {
+      deltas[n] = 0.01 + 0.001 * std::sin(n * 0.1);
+    }
+
+    long double sum = initialValue;
+    long double compensation = 0;
+    exactSums.push_back(initialValue);
+    for (const double & delta : deltas) {
+      long double s = sum + delta;
+      long double d = s - sum;
+      compensation += (sum - (s - d)) + (delta - d);
+      sum = s;
+      exactSums.push_back(sum + compensation);
+    }
+  }
+
+  template<typename CumulativeSum>
+  double maximalError(const CumulativeSum & cumsum)
+  {
+    double error = 0;
+    for (size_t n = 0; n < exactSums.size(); ++n) {
+      error = std::max(error, static_cast<double>(std::abs(cumsum[n] - exactSums[n])));
+    }
+    return error;
+  }
+
+  double initialValue = 1000.;
+  std::vector<double> deltas;
+  std::vector<long double> exactSums;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLongCumulativeSum, compensatedSumsAreRoundedExactSums)
+{
+  NaiveCumulativeSum naive(initialValue);
+  CompensatedCumulativeSum compensated(initialValue);
+  for (const double & delta : deltas) {
+    naive.increment(delta);
+    compensated.increment(delta);
+  }
+
+  // half an ulp of the final value, a little more for the rounding of the reference
+  double ulp = std::nextafter(compensated.finalValue(), 1e9) - compensated.finalValue();
+  EXPECT_LE(maximalError(compensated), 0.51 * ulp);
+  EXPECT_GT(maximalError(naive), 100 * ulp);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLongCumulativeSum, compensatedBulkScanGivesTheIncrementedValues)
+{
+  CompensatedCumulativeSum incremented(initialValue);
+  for (const double & delta : deltas) {
+    incremented.increment(delta);
+  }
+
+  CompensatedCumulativeSum assigned(initialValue);
+  assigned.assignFromDeltas(deltas.data(), deltas.size());
+  EXPECT_EQ(assigned.data(), incremented.data());
+
+  CompensatedCumulativeSum assignedByChunks(initialValue);
+  assignedByChunks.assignFromDeltas(deltas.data(), deltas.size(), 4);
+  EXPECT_EQ(assignedByChunks.data(), incremented.data());
+
+  assignedByChunks.increment(0.01);
+  incremented.increment(0.01);
+  EXPECT_EQ(assignedByChunks.finalValue(), incremented.finalValue());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLongCumulativeSum, naiveBulkScanByChunksStaysCloseToTheIncrementedValues)
+{
+  NaiveCumulativeSum incremented(initialValue);
+  for (const double & delta : deltas) {
+    incremented.increment(delta);
+  }
+
+  NaiveCumulativeSum assignedByChunks(initialValue);
+  assignedByChunks.assignFromDeltas(deltas.data(), deltas.size(), 4);
+  EXPECT_EQ(assignedByChunks.size(), incremented.size());
+  EXPECT_LE(maximalError(assignedByChunks), 2 * maximalError(incremented));
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
 {
@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+// std
+#include <algorithm>
+#include <vector>
+
 // gtest
 #include "gtest/gtest.h"
 
@@ -251,6 +255,175 @@ TEST_F(CurvesAtExtremities, middle2)
   EXPECT_NEAR(*abscissa, section.getCurvilinearAbscissa()[index], 1e-3);
 }
 
+//-----------------------------------------------------------------------------
+struct CubicCurvesOnHeadlandTurn : ::testing::Test
+{
+  void SetUp() override
+  {
+    for (double a = 0.; a < M_PI; a += step / radius) {
+      wayPoints.push_back({center + radius * Eigen::Vector2d{std::cos(a), std::sin(a)}});
+    }
+  }
+
+  double maximalPositionError(const size_t & polynomialDegree, const double & window)
+  {
+    romea::core::PathSection2D section{window};
+    section.setPolynomialDegree(polynomialDegree);
+    section.addWayPoints(wayPoints);
+
+    auto index = section.findIndex(radius * M_PI_2);
+    const auto & curve = section.getCurve(index);
+    EXPECT_EQ(curve.getPolynomialDegree(), polynomialDegree);
+    EXPECT_EQ(curve.getFitStatus(), romea::core::PathCurve2D::FitStatus::SUCCESS);
+
+    double error = 0;
+    auto range = curve.getIndexInterval();
+    for (size_t n = range.lower(); n <= range.upper(); ++n) {
+      double s = section.getCurvilinearAbscissa()[n];
+      Eigen::Vector2d p{curve.computeX(s), curve.computeY(s)};
+      error = std::max(error, (p - Eigen::Vector2d{section.getX()[n], section.getY()[n]}).norm());
+    }
+    return error;
+  }
+
+  Eigen::Vector2d center{-4893., 3972};
+  double radius = 4.;
+  double step = 0.1;
+  std::vector<romea::core::PathWayPoint2D> wayPoints;
+};
+
+TEST_F(CubicCurvesOnHeadlandTurn, cubicFitIsMoreAccurateWithLargerWindow)
+{
+  double quadraticError = maximalPositionError(2, 3.);
+  double cubicError = maximalPositionError(3, 5.);
+  EXPECT_LT(cubicError, quadraticError);
+  EXPECT_LT(cubicError, 0.01);
+}
+
+TEST_F(CubicCurvesOnHeadlandTurn, nearestAbscissa)
+{
+  romea::core::PathSection2D section{6.};
+  section.setPolynomialDegree(3);
+  section.addWayPoints(wayPoints);
+
+  double expected = radius * M_PI_2;
+  const auto & curve = section.getCurve(section.findIndex(expected));
+
+  for (double lateral = -2.; lateral < 2.01; lateral += 0.5) {
+    Eigen::Vector2d pos = center + Eigen::Vector2d{0., radius + lateral};
+    auto abscissa = curve.findNearestCurvilinearAbscissa(pos);
+    ASSERT_TRUE(abscissa);
+    EXPECT_NEAR(*abscissa, expected, 1e-2);
+  }
+
+  // projection outside of the window
+  auto abscissa = curve.findNearestCurvilinearAbscissa(center + Eigen::Vector2d{radius, 0.});
+  EXPECT_FALSE(abscissa);
+}
+
+TEST_F(CubicCurvesOnHeadlandTurn, newtonStepsFromPreviousAbscissa)
+{
+  for (size_t polynomialDegree : {2, 3}) {
+    romea::core::PathSection2D section{4.};
+    section.setPolynomialDegree(polynomialDegree);
+    section.addWayPoints(wayPoints);
+
+    double expected = radius * M_PI_2;
+    const auto & curve = section.getCurve(section.findIndex(expected));
+    Eigen::Vector2d pos = center + Eigen::Vector2d{0., radius + 0.3};
+
+    // the vehicle has moved by a few centimetres since the previous abscissa
+    auto reference = curve.findNearestCurvilinearAbscissa(pos);
+    auto refined = curve.refineNearestCurvilinearAbscissa(pos, expected - 0.05);
+    ASSERT_TRUE(reference);
+    ASSERT_TRUE(refined);
+    EXPECT_NEAR(*refined, *reference, 1e-8);
+
+    // too far to converge in two steps
+    EXPECT_FALSE(curve.refineNearestCurvilinearAbscissa(pos, expected - 3., 2));
+  }
+}
+
+TEST_F(CubicCurvesOnHeadlandTurn, fitFailsWithoutEnoughPoints)
+{
+  romea::core::PathCurve2D curve;
+  EXPECT_EQ(curve.getFitStatus(), romea::core::PathCurve2D::FitStatus::NOT_ESTIMATED);
+
+  romea::core::PathCurve2D::Vector X = {0., 1., 2., 3.};
+  romea::core::PathCurve2D::Vector Y = {0., 1., 2., 3.};
+  romea::core::PathCurve2D::Vector S = {0., 1.41, 2.82, 4.23};
+  romea::core::Interval<size_t> indexes(0, 3);
+  romea::core::Interval<double> interval(0., 4.23);
+
+  EXPECT_TRUE(curve.estimate(X, Y, S, indexes, interval, 2));
+  EXPECT_FALSE(curve.estimate(X, Y, S, indexes, interval, 3));
+  EXPECT_EQ(curve.getFitStatus(), romea::core::PathCurve2D::FitStatus::NOT_ENOUGH_POINTS);
+}
+
+TEST_F(CubicCurvesOnHeadlandTurn, batchEvaluationMatchesScalarCalls)
+{
+  for (size_t polynomialDegree : {2, 3}) {
+    romea::core::PathSection2D section{5.};
+    section.setPolynomialDegree(polynomialDegree);
+    section.addWayPoints(wayPoints);
+
+    const auto & curve = section.getCurve(section.findIndex(radius * M_PI_2));
+    const auto & interval = curve.getCurvilinearAbscissaInterval();
+    Eigen::ArrayXd S = Eigen::ArrayXd::LinSpaced(101, interval.lower(), interval.upper());
+
+    Eigen::ArrayXd X(S.size()), Y(S.size()), tangents(S.size()), curvatures(S.size());
+    curve.computePostures(S, X, Y, tangents, curvatures);
+
+    Eigen::ArrayXd batch(S.size());
+    for (Eigen::Index n = 0; n < S.size(); ++n) {
+      EXPECT_NEAR(X[n], curve.computeX(S[n]), 1e-9);
+      EXPECT_NEAR(Y[n], curve.computeY(S[n]), 1e-9);
+      EXPECT_NEAR(tangents[n], curve.computeTangent(S[n]), 1e-12);
+      EXPECT_NEAR(curvatures[n], curve.computeCurvature(S[n]), 1e-12);
+    }
+
+    curve.computeX(S, batch);
+    EXPECT_TRUE(batch.isApprox(X));
+    curve.computeY(S, batch);
+    EXPECT_TRUE(batch.isApprox(Y));
+    curve.computeTangent(S, batch);
+    EXPECT_TRUE(batch.isApprox(tangents));
+    curve.computeCurvature(S, batch);
+    EXPECT_TRUE(batch.isApprox(curvatures));
+  }
+}
+
+TEST_F(CubicCurvesOnHeadlandTurn, directionIsUnitTangentVector)
+{
+  romea::core::PathSection2D section{5.};
+  section.addWayPoints(wayPoints);
+
+  const auto & curve = section.getCurve(section.findIndex(radius * M_PI_2));
+  const auto & interval = curve.getCurvilinearAbscissaInterval();
+  for (double s = interval.lower(); s <= interval.upper(); s += 0.1) {
+    double tangent = curve.computeTangent(s);
+    Eigen::Vector2d direction = curve.computeDirection(s);
+    EXPECT_NEAR(direction.norm(), 1., 1e-12);
+    EXPECT_NEAR(direction.x(), std::cos(tangent), 1e-12);
+    EXPECT_NEAR(direction.y(), std::sin(tangent), 1e-12);
+  }
+}
+
+TEST(PathCurve2DBatch, straightCurveHasNullCurvature)
+{
+  romea::core::PathCurve2D::PolynomCoefficients fx{1., 2., 0., 0.};
+  romea::core::PathCurve2D::PolynomCoefficients fy{0., 1., 0., 0.};
+  romea::core::PathCurve2D curve(
+    fx, fy, 2, {1., 0.}, 0., {0, 10}, {0., 10.});
+
+  std::vector<double> abscissae = {0., 2.5, 5.};
+  std::vector<double> curvatures(abscissae.size(), 1.);
+  curve.computeCurvature(
+    Eigen::Map<const Eigen::ArrayXd>(abscissae.data(), abscissae.size()),
+    Eigen::Map<Eigen::ArrayXd>(curvatures.data(), curvatures.size()));
+  EXPECT_EQ(curvatures, std::vector<double>(3, 0.));
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
 {
@@ -0,0 +1,152 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <memory>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_core_path/PathSectionMatching2D.hpp"
+
+// local
+#include "../test/test_helper.h"
+#include "test_utils.hpp"
+
+class TestInterleavedSection : public ::testing::Test
+{
+public:
+  TestInterleavedSection()
+  : maximalRadiusResearch(10),
+    time_horizon(1)
+  {
+  }
+
+  void SetUp() override
+  {
+    auto wayPoints = loadWayPoints("/section.txt");
+    section = std::make_unique<romea::core::PathSection2D>(3);
+    section->addWayPoints(wayPoints);
+    interleavedSection = std::make_unique<romea::core::PathInterleavedSection2D>(3);
+    interleavedSection->addWayPoints(wayPoints);
+  }
+
+  std::unique_ptr<romea::core::PathSection2D> section;
+  std::unique_ptr<romea::core::PathInterleavedSection2D> interleavedSection;
+  double maximalRadiusResearch;
+  double time_horizon;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestInterleavedSection, hasSameGeometryThanSection)
+{
+  ASSERT_EQ(interleavedSection->size(), section->size());
+  EXPECT_DOUBLE_EQ(interleavedSection->getLength(), section->getLength());
+
+  const auto & points = interleavedSection->getPoints();
+  for (size_t n = 0; n < section->size(); ++n) {
+    EXPECT_EQ(points[n].x, section->getX()[n]);
+    EXPECT_EQ(points[n].y, section->getY()[n]);
+    EXPECT_DOUBLE_EQ(points[n].curvilinearAbscissa, section->getCurvilinearAbscissa()[n]);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestInterleavedSection, hasSameIndexesThanSection)
+{
+  EXPECT_EQ(interleavedSection->findIndex(42.36, 0), section->findIndex(42.36, 0));
+
+  auto centerIndex = section->findIndex(section->getLength() / 2.);
+  auto range = section->findIntervalBoundIndexes(centerIndex, 2.);
+  auto interleavedRange = interleavedSection->findIntervalBoundIndexes(centerIndex, 2.);
+  EXPECT_EQ(interleavedRange.lower(), range.lower());
+  EXPECT_EQ(interleavedRange.upper(), range.upper());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestInterleavedSection, hasSameCurvesThanSection)
+{
+  for (size_t n = 0; n < section->size(); n += 97) {
+    const auto & curve = section->getCurve(n);
+    const auto & interleavedCurve = interleavedSection->getCurve(n);
+    double s = section->getCurvilinearAbscissa()[n];
+    EXPECT_NEAR(interleavedCurve.computeX(s), curve.computeX(s), 1e-9);
+    EXPECT_NEAR(interleavedCurve.computeY(s), curve.computeY(s), 1e-9);
+    EXPECT_NEAR(interleavedCurve.computeCurvature(s), curve.computeCurvature(s), 1e-9);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestInterleavedSection, testGlobalMatchingOK)
+{
+  romea::core::Pose2D vehiclePose;
+  vehiclePose.position.x() = -8.2;
+  vehiclePose.position.y() = 16.1;
+  vehiclePose.yaw = 120 / 180. * M_PI;
+  double vehicleSpeed = 0;
+
+  auto matchedPoint = match(
+    *interleavedSection,
+    vehiclePose,
+    vehicleSpeed,
+    time_horizon,
+    maximalRadiusResearch);
+
+  ASSERT_EQ(matchedPoint.has_value(), true);
+  EXPECT_NEAR(matchedPoint->pathPosture.position.x(), -8.10917, 0.001);
+  EXPECT_NEAR(matchedPoint->pathPosture.position.y(), 16.2537, 0.001);
+  EXPECT_NEAR(matchedPoint->pathPosture.course, 2.60782, 0.001);
+  EXPECT_NEAR(matchedPoint->pathPosture.curvature, 0.0816672, 0.001);
+  EXPECT_NEAR(matchedPoint->frenetPose.curvilinearAbscissa, 17.1109, 0.001);
+  EXPECT_NEAR(matchedPoint->frenetPose.lateralDeviation, 0.17852, 0.001);
+  EXPECT_NEAR(matchedPoint->frenetPose.courseDeviation, -0.51343, 0.001);
+  EXPECT_EQ(matchedPoint->curveIndex, 177);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestInterleavedSection, testLocalMatchingOK)
+{
+  romea::core::Pose2D firstVehiclePose;
+  firstVehiclePose.position.x() = -8.2;
+  firstVehiclePose.position.y() = 16.1;
+  firstVehiclePose.yaw = 120 / 180. * M_PI;
+
+  romea::core::Pose2D secondVehiclePose;
+  secondVehiclePose.position.x() = -9.3;
+  secondVehiclePose.position.y() = 17.2;
+  secondVehiclePose.yaw = 130 / 180. * M_PI;
+
+  auto firstMatchedPoint = match(
+    *interleavedSection, firstVehiclePose, 1., time_horizon, maximalRadiusResearch);
+  ASSERT_EQ(firstMatchedPoint.has_value(), true);
+
+  auto secondMatchedPoint = match(
+    *interleavedSection, secondVehiclePose, 1., *firstMatchedPoint, 10.,
+    time_horizon, maximalRadiusResearch);
+
+  ASSERT_EQ(secondMatchedPoint.has_value(), true);
+  EXPECT_NEAR(secondMatchedPoint->pathPosture.position.x(), -9.41664, 0.001);
+  EXPECT_NEAR(secondMatchedPoint->pathPosture.position.y(), 16.9346, 0.001);
+  EXPECT_NEAR(secondMatchedPoint->frenetPose.curvilinearAbscissa, 18.5847, 0.001);
+  EXPECT_NEAR(secondMatchedPoint->frenetPose.lateralDeviation, -0.289936, 0.001);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,135 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <memory>
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// romea
+#include "romea_core_path/Path2D.hpp"
+#include "romea_core_path/PathMatching2D.hpp"
+#include "romea_core_path/PathMatchingInstrumentation.hpp"
+
+// local
+#include "test_utils.hpp"
+
+class TestMatchingInstrumentation : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    // path curves are fitted when the path is built
+    romea::core::resetMatchingInstrumentation();
+    std::vector<std::vector<romea::core::PathWayPoint2D>> wayPoints(3);
+    wayPoints[0] = loadWayPoints("/path11.txt");
+    wayPoints[1] = loadWayPoints("/path12.txt");
+    wayPoints[2] = loadWayPoints("/path13.txt");
+    path = std::make_unique<romea::core::Path2D>(wayPoints, 3);
+  }
+
+  void matchOnPath()
+  {
+    romea::core::Pose2D vehiclePose;
+    vehiclePose.position.x() = 18.3;
+    vehiclePose.position.y() = -4;
+    vehiclePose.yaw = 0.278;
+    romea::core::match(*path, vehiclePose, 1., 0.2, 10);
+  }
+
+  void matchFarFromPath()
+  {
+    romea::core::Pose2D vehiclePose;
+    vehiclePose.position.x() = 1000;
+    vehiclePose.position.y() = 1000;
+    romea::core::match(*path, vehiclePose, 1., 0.2, 10);
+  }
+
+  std::unique_ptr<romea::core::Path2D> path;
+};
+
+//-----------------------------------------------------------------------------
+TEST(TestLatencyHistogram, quantilesAreBinUpperBounds)
+{
+  romea::core::LatencyHistogram histogram;
+  histogram.bins[3] = 90;
+  histogram.bins[10] = 10;
+  histogram.count = 100;
+  histogram.totalNanoseconds = 10000;
+  histogram.maximalNanoseconds = 1000;
+
+  EXPECT_DOUBLE_EQ(histogram.meanNanoseconds(), 100.);
+  EXPECT_EQ(histogram.quantileNanoseconds(0.5), 8u);
+  EXPECT_EQ(histogram.quantileNanoseconds(0.8), 8u);
+  EXPECT_EQ(histogram.quantileNanoseconds(0.99), 1000u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestMatchingInstrumentation, snapshotFollowsBuildOption)
+{
+  using romea::core::MatchingCounter;
+  using romea::core::MatchingStage;
+
+  matchOnPath();
+  matchOnPath();
+  matchFarFromPath();
+
+  auto snapshot = romea::core::getMatchingInstrumentationSnapshot();
+
+  if (romea::core::isMatchingInstrumentationEnabled()) {
+    const auto & match = snapshot.stage(MatchingStage::MATCH);
+    EXPECT_EQ(match.count, 3u);
+    EXPECT_GT(match.totalNanoseconds, 0u);
+    EXPECT_LE(match.quantileNanoseconds(0.5), match.quantileNanoseconds(0.99));
+    EXPECT_GT(snapshot.stage(MatchingStage::CANDIDATE_SEARCH).count, 0u);
+    EXPECT_GT(snapshot.stage(MatchingStage::ROOT_SOLVE).count, 0u);
+    // sections far from the vehicle are pruned by the section tree
+    EXPECT_GT(snapshot.counter(MatchingCounter::SECTIONS_PROBED), 0u);
+    EXPECT_LE(snapshot.counter(MatchingCounter::SECTIONS_PROBED), 2 * path->size());
+    EXPECT_GT(snapshot.counter(MatchingCounter::POINTS_SCANNED), 0u);
+    EXPECT_GT(snapshot.counter(MatchingCounter::CURVES_FITTED), 0u);
+    EXPECT_EQ(snapshot.counter(MatchingCounter::MATCH_LOSSES), 1u);
+  } else {
+    EXPECT_EQ(snapshot.stage(MatchingStage::MATCH).count, 0u);
+    EXPECT_EQ(snapshot.counter(MatchingCounter::SECTIONS_PROBED), 0u);
+    EXPECT_EQ(snapshot.counter(MatchingCounter::MATCH_LOSSES), 0u);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestMatchingInstrumentation, resetClearsSnapshot)
+{
+  matchOnPath();
+  romea::core::resetMatchingInstrumentation();
+
+  auto snapshot = romea::core::getMatchingInstrumentationSnapshot();
+  for (const auto & stage : snapshot.stages) {
+    EXPECT_EQ(stage.count, 0u);
+    EXPECT_EQ(stage.maximalNanoseconds, 0u);
+  }
+  for (const auto & counter : snapshot.counters) {
+    EXPECT_EQ(counter, 0u);
+  }
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+// gtest
+#include <gtest/gtest.h>
+
+// romea
+#include "romea_core_path/Path2D.hpp"
+#include "romea_core_path/PathFile.hpp"
+#include "romea_core_path/PathMatchingReplay.hpp"
+
+// local
+#include "../test/test_helper.h"
+
+class TestMatchingReplay : public ::testing::Test
+{
+public:
+  TestMatchingReplay()
+  : log(romea::core::loadPoseLog(std::string(TEST_DIR) + "/path1_poses.csv"))
+  {
+  }
+
+  romea::core::PoseLog log;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestMatchingReplay, csvPoseLogIsLoaded)
+{
+  ASSERT_EQ(log.size(), 528u);
+  EXPECT_DOUBLE_EQ(log[1].stamp, 0.067);
+  EXPECT_DOUBLE_EQ(log[1].pose.position.x(), 0.1072);
+  EXPECT_DOUBLE_EQ(log[1].pose.position.y(), 0.0319);
+  EXPECT_DOUBLE_EQ(log[1].pose.yaw, -0.1745);
+  EXPECT_DOUBLE_EQ(log[1].speed, 1.5);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestMatchingReplay, binaryPoseLogRoundTrip)
+{
+  std::string filename = ::testing::TempDir() + "romea_path_poses.bin";
+  romea::core::savePoseLog(filename, log);
+  auto loaded = romea::core::loadPoseLog(filename);
+  std::remove(filename.c_str());
+
+  ASSERT_EQ(loaded.size(), log.size());
+  for (size_t n = 0; n < log.size(); ++n) {
+    EXPECT_EQ(loaded[n].stamp, log[n].stamp);
+    EXPECT_EQ(loaded[n].pose.position, log[n].pose.position);
+    EXPECT_EQ(loaded[n].pose.yaw, log[n].pose.yaw);
+    EXPECT_EQ(loaded[n].speed, log[n].speed);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestMatchingReplay, malformedCsvLineThrows)
+{
+  std::string filename = ::testing::TempDir() + "romea_path_poses.csv";
+  {
+    std::ofstream file(filename);
+    file << "stamp,x,y,yaw,speed\n0,1,2,3,4\n0,1,two,3,4\n";
+  }
+  EXPECT_THROW(romea::core::loadPoseLog(filename), std::runtime_error);
+  std::remove(filename.c_str());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestMatchingReplay, replayFollowsAllSectionsWithoutLoss)
+{
+  romea::core::PathFile file(std::string(TEST_DIR) + "/path1_enu.txt");
+  romea::core::Path2D path(file.getWayPoints(), 3, file.getAnnotations());
+
+  auto result = romea::core::replayMatching(path, log);
+  ASSERT_EQ(result.matchedPoints.size(), log.size());
+  EXPECT_TRUE(result.matchLosses.empty());
+
+  size_t sectionIndex = 0;
+  for (const auto & matchedPoint : result.matchedPoints) {
+    ASSERT_TRUE(matchedPoint.has_value());
+    EXPECT_GE(matchedPoint->sectionIndex, sectionIndex);
+    EXPECT_NEAR(std::abs(matchedPoint->frenetPose.lateralDeviation), 0.05, 0.02);
+    sectionIndex = matchedPoint->sectionIndex;
+  }
+  EXPECT_EQ(sectionIndex, 2u);
+
+  auto statistics = romea::core::computeStatistics(result);
+  EXPECT_EQ(statistics.numberOfPoses, log.size());
+  EXPECT_EQ(statistics.numberOfMatchLosses, 0u);
+  EXPECT_GT(statistics.matchesPerSecond, 0.);
+  EXPECT_LE(statistics.p50Nanoseconds, statistics.p99Nanoseconds);
+  EXPECT_LE(statistics.p99Nanoseconds, statistics.maximalNanoseconds);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
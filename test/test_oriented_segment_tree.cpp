@@ -0,0 +1,192 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cmath>
+#include <random>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// romea
+#include "romea_core_path/PathOrientedSegmentTree2D.hpp"
+
+//-----------------------------------------------------------------------------
+// Linear scan with the orientation rule of the section matching
+size_t findNearestOrientedPointIndex(
+  const std::vector<double> & X,
+  const std::vector<double> & Y,
+  const std::vector<double> & speeds,
+  const romea::core::Pose2D & pose,
+  const romea::core::Interval<size_t> & indexRange,
+  const double & researchRadius)
+{
+  Eigen::Vector2d heading(std::cos(pose.yaw), std::sin(pose.yaw));
+  size_t nearestPointIndex = X.size();
+  double minSqDist = researchRadius * researchRadius;
+  for (size_t n = indexRange.lower(); n <= indexRange.upper(); ++n) {
+    Eigen::Vector2d point(X[n], Y[n]);
+    size_t next = n + 1 < X.size() ? n + 1 : n;
+    size_t previous = next - 1;
+    Eigen::Vector2d direction = Eigen::Vector2d(X[next], Y[next]) -
+      Eigen::Vector2d(X[previous], Y[previous]);
+
+    double sqDist = (pose.position - point).squaredNorm();
+    if (sqDist < minSqDist &&
+      std::signbit(heading.dot(direction)) == std::signbit(speeds[n]))
+    {
+      minSqDist = sqDist;
+      nearestPointIndex = n;
+    }
+  }
+  return nearestPointIndex;
+}
+
+class TestOrientedSegmentTree : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    // back and forth rows linked by turns, the last row is driven backward
+    for (size_t row = 0; row < 6; ++row) {
+      double y = 3. * row;
+      double speed = row == 5 ? -1. : 1.;
+      for (size_t n = 0; n < 700; ++n) {
+        double x = row % 2 == 0 ? 0.1 * n : 70. - 0.1 * n;
+        addPoint(x, y + 0.2 * std::sin(0.05 * n), speed);
+      }
+    }
+  }
+
+  void addPoint(double x, double y, double speed)
+  {
+    X.push_back(x);
+    Y.push_back(y);
+    speeds.push_back(speed);
+    tree.addPoint(Eigen::Vector2d(x, y), speed);
+  }
+
+  std::vector<double> X;
+  std::vector<double> Y;
+  std::vector<double> speeds;
+  romea::core::PathOrientedSegmentTree2D tree;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestOrientedSegmentTree, directionsAndTravelDirections)
+{
+  ASSERT_EQ(tree.size(), X.size());
+  EXPECT_NEAR(tree.getDirections()[0].norm(), 1., 1e-12);
+  EXPECT_EQ(tree.getDirections().back(), tree.getDirections()[tree.size() - 2]);
+  EXPECT_FALSE(tree.isBackward(0));
+  EXPECT_TRUE(tree.isBackward(tree.size() - 1));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestOrientedSegmentTree, sameResultAsLinearScan)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> x(-5., 75.);
+  std::uniform_real_distribution<double> y(-5., 20.);
+  std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+  std::uniform_int_distribution<size_t> index(0, X.size() - 1);
+  std::vector<double> radii = {0.5, 2., 10., 100.};
+
+  for (size_t i = 0; i < 400; ++i) {
+    romea::core::Pose2D pose;
+    pose.position = Eigen::Vector2d(x(generator), y(generator));
+    pose.yaw = yaw(generator);
+
+    size_t first = index(generator);
+    size_t last = index(generator);
+    romea::core::Interval<size_t> range(std::min(first, last), std::max(first, last));
+    if (i % 2 == 0) {
+      range = romea::core::Interval<size_t>(0, X.size() - 1);
+    }
+
+    double radius = radii[i % radii.size()];
+    EXPECT_EQ(
+      tree.findNearestOrientedPointIndex(X.data(), Y.data(), pose, range, radius),
+      findNearestOrientedPointIndex(X, Y, speeds, pose, range, radius));
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestOrientedSegmentTree, prunedPointsAreNotVisited)
+{
+  // on the first row heading along it, the other rows are pruned
+  romea::core::Pose2D pose;
+  pose.position = Eigen::Vector2d(35., 0.1);
+  romea::core::Interval<size_t> range(0, X.size() - 1);
+
+  size_t numberOfVisitedPoints;
+  size_t index = tree.findNearestOrientedPointIndex(
+    X.data(), Y.data(), pose, range, 2., numberOfVisitedPoints);
+  EXPECT_EQ(index, findNearestOrientedPointIndex(X, Y, speeds, pose, range, 2.));
+  EXPECT_GT(numberOfVisitedPoints, 0u);
+  EXPECT_LT(numberOfVisitedPoints, X.size() / 10);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestOrientedSegmentTree, bulkInsertionGivesTheSameResults)
+{
+  romea::core::PathOrientedSegmentTree2D bulkTree;
+  bulkTree.addPoints(X.data(), Y.data(), speeds.data(), X.size());
+  ASSERT_EQ(bulkTree.size(), tree.size());
+  EXPECT_EQ(bulkTree.getDirections(), tree.getDirections());
+  EXPECT_EQ(bulkTree.getBoundingBox().min(), tree.getBoundingBox().min());
+  EXPECT_EQ(bulkTree.getBoundingBox().max(), tree.getBoundingBox().max());
+  for (size_t n = 0; n < X.size(); ++n) {
+    EXPECT_EQ(bulkTree.isBackward(n), tree.isBackward(n));
+  }
+
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> x(-5., 75.);
+  std::uniform_real_distribution<double> y(-5., 20.);
+  std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+  romea::core::Interval<size_t> range(0, X.size() - 1);
+  for (size_t i = 0; i < 400; ++i) {
+    romea::core::Pose2D pose;
+    pose.position = Eigen::Vector2d(x(generator), y(generator));
+    pose.yaw = yaw(generator);
+    EXPECT_EQ(
+      bulkTree.findNearestOrientedPointIndex(X.data(), Y.data(), pose, range, 10.),
+      findNearestOrientedPointIndex(X, Y, speeds, pose, range, 10.));
+  }
+
+  // points added afterwards extend the bulk tree
+  bulkTree.addPoint(Eigen::Vector2d(0., 30.), 1.);
+  EXPECT_EQ(bulkTree.getBoundingBox().max().y(), 30.);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestOrientedSegmentTree, clearEmptiesTree)
+{
+  tree.clear();
+  EXPECT_EQ(tree.size(), 0u);
+
+  romea::core::Pose2D pose;
+  EXPECT_EQ(
+    tree.findNearestOrientedPointIndex(
+      X.data(), Y.data(), pose, romea::core::Interval<size_t>(0, 0), 10.), 0u);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
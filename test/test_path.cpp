@@ -63,6 +63,21 @@ TEST_F(TestPath, isLengthOK)
   EXPECT_NEAR(path->getLength(), 52.655692386509557, 0.001);
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestPath, sectionsAreChainedOnTheirAbscissae)
+{
+  for (size_t i = 0; i < path->size(); ++i) {
+    const auto & abscissa = path->getSection(i).getCurvilinearAbscissa();
+    EXPECT_EQ(path->getSection(i).getLength(), abscissa.finalValue() - abscissa.initialValue());
+    EXPECT_EQ(path->getCurvilinearAbscissa()[i], abscissa.initialValue());
+    if (i != 0) {
+      EXPECT_EQ(
+        abscissa.initialValue(),
+        path->getSection(i - 1).getCurvilinearAbscissa().finalValue());
+    }
+  }
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
 {
@@ -0,0 +1,236 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_core_path/PathFile.hpp"
+
+// local
+#include "../test/test_helper.h"
+
+//-----------------------------------------------------------------------------
+std::string writePathFile(const std::string & content)
+{
+  auto filename = std::filesystem::temp_directory_path() / "romea_core_path_test_path_file.txt";
+  std::ofstream(filename) << content;
+  return filename.string();
+}
+
+//-----------------------------------------------------------------------------
+// Message of the exception thrown while loading the content, empty when it is loaded
+std::string loadingError(const std::string & content, size_t numberOfThreads = 1)
+{
+  try {
+    romea::core::PathFile file(writePathFile(content), numberOfThreads);
+  } catch (const std::runtime_error & e) {
+    std::string message = e.what();
+    return message.substr(message.find(".txt:") + 5);
+  }
+  return "";
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPathFile, loadLegacyFile)
+{
+  romea::core::PathFile file(std::string(TEST_DIR) + "/path1_enu.txt");
+  EXPECT_EQ(file.getCoordinateSystemDescription(), "ENU");
+  EXPECT_FALSE(file.getWGS84Anchor().has_value());
+  EXPECT_TRUE(file.getWorldToPathTransformation().matrix().isIdentity());
+
+  const auto & wayPoints = file.getWayPoints();
+  ASSERT_EQ(wayPoints.size(), 3);
+  EXPECT_EQ(wayPoints[0].size(), 259);
+  EXPECT_EQ(wayPoints[1].size(), 17);
+  EXPECT_EQ(wayPoints[2].size(), 255);
+  EXPECT_DOUBLE_EQ(wayPoints[0][1].position.x(), 9.84810001e-02);
+  EXPECT_DOUBLE_EQ(wayPoints[0][1].position.y(), -1.73650000e-02);
+  EXPECT_DOUBLE_EQ(wayPoints[0][1].desired_speed, 1.5);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPathFile, loadColumnsAndLayouts)
+{
+  romea::core::PathFile file(writePathFile(
+      "WGS84 45.5 3.1 400.\n"
+      "2\n"
+      "2 2\n"
+      "1 2\n"
+      "+3.5 -4e-1\r\n"
+      "\n"
+      "1 4\n"
+      "  5 6 0.5 12  \n"));
+  EXPECT_EQ(file.getCoordinateSystemDescription(), "WGS84");
+  EXPECT_TRUE(file.getWGS84Anchor().has_value());
+
+  const auto & wayPoints = file.getWayPoints();
+  ASSERT_EQ(wayPoints.size(), 2);
+  ASSERT_EQ(wayPoints[0].size(), 2);
+  ASSERT_EQ(wayPoints[1].size(), 1);
+  EXPECT_EQ(wayPoints[0][1].position, Eigen::Vector2d(3.5, -0.4));
+  EXPECT_EQ(wayPoints[1][0].position, Eigen::Vector2d(5., 6.));
+  EXPECT_EQ(wayPoints[1][0].desired_speed, 0.5);
+
+  EXPECT_EQ(loadingError("WGS84\n45.5 3.1 400.\n1\n1 2\n1 2"), "");
+  EXPECT_EQ(loadingError("PIXEL\n1\n1 3\n1 2 3"), "");
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPathFile, errorsReportLineAndColumn)
+{
+  EXPECT_EQ(loadingError("UTM\n1\n"), "1:1: unknown path header UTM");
+  EXPECT_EQ(loadingError("WGS84 45.5 3.1 x\n1\n"), "1:16: expected the anchor altitude, got x");
+  EXPECT_EQ(loadingError("ENU\n\n1\n"), "2:1: expected the number of sections");
+  EXPECT_EQ(loadingError("ENU\n1\n2 5\n"), "3:3: the number of columns must be 2, 3 or 4");
+  EXPECT_EQ(loadingError("ENU\n1\n2 3\n1 2 3\n4 x 6\n"), "5:3: expected the y coordinate, got x");
+  EXPECT_EQ(
+    loadingError("ENU\n1\n2 3\n1 2 3\n4 5\n"),
+    "5:4: expected the desired speed");
+  EXPECT_EQ(
+    loadingError("ENU\n1\n2 3\n1 2 3 4\n"),
+    "4:7: expected the end of the line, got 4");
+  EXPECT_EQ(
+    loadingError("ENU\n1\n1 2\n1 2\n3 4\n"),
+    "5:1: unexpected content after the 1 declared sections");
+  EXPECT_EQ(
+    loadingError("ENU\n1\n1 2\n1e999 2\n"),
+    "4:1: the x coordinate is out of range: 1e999");
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPathFile, pathBuiltFromTheFileColumns)
+{
+  std::string filename = std::string(TEST_DIR) + "/path1_enu.txt";
+  romea::core::PathFile file(filename);
+  romea::core::Path2D path(file.getWayPoints(), 3, file.getAnnotations());
+
+  romea::core::PathFile movedFile(filename);
+  const double * x = movedFile.getWayPointColumns()[2].x.data();
+  romea::core::Path2D movedPath(std::move(movedFile), 3);
+  EXPECT_TRUE(movedFile.getWayPointColumns().empty());
+  EXPECT_TRUE(movedFile.getWayPoints().empty());
+  EXPECT_EQ(movedPath.getSection(2).getX().data(), x);
+
+  ASSERT_EQ(movedPath.size(), path.size());
+  EXPECT_EQ(movedPath.getLength(), path.getLength());
+  for (size_t i = 0; i < path.size(); ++i) {
+    const auto & section = path.getSection(i);
+    const auto & movedSection = movedPath.getSection(i);
+    EXPECT_EQ(movedSection.getInitialPointIndex(), section.getInitialPointIndex());
+    EXPECT_EQ(movedSection.getX(), section.getX());
+    EXPECT_EQ(movedSection.getY(), section.getY());
+    EXPECT_EQ(movedSection.getSpeeds(), section.getSpeeds());
+    EXPECT_EQ(
+      movedSection.getCurvilinearAbscissa().data(), section.getCurvilinearAbscissa().data());
+    EXPECT_EQ(movedSection.getBoundingBox().min(), section.getBoundingBox().min());
+    EXPECT_EQ(movedSection.getBoundingBox().max(), section.getBoundingBox().max());
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPathFile, columnsAreAppendedToANonEmptySection)
+{
+  romea::core::PathFile file(std::string(TEST_DIR) + "/path1_enu.txt");
+  const auto & wayPoints = file.getWayPoints()[0];
+
+  romea::core::PathSection2D section(3.);
+  section.addWayPoints(wayPoints);
+
+  romea::core::PathSection2D appendedSection(3.);
+  appendedSection.addWayPoint(wayPoints[0]);
+  auto columns = file.getWayPointColumns()[0];
+  columns.x.erase(columns.x.begin());
+  columns.y.erase(columns.y.begin());
+  columns.speeds.erase(columns.speeds.begin());
+  appendedSection.addWayPoints(std::move(columns));
+
+  EXPECT_EQ(appendedSection.getX(), section.getX());
+  EXPECT_EQ(appendedSection.getSpeeds(), section.getSpeeds());
+  EXPECT_EQ(
+    appendedSection.getCurvilinearAbscissa().data(), section.getCurvilinearAbscissa().data());
+}
+
+//-----------------------------------------------------------------------------
+// Sections large enough to be split in chunks, with a few blank lines and CRLF
+std::string makeLargePathFileContent()
+{
+  std::string content = "ENU\n3\n";
+  for (size_t size : {100000, 20, 60001}) {
+    content += std::to_string(size) + " 3\n";
+    for (size_t n = 0; n < size; ++n) {
+      content += std::to_string(n * 0.1) + " " + std::to_string(std::sin(n * 0.01)) + " 1.5";
+      content += n % 997 == 0 ? "  \r\n\n" : "\n";
+    }
+  }
+  return content;
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPathFile, concurrentParsingGivesTheSameWayPoints)
+{
+  auto filename = writePathFile(makeLargePathFileContent());
+  romea::core::PathFile file(filename);
+  romea::core::PathFile concurrentFile(filename, 4);
+
+  const auto & wayPoints = file.getWayPoints();
+  const auto & concurrentWayPoints = concurrentFile.getWayPoints();
+  ASSERT_EQ(concurrentWayPoints.size(), wayPoints.size());
+  for (size_t i = 0; i < wayPoints.size(); ++i) {
+    ASSERT_EQ(concurrentWayPoints[i].size(), wayPoints[i].size());
+    for (size_t n = 0; n < wayPoints[i].size(); ++n) {
+      EXPECT_EQ(concurrentWayPoints[i][n].position, wayPoints[i][n].position);
+      EXPECT_EQ(concurrentWayPoints[i][n].desired_speed, wayPoints[i][n].desired_speed);
+    }
+  }
+  EXPECT_EQ(wayPoints[2].back().position.x(), 6000.);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPathFile, concurrentParsingReportsTheSameErrors)
+{
+  auto content = makeLargePathFileContent();
+
+  // first error in file order, with another one in a later chunk
+  auto withErrors = content;
+  withErrors.replace(withErrors.find("\n7000.0"), 7, "\n7000.x");
+  withErrors.replace(withErrors.find("\n9000.0"), 7, "\n9000 0");
+  auto error = loadingError(withErrors);
+  EXPECT_EQ(error.substr(error.find(':')), ":1: expected the x coordinate, got 7000.x00000");
+  EXPECT_EQ(loadingError(withErrors, 4), error);
+
+  // truncated in the last section, with or without a final newline
+  for (size_t size : {content.size() - 1000, content.rfind('\n'), content.rfind('\n') + 1}) {
+    auto truncated = content.substr(0, size);
+    EXPECT_EQ(loadingError(truncated, 4), loadingError(truncated));
+  }
+
+  // content after the last section
+  EXPECT_EQ(loadingError(content + "1 2 3\n", 4), loadingError(content + "1 2 3\n"));
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
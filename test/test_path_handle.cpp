@@ -0,0 +1,199 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <atomic>
+#include <thread>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_core_path/PathHandle.hpp"
+#include "romea_core_path/PathMatching2D.hpp"
+
+// local
+#include "../test/test_helper.h"
+#include "test_utils.hpp"
+
+
+class TestPathHandle : public ::testing::Test
+{
+public:
+  TestPathHandle() {}
+
+  void SetUp() override
+  {
+    wayPoints.resize(3);
+    wayPoints[0] = loadWayPoints("/path11.txt");
+    wayPoints[1] = loadWayPoints("/path12.txt");
+    wayPoints[2] = loadWayPoints("/path13.txt");
+
+    vehiclePose.position.x() = 18.3;
+    vehiclePose.position.y() = -4;
+    vehiclePose.yaw = 0.278;
+  }
+
+  romea::core::Path2D::WayPoints wayPoints;
+  romea::core::Pose2D vehiclePose;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathHandle, readersPinThePublishedVersion)
+{
+  romea::core::PathHandle handle;
+  auto reader = handle.makeReader();
+  EXPECT_EQ(reader.acquire(), nullptr);
+  EXPECT_EQ(handle.getGeneration(), 0);
+
+  EXPECT_EQ(handle.publish(romea::core::Path2D(wayPoints, 3)), 1);
+  const auto * version = reader.acquire();
+  ASSERT_NE(version, nullptr);
+  EXPECT_EQ(version->generation, 1);
+  EXPECT_EQ(version->path.size(), 3);
+
+  // the pinned version outlives its replacement until the reader leaves it
+  romea::core::Path2D::WayPoints firstSection(wayPoints.begin(), wayPoints.begin() + 1);
+  EXPECT_EQ(handle.publish(romea::core::Path2D(firstSection, 3)), 2);
+  EXPECT_EQ(handle.reclaim(), 1);
+  EXPECT_EQ(version->path.size(), 3);
+
+  version = reader.acquire();
+  EXPECT_EQ(version->generation, 2);
+  EXPECT_EQ(version->path.size(), 1);
+  EXPECT_EQ(handle.reclaim(), 0);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathHandle, numberOfReadersIsBounded)
+{
+  romea::core::PathHandle handle(2);
+  auto first = handle.makeReader();
+  {
+    auto second = handle.makeReader();
+    EXPECT_THROW(handle.makeReader(), std::runtime_error);
+  }
+  EXPECT_NO_THROW(handle.makeReader());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathHandle, trackedPointIsRemappedOnSharedGeometry)
+{
+  romea::core::Path2D path(wayPoints, 3);
+  auto matchedPoints = romea::core::match(path, vehiclePose, 1., 0.2, 10);
+  ASSERT_EQ(matchedPoints.size(), 1);
+  const auto & matchedPoint = matchedPoints.front();
+
+  // same geometry with new speeds
+  auto slowerWayPoints = wayPoints;
+  for (auto & sectionWayPoints : slowerWayPoints) {
+    for (auto & wayPoint : sectionWayPoints) {
+      wayPoint.desired_speed = 0.5;
+    }
+  }
+  romea::core::Path2D slowerPath(slowerWayPoints, 3);
+  auto remappedPoint = romea::core::remapMatchedPoint(matchedPoint, path, slowerPath);
+  ASSERT_TRUE(remappedPoint.has_value());
+  EXPECT_EQ(remappedPoint->sectionIndex, matchedPoint.sectionIndex);
+  EXPECT_EQ(remappedPoint->curveIndex, matchedPoint.curveIndex);
+  EXPECT_DOUBLE_EQ(remappedPoint->desiredSpeed, 0.5);
+
+  // a section inserted in front shifts the indexes and the abscissae
+  romea::core::Path2D::WayPoints extendedWayPoints = wayPoints;
+  extendedWayPoints.insert(extendedWayPoints.begin(), wayPoints[2]);
+  romea::core::Path2D extendedPath(extendedWayPoints, 3);
+  remappedPoint = romea::core::remapMatchedPoint(matchedPoint, path, extendedPath);
+  ASSERT_TRUE(remappedPoint.has_value());
+  EXPECT_EQ(remappedPoint->sectionIndex, matchedPoint.sectionIndex + 1);
+  EXPECT_EQ(remappedPoint->curveIndex, matchedPoint.curveIndex);
+
+  auto trackedPoints = romea::core::match(
+    extendedPath, vehiclePose, 1., *remappedPoint, 1., 0.2, 10);
+  ASSERT_FALSE(trackedPoints.empty());
+  EXPECT_EQ(trackedPoints.front().sectionIndex, remappedPoint->sectionIndex);
+  // the curves are fitted again on the shifted abscissae, hence the tolerance
+  EXPECT_NEAR(
+    trackedPoints.front().frenetPose.curvilinearAbscissa,
+    remappedPoint->frenetPose.curvilinearAbscissa, 1e-6);
+  EXPECT_NEAR(
+    trackedPoints.front().frenetPose.lateralDeviation,
+    matchedPoint.frenetPose.lateralDeviation, 1e-6);
+
+  // moved way points break the geometry
+  auto movedWayPoints = wayPoints;
+  for (auto & wayPoint : movedWayPoints[matchedPoint.sectionIndex]) {
+    wayPoint.position.y() += 0.01;
+  }
+  romea::core::Path2D movedPath(movedWayPoints, 3);
+  EXPECT_FALSE(romea::core::remapMatchedPoint(matchedPoint, path, movedPath).has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathHandle, readersStayConsistentUnderContinuousSwaps)
+{
+  romea::core::PathHandle handle;
+  const romea::core::Path2D longPath(wayPoints, 3);
+  const romea::core::Path2D shortPath(
+    romea::core::Path2D::WayPoints(wayPoints.begin(), wayPoints.begin() + 1), 3);
+  handle.publish(romea::core::Path2D(longPath));
+
+  // odd generations are the long path, even ones the short path
+  std::atomic<bool> stop = false;
+  std::thread writer([&]() {
+      for (size_t n = 0; !stop; ++n) {
+        handle.publish(romea::core::Path2D(n % 2 == 0 ? shortPath : longPath));
+      }
+    });
+
+  constexpr size_t NUMBER_OF_ACQUISITIONS = 20000;
+  auto read = [&](bool & consistent) {
+      auto reader = handle.makeReader();
+      std::uint64_t previousGeneration = 0;
+      for (size_t n = 0; n < NUMBER_OF_ACQUISITIONS; ++n) {
+        const auto * version = reader.acquire();
+
+        const auto & expectedPath = version->generation % 2 == 1 ? longPath : shortPath;
+        consistent = consistent &&
+          version->generation >= previousGeneration &&
+          version->path.size() == expectedPath.size() &&
+          version->path.getLength() == expectedPath.getLength();
+        if (n % 100 == 0) {
+          romea::core::match(version->path, vehiclePose, 1., 0.2, 10);
+        }
+        previousGeneration = version->generation;
+      }
+    };
+
+  // the acquire latency is measured by benchmark_path_handle
+  bool firstConsistent = true, secondConsistent = true;
+  std::thread firstReader(read, std::ref(firstConsistent));
+  std::thread secondReader(read, std::ref(secondConsistent));
+  firstReader.join();
+  secondReader.join();
+  stop = true;
+  writer.join();
+
+  EXPECT_TRUE(firstConsistent);
+  EXPECT_TRUE(secondConsistent);
+  EXPECT_GT(handle.getGeneration(), 2);
+  EXPECT_EQ(handle.reclaim(), 0);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,226 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_core_path/PathMatcher.hpp"
+#include "romea_core_path/PathMatching2D.hpp"
+
+// local
+#include "../test/test_helper.h"
+#include "test_utils.hpp"
+
+// Allocations made by the whole program, used to check the steady state of the matcher
+std::atomic<size_t> numberOfAllocations = 0;
+
+void * operator new(std::size_t size)
+{
+  ++numberOfAllocations;
+  if (void * data = std::malloc(size)) {
+    return data;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void * data) noexcept
+{
+  std::free(data);
+}
+
+void operator delete(void * data, std::size_t) noexcept
+{
+  std::free(data);
+}
+
+class TestPathMatcher : public ::testing::Test
+{
+public:
+  TestPathMatcher() {}
+
+  void SetUp() override
+  {
+    romea::core::Path2D::WayPoints wayPoints(3);
+    wayPoints[0] = loadWayPoints("/path11.txt");
+    wayPoints[1] = loadWayPoints("/path12.txt");
+    wayPoints[2] = loadWayPoints("/path13.txt");
+    path = std::make_unique<romea::core::Path2D>(wayPoints, 3);
+  }
+
+  // Pose on the way point n of a section, the vehicle driving along the path
+  romea::core::Pose2D wayPointPose(size_t sectionIndex, size_t n)
+  {
+    const auto & section = path->getSection(sectionIndex);
+    size_t next = std::min(n + 1, section.size() - 1);
+    size_t previous = next - 1;
+
+    romea::core::Pose2D pose;
+    pose.position.x() = section.getX()[n];
+    pose.position.y() = section.getY()[n] + 0.05;
+    pose.yaw = std::atan2(
+      section.getY()[next] - section.getY()[previous],
+      section.getX()[next] - section.getX()[previous]);
+    return pose;
+  }
+
+  std::unique_ptr<romea::core::Path2D> path;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathMatcher, globalMatchThenTrackedMatches)
+{
+  romea::core::PathMatcher matcher(*path);
+  EXPECT_FALSE(matcher.isTracking());
+
+  romea::core::Pose2D firstPose;
+  firstPose.position = Eigen::Vector2d(18.3, -4);
+  firstPose.yaw = 0.278;
+  const auto & firstMatchedPoints = matcher.match(firstPose, 1., 0.);
+  auto expectedFirstMatchedPoints = romea::core::match(*path, firstPose, 1., 0.2, 10);
+  ASSERT_EQ(firstMatchedPoints.size(), expectedFirstMatchedPoints.size());
+  ASSERT_TRUE(matcher.isTracking());
+  EXPECT_EQ(matcher.getTrackedPoint()->curveIndex, expectedFirstMatchedPoints[0].curveIndex);
+
+  // two seconds at 1 m/s, an 8 m interval is searched around the tracked point
+  romea::core::Pose2D secondPose;
+  secondPose.position = Eigen::Vector2d(22.1, -4);
+  secondPose.yaw = -0.4;
+  auto expectedSecondMatchedPoints = romea::core::match(
+    *path, secondPose, 1., expectedFirstMatchedPoints[0], 8., 0.2, 10);
+  const auto & secondMatchedPoints = matcher.match(secondPose, 1., 2.);
+  ASSERT_EQ(secondMatchedPoints.size(), expectedSecondMatchedPoints.size());
+  ASSERT_FALSE(secondMatchedPoints.empty());
+  EXPECT_EQ(secondMatchedPoints[0].curveIndex, 225);
+  // found by Newton steps from the tracked point instead of the closed form solution
+  EXPECT_NEAR(
+    secondMatchedPoints[0].frenetPose.curvilinearAbscissa,
+    expectedSecondMatchedPoints[0].frenetPose.curvilinearAbscissa, 1e-9);
+
+  // lost when the vehicle leaves the path, located again by a global match
+  romea::core::Pose2D farPose;
+  farPose.position = Eigen::Vector2d(1000., 1000.);
+  EXPECT_TRUE(matcher.match(farPose, 1., 2.1).empty());
+  EXPECT_FALSE(matcher.isTracking());
+  EXPECT_FALSE(matcher.match(secondPose, 1., 2.2).empty());
+  EXPECT_TRUE(matcher.isTracking());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathMatcher, globalMatchingOnLossLocatesAJumpInTheSameCall)
+{
+  romea::core::PathMatcherParameters parameters;
+  parameters.globalMatchingOnLoss = true;
+  romea::core::PathMatcher matcher(*path, parameters);
+  romea::core::PathMatcher lazyMatcher(*path);
+
+  auto firstPose = wayPointPose(0, 10);
+  ASSERT_FALSE(matcher.match(firstPose, 1., 0.).empty());
+  ASSERT_FALSE(lazyMatcher.match(firstPose, 1., 0.).empty());
+
+  // the vehicle jumps far along the path, out of the tracked interval
+  auto jumpPose = wayPointPose(0, path->getSection(0).size() - 10);
+  EXPECT_TRUE(lazyMatcher.match(jumpPose, 1., 0.1).empty());
+  const auto & matchedPoints = matcher.match(jumpPose, 1., 0.1);
+  ASSERT_FALSE(matchedPoints.empty());
+  EXPECT_EQ(matchedPoints[0].sectionIndex, 0);
+  EXPECT_NEAR(matchedPoints[0].curveIndex, path->getSection(0).size() - 10, 1);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathMatcher, newtonWarmStartFollowsTheTrackedMatch)
+{
+  romea::core::PathMatcherParameters parameters;
+  parameters.newtonWarmStart = false;
+  romea::core::PathMatcher trackedMatcher(*path, parameters);
+  romea::core::PathMatcher warmStartedMatcher(*path);
+
+  const auto & section = path->getSection(0);
+  double stamp = 0;
+  for (size_t n = 0; n + 1 < section.size(); ++n, stamp += 0.1) {
+    auto pose = wayPointPose(0, n);
+    const auto & expectedMatchedPoints = trackedMatcher.match(pose, 1., stamp);
+    const auto & matchedPoints = warmStartedMatcher.match(pose, 1., stamp);
+    ASSERT_EQ(matchedPoints.size(), expectedMatchedPoints.size());
+    ASSERT_FALSE(matchedPoints.empty());
+
+    const auto & expected = expectedMatchedPoints.front();
+    const auto & matchedPoint = matchedPoints.front();
+    EXPECT_EQ(matchedPoint.sectionIndex, expected.sectionIndex);
+    EXPECT_NEAR(matchedPoint.curveIndex, expected.curveIndex, 1);
+    EXPECT_NEAR(
+      matchedPoint.frenetPose.curvilinearAbscissa, expected.frenetPose.curvilinearAbscissa, 1e-3);
+    EXPECT_NEAR(
+      matchedPoint.frenetPose.lateralDeviation, expected.frenetPose.lateralDeviation, 1e-3);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathMatcher, steadyStateDoesNotAllocate)
+{
+  romea::core::PathMatcher matcher(*path);
+  const auto & section = path->getSection(0);
+
+  // warm-up, the buffers grow to their final size
+  double stamp = 0;
+  ASSERT_FALSE(matcher.match(wayPointPose(0, 0), 1., stamp).empty());
+
+  size_t numberOfMatchedPoses = 0;
+  size_t allocationsBefore = numberOfAllocations;
+  for (size_t n = 1; n + 1 < section.size(); ++n) {
+    stamp += 0.1;
+    numberOfMatchedPoses += !matcher.match(wayPointPose(0, n), 1., stamp).empty();
+  }
+  size_t allocationsAfter = numberOfAllocations;
+
+  EXPECT_EQ(numberOfMatchedPoses, section.size() - 2);
+  EXPECT_EQ(allocationsAfter, allocationsBefore);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathMatcher, trackedPointFollowsThePathSwap)
+{
+  romea::core::PathMatcher matcher(*path);
+  ASSERT_FALSE(matcher.match(wayPointPose(2, 20), 1., 0.).empty());
+  size_t curveIndex = matcher.getTrackedPoint()->curveIndex;
+
+  romea::core::Path2D::WayPoints wayPoints(2);
+  wayPoints[0] = loadWayPoints("/path12.txt");
+  wayPoints[1] = loadWayPoints("/path13.txt");
+  romea::core::Path2D newPath(wayPoints, 3);
+
+  matcher.setPath(newPath);
+  ASSERT_TRUE(matcher.isTracking());
+  EXPECT_EQ(matcher.getTrackedPoint()->sectionIndex, 1);
+  EXPECT_EQ(matcher.getTrackedPoint()->curveIndex, curveIndex);
+
+  const auto & matchedPoints = matcher.match(wayPointPose(2, 21), 1., 0.1);
+  ASSERT_FALSE(matchedPoints.empty());
+  EXPECT_EQ(matchedPoints[0].sectionIndex, 1);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -381,6 +381,131 @@ TEST_F(TestPathMatching, localMatchingFailedWhenPositionIsTooFarFromTheLastMatch
 //}
 
 
+//-----------------------------------------------------------------------------
+TEST_F(TestPathMatching, outwardSearchProbesTheSameNeighbouringSections)
+{
+  load("path1");
+  const auto & section = path->getSection(0);
+  for (size_t n = section.size() - 20; n < section.size(); n += 3) {
+    romea::core::Pose2D vehiclePose;
+    vehiclePose.position = Eigen::Vector2d(section.getX()[n], section.getY()[n]);
+    vehiclePose.yaw = section.getCurve(n).computeTangent(section.getCurvilinearAbscissa()[n]);
+
+    double s = section.getCurvilinearAbscissa()[n];
+    romea::core::Interval<double> interval(s - 5., s + 5.);
+    auto expected = match(
+      *path, vehiclePose, 1., 0, n, interval, timeHorizon, maximalRadiusResearch);
+    auto matchedPoints = match(
+      *path, vehiclePose, 1., 0, n, interval, timeHorizon, maximalRadiusResearch, true, true);
+
+    ASSERT_EQ(matchedPoints.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(matchedPoints[i].sectionIndex, expected[i].sectionIndex);
+      EXPECT_EQ(matchedPoints[i].curveIndex, expected[i].curveIndex);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathMatching, compactMatchedPointsKeepMatchingResults)
+{
+  load("path1");
+  romea::core::Pose2D vehiclePose;
+  vehiclePose.position.x() = 22.1;
+  vehiclePose.position.y() = -4;
+  vehiclePose.yaw = -0.4;
+
+  auto matchedPoints = match(*path, vehiclePose, 1., timeHorizon, maximalRadiusResearch);
+  ASSERT_EQ(matchedPoints.size(), 1);
+
+  std::vector<romea::core::PathCompactMatchedPoint2D> compactMatchedPoints(4);
+  romea::core::compact(matchedPoints, compactMatchedPoints);
+  ASSERT_EQ(compactMatchedPoints.size(), 1);
+
+  const auto & matchedPoint = matchedPoints.front();
+  const auto & compactMatchedPoint = compactMatchedPoints.front();
+  EXPECT_EQ(compactMatchedPoint.x, matchedPoint.pathPosture.position.x());
+  EXPECT_EQ(compactMatchedPoint.course, matchedPoint.pathPosture.course);
+  EXPECT_EQ(
+    compactMatchedPoint.frenetPose.lateralDeviation, matchedPoint.frenetPose.lateralDeviation);
+  EXPECT_EQ(compactMatchedPoint.sectionIndex, matchedPoint.sectionIndex);
+  EXPECT_EQ(compactMatchedPoint.curveIndex, matchedPoint.curveIndex);
+  EXPECT_EQ(direction(compactMatchedPoint), direction(matchedPoint));
+  EXPECT_TRUE(globalPosition(compactMatchedPoint).isApprox(globalPosition(matchedPoint)));
+
+  auto restoredMatchedPoint = toMatchedPoint(compactMatchedPoint);
+  EXPECT_EQ(restoredMatchedPoint.pathPosture.position, matchedPoint.pathPosture.position);
+  EXPECT_EQ(
+    restoredMatchedPoint.frenetPose.courseDeviation, matchedPoint.frenetPose.courseDeviation);
+  EXPECT_EQ(restoredMatchedPoint.futureCurvature, matchedPoint.futureCurvature);
+  EXPECT_EQ(restoredMatchedPoint.curveIndex, matchedPoint.curveIndex);
+
+  const auto * first = compactMatchedPoints.data();
+  const auto * last = first + compactMatchedPoints.size();
+  EXPECT_EQ(findMatchedPointBySectionIndex(first, last, matchedPoint.sectionIndex), first);
+  EXPECT_EQ(findMatchedPointBySectionIndex(first, last, matchedPoint.sectionIndex + 1), nullptr);
+  EXPECT_EQ(
+    findMatchedPointBySectionIndex(
+      matchedPoints.data(), matchedPoints.data() + 1, matchedPoint.sectionIndex),
+    matchedPoints.data());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathMatching, compactMatchingWritesTheSameResults)
+{
+  load("path1");
+  romea::core::Pose2D vehiclePose;
+  vehiclePose.position.x() = 22.1;
+  vehiclePose.position.y() = -4;
+  vehiclePose.yaw = -0.4;
+
+  auto matchedPoints = match(*path, vehiclePose, 1., timeHorizon, maximalRadiusResearch);
+  std::vector<romea::core::PathCompactMatchedPoint2D> compactMatchedPoints;
+  std::vector<size_t> sectionIndexes;
+  match(
+    *path, vehiclePose, 1., timeHorizon, maximalRadiusResearch,
+    compactMatchedPoints, sectionIndexes);
+  ASSERT_EQ(matchedPoints.size(), 1);
+  ASSERT_EQ(compactMatchedPoints.size(), 1);
+  EXPECT_EQ(compactMatchedPoints[0].sectionIndex, matchedPoints[0].sectionIndex);
+  EXPECT_EQ(compactMatchedPoints[0].curveIndex, matchedPoints[0].curveIndex);
+  EXPECT_EQ(
+    compactMatchedPoints[0].frenetPose.curvilinearAbscissa,
+    matchedPoints[0].frenetPose.curvilinearAbscissa);
+  EXPECT_EQ(
+    compactMatchedPoints[0].frenetPose.lateralDeviation,
+    matchedPoints[0].frenetPose.lateralDeviation);
+  EXPECT_EQ(compactMatchedPoints[0].futureCurvature, matchedPoints[0].futureCurvature);
+
+  // tracked matching across a section change
+  for (double x = 22.1; x < 40.; x += 0.5) {
+    vehiclePose.position.x() = x;
+    const auto & previousMatchedPoint = matchedPoints.front();
+    romea::core::Interval<double> interval(
+      previousMatchedPoint.frenetPose.curvilinearAbscissa - 1.,
+      previousMatchedPoint.frenetPose.curvilinearAbscissa + 1.);
+    auto trackedMatchedPoints = match(
+      *path, vehiclePose, 1., previousMatchedPoint.sectionIndex,
+      previousMatchedPoint.curveIndex, interval, timeHorizon, maximalRadiusResearch);
+    match(
+      *path, vehiclePose, 1., previousMatchedPoint.sectionIndex,
+      previousMatchedPoint.curveIndex, interval, timeHorizon, maximalRadiusResearch,
+      compactMatchedPoints);
+
+    ASSERT_EQ(compactMatchedPoints.size(), trackedMatchedPoints.size());
+    for (size_t i = 0; i < trackedMatchedPoints.size(); ++i) {
+      EXPECT_EQ(compactMatchedPoints[i].sectionIndex, trackedMatchedPoints[i].sectionIndex);
+      EXPECT_EQ(
+        compactMatchedPoints[i].frenetPose.lateralDeviation,
+        trackedMatchedPoints[i].frenetPose.lateralDeviation);
+    }
+    if (trackedMatchedPoints.empty()) {
+      break;
+    }
+    matchedPoints = trackedMatchedPoints;
+  }
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
 {
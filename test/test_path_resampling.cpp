@@ -0,0 +1,223 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_core_path/PathMatching2D.hpp"
+#include "romea_core_path/PathResampling.hpp"
+
+// local
+#include "../test/test_helper.h"
+#include "test_utils.hpp"
+
+//-----------------------------------------------------------------------------
+// Distance between a position and a polyline
+double distanceToPolyline(
+  const Eigen::Vector2d & position,
+  const std::vector<romea::core::PathWayPoint2D> & wayPoints)
+{
+  double distance = std::numeric_limits<double>::max();
+  for (size_t n = 0; n + 1 < wayPoints.size(); ++n) {
+    Eigen::Vector2d a = wayPoints[n].position;
+    Eigen::Vector2d ab = wayPoints[n + 1].position - a;
+    double t = std::clamp((position - a).dot(ab) / ab.squaredNorm(), 0., 1.);
+    distance = std::min(distance, (position - a - t * ab).norm());
+  }
+  return distance;
+}
+
+//-----------------------------------------------------------------------------
+// Reference lookups walking over the abscissae
+size_t findIndexByWalking(const romea::core::PathSection2D & section, const double & value)
+{
+  const auto & S = section.getCurvilinearAbscissa();
+  size_t n = 0;
+  while (n < S.size() - 1 && S[n] < value) {
+    n++;
+  }
+  return n;
+}
+
+//-----------------------------------------------------------------------------
+class TestPathResampling : public ::testing::Test
+{
+public:
+  TestPathResampling() {}
+
+  void SetUp() override
+  {
+    // irregular GNSS like spacing on a line followed by a headland turn
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> spacing(0.05, 0.3);
+    double x = 0;
+    while (x < 20.) {
+      wayPoints.push_back({Eigen::Vector2d(x, 0.), 1.});
+      x += spacing(generator);
+    }
+    for (double a = -M_PI_2; a < M_PI_2; a += spacing(generator) / radius) {
+      wayPoints.push_back({center + radius * Eigen::Vector2d(std::cos(a), std::sin(a)), 1.});
+    }
+  }
+
+  Eigen::Vector2d center{20., 4.};
+  double radius = 4.;
+  std::vector<romea::core::PathWayPoint2D> wayPoints;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathResampling, resampledSectionHasUniformSpacing)
+{
+  romea::core::PathSection2D section(3.);
+  section.addWayPoints(wayPoints);
+  EXPECT_EQ(section.getUniformStep(), 0.);
+
+  auto resampledWayPoints = romea::core::resampleWayPoints(wayPoints, 0.25, 3.);
+  romea::core::PathSection2D resampledSection(3.);
+  resampledSection.addWayPoints(resampledWayPoints);
+  EXPECT_NEAR(resampledSection.getUniformStep(), 0.25, 1e-9);
+  EXPECT_NEAR(resampledSection.getLength(), section.getLength(), 0.25);
+  EXPECT_EQ(resampledWayPoints.front().position, wayPoints.front().position);
+  EXPECT_EQ(resampledWayPoints.back().position, wayPoints.back().position);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathResampling, closedLoopIsResampledOverItsWholeLength)
+{
+  std::vector<romea::core::PathWayPoint2D> loop;
+  for (size_t n = 0; n <= 200; ++n) {
+    double a = 2 * M_PI * n / 200.;
+    loop.push_back({10. * Eigen::Vector2d(std::cos(a), std::sin(a)), 1.});
+  }
+
+  auto resampledWayPoints = romea::core::resampleWayPoints(loop, 0.5, 3.);
+  romea::core::PathSection2D resampledSection(3.);
+  resampledSection.addWayPoints(resampledWayPoints);
+  EXPECT_NEAR(resampledWayPoints.size(), 2 * M_PI * 10. / 0.5 + 1, 1.);
+  EXPECT_NEAR(resampledSection.getUniformStep(), 0.5, 1e-9);
+  EXPECT_NEAR(resampledSection.getLength(), 2 * M_PI * 10., 0.5);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathResampling, resampledSectionStaysCloseToTheOriginalOne)
+{
+  auto resampledWayPoints = romea::core::resampleWayPoints(wayPoints, 0.25, 3.);
+
+  // chord sagitta on the turn 0.25^2 / (8 * 4) ~ 2 mm plus the fitting error, which
+  // grows within half a window of the curvature jump between the line and the turn
+  auto tolerance = [this](const Eigen::Vector2d & position) {
+      return (position - Eigen::Vector2d(20., 0.)).norm() < 1.5 ? 2e-2 : 5e-3;
+    };
+  for (const auto & wayPoint : wayPoints) {
+    EXPECT_LT(
+      distanceToPolyline(wayPoint.position, resampledWayPoints), tolerance(wayPoint.position));
+  }
+  for (const auto & wayPoint : resampledWayPoints) {
+    EXPECT_LT(distanceToPolyline(wayPoint.position, wayPoints), tolerance(wayPoint.position));
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathResampling, uniformLookupsMatchTheWalkingOnes)
+{
+  romea::core::PathSection2D section(3.);
+  section.addWayPoints(romea::core::resampleWayPoints(wayPoints, 0.25, 3.));
+  ASSERT_GT(section.getUniformStep(), 0.);
+  const auto & S = section.getCurvilinearAbscissa();
+
+  for (double value = -1.; value < section.getLength() + 1.; value += 0.0173) {
+    EXPECT_EQ(section.findIndex(value), findIndexByWalking(section, value));
+  }
+
+  // values on the way points themselves
+  for (size_t n = 0; n < section.size(); ++n) {
+    EXPECT_EQ(section.findIndex(S[n]), findIndexByWalking(section, S[n]));
+    EXPECT_EQ(section.findIndex(S[n], n / 2), n);
+  }
+
+  for (size_t center = 0; center < section.size(); center += 7) {
+    for (double width : {0.1, 0.25, 1., 3., 100.}) {
+      romea::core::Interval<double> interval(S[center] - width / 3., S[center] + width);
+
+      size_t minimalIndex = center;
+      while (minimalIndex != 0 && interval.inside(S[minimalIndex])) {
+        minimalIndex--;
+      }
+      size_t maximalIndex = center;
+      while (maximalIndex != section.size() - 1 && interval.inside(S[maximalIndex])) {
+        maximalIndex++;
+      }
+
+      auto indexes = section.findIntervalBoundIndexes(center, interval);
+      EXPECT_EQ(indexes.lower(), minimalIndex);
+      EXPECT_EQ(indexes.upper(), maximalIndex);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathResampling, resampledPathKeepsAnnotationsAndMatching)
+{
+  romea::core::Path2D::WayPoints pathWayPoints(3);
+  pathWayPoints[0] = loadWayPoints("/path11.txt");
+  pathWayPoints[1] = loadWayPoints("/path12.txt");
+  pathWayPoints[2] = loadWayPoints("/path13.txt");
+
+  // the last point of the first section
+  size_t annotatedIndex = pathWayPoints[0].size() - 1;
+  nlohmann::json data;
+  data["type"] = "zone_enter";
+  data["value"] = "headland";
+  data["point_index"] = annotatedIndex;
+  romea::core::Path2D::Annotations annotations;
+  annotations.emplace(annotatedIndex, romea::core::PathAnnotation(data));
+
+  romea::core::Path2D path(pathWayPoints, 3, annotations);
+  auto resampledPath = romea::core::resamplePath(pathWayPoints, 0.2, 3, annotations);
+  ASSERT_EQ(resampledPath.size(), path.size());
+  EXPECT_NEAR(resampledPath.getLength(), path.getLength(), 0.1);
+  EXPECT_GT(resampledPath.getSection(0).getUniformStep(), 0.);
+
+  ASSERT_EQ(resampledPath.getAnnotations().size(), 1);
+  const auto & [index, annotation] = *resampledPath.getAnnotations().begin();
+  EXPECT_EQ(index, resampledPath.getSection(0).size() - 1);
+  EXPECT_EQ(annotation.point_index, index);
+  EXPECT_NEAR(annotation.abscissa, resampledPath.getSection(0).getLength(), 1e-9);
+
+  romea::core::Pose2D vehiclePose;
+  vehiclePose.position = Eigen::Vector2d(18.3, -4);
+  vehiclePose.yaw = 0.278;
+  auto matchedPoints = romea::core::match(path, vehiclePose, 1., 0.2, 10);
+  auto resampledMatchedPoints = romea::core::match(resampledPath, vehiclePose, 1., 0.2, 10);
+  ASSERT_EQ(resampledMatchedPoints.size(), matchedPoints.size());
+  ASSERT_FALSE(matchedPoints.empty());
+  EXPECT_NEAR(
+    resampledMatchedPoints[0].frenetPose.lateralDeviation,
+    matchedPoints[0].frenetPose.lateralDeviation, 1e-2);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,203 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_core_path/PathMatching2D.hpp"
+#include "romea_core_path/PathSerialization.hpp"
+
+// local
+#include "../test/test_helper.h"
+#include "test_utils.hpp"
+
+
+class TestPathSerialization : public ::testing::Test
+{
+public:
+  TestPathSerialization() {}
+
+  void SetUp() override
+  {
+    wayPoints.resize(3);
+    wayPoints[0] = loadWayPoints("/path11.txt");
+    wayPoints[1] = loadWayPoints("/path12.txt");
+    wayPoints[2] = loadWayPoints("/path13.txt");
+
+    nlohmann::json data;
+    data["type"] = "zone_enter";
+    data["value"] = "headland";
+    data["point_index"] = 42;
+    annotations.emplace(42, romea::core::PathAnnotation(data));
+
+    hash = romea::core::computePathHash(wayPoints, 3, annotations);
+    path = std::make_unique<romea::core::Path2D>(wayPoints, 3, annotations);
+  }
+
+  romea::core::Path2D::WayPoints wayPoints;
+  romea::core::Path2D::Annotations annotations;
+  std::unique_ptr<romea::core::Path2D> path;
+  std::uint64_t hash;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathSerialization, hashDependsOnInputs)
+{
+  EXPECT_EQ(romea::core::computePathHash(wayPoints, 3, annotations), hash);
+  EXPECT_NE(romea::core::computePathHash(wayPoints, 2.5, annotations), hash);
+  EXPECT_NE(romea::core::computePathHash(wayPoints, 3), hash);
+
+  wayPoints[1][5].desired_speed += 0.1;
+  EXPECT_NE(romea::core::computePathHash(wayPoints, 3, annotations), hash);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathSerialization, roundTripRestoresCurvesAndMatching)
+{
+  std::stringstream blob;
+  romea::core::savePath(blob, *path, hash);
+  auto loaded = romea::core::loadPath(blob, hash);
+  ASSERT_TRUE(loaded.has_value());
+
+  ASSERT_EQ(loaded->size(), path->size());
+  EXPECT_DOUBLE_EQ(loaded->getLength(), path->getLength());
+  EXPECT_DOUBLE_EQ(loaded->getInterpolationWindowLength(), 3.);
+  for (size_t i = 0; i < path->size(); ++i) {
+    const auto & section = path->getSection(i);
+    const auto & loadedSection = loaded->getSection(i);
+    ASSERT_EQ(loadedSection.size(), section.size());
+    EXPECT_EQ(loadedSection.getInitialPointIndex(), section.getInitialPointIndex());
+    for (size_t n = 0; n < section.size(); ++n) {
+      const auto & curve = section.getCurve(n);
+      const auto & loadedCurve = loadedSection.getCurve(n);
+      EXPECT_EQ(loadedCurve.getIndexInterval().lower(), curve.getIndexInterval().lower());
+      EXPECT_EQ(loadedCurve.getIndexInterval().upper(), curve.getIndexInterval().upper());
+      EXPECT_DOUBLE_EQ(loadedCurve.computeX(section.getCurvilinearAbscissa()[n]),
+        curve.computeX(section.getCurvilinearAbscissa()[n]));
+      EXPECT_DOUBLE_EQ(loadedCurve.computeCurvature(section.getCurvilinearAbscissa()[n]),
+        curve.computeCurvature(section.getCurvilinearAbscissa()[n]));
+    }
+  }
+
+  ASSERT_EQ(loaded->getAnnotations().size(), 1);
+  EXPECT_EQ(loaded->getAnnotations().begin()->first, 42);
+  EXPECT_EQ(loaded->getAnnotations().begin()->second.type, "zone_enter");
+  EXPECT_EQ(loaded->getAnnotations().begin()->second.value, "headland");
+
+  romea::core::Pose2D vehiclePose;
+  vehiclePose.position.x() = 18.3;
+  vehiclePose.position.y() = -4;
+  vehiclePose.yaw = 0.278;
+  auto matchedPoints = romea::core::match(*path, vehiclePose, 0.8, 0.2, 10);
+  auto loadedMatchedPoints = romea::core::match(*loaded, vehiclePose, 0.8, 0.2, 10);
+  ASSERT_EQ(loadedMatchedPoints.size(), matchedPoints.size());
+  for (size_t i = 0; i < matchedPoints.size(); ++i) {
+    EXPECT_EQ(loadedMatchedPoints[i].curveIndex, matchedPoints[i].curveIndex);
+    EXPECT_DOUBLE_EQ(loadedMatchedPoints[i].frenetPose.curvilinearAbscissa,
+      matchedPoints[i].frenetPose.curvilinearAbscissa);
+    EXPECT_DOUBLE_EQ(loadedMatchedPoints[i].frenetPose.lateralDeviation,
+      matchedPoints[i].frenetPose.lateralDeviation);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathSerialization, loadFailsWhenHashDiffers)
+{
+  std::stringstream blob;
+  romea::core::savePath(blob, *path, hash);
+  EXPECT_FALSE(romea::core::loadPath(blob, hash + 1).has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathSerialization, loadFailsWhenBlobIsTruncated)
+{
+  std::stringstream blob;
+  romea::core::savePath(blob, *path, hash);
+  std::string data = blob.str();
+
+  std::stringstream truncated(data.substr(0, data.size() / 2));
+  EXPECT_FALSE(romea::core::loadPath(truncated, hash).has_value());
+
+  std::stringstream garbage("not a path");
+  EXPECT_FALSE(romea::core::loadPath(garbage, hash).has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathSerialization, loadFailsWhenCurvesAreInvalid)
+{
+  std::stringstream blob;
+  romea::core::savePath(blob, *path, hash);
+  std::string data = blob.str();
+
+  // magic, version, hash and interpolation window length come before the degree
+  const size_t degreeOffset = 8 + 4 + 8 + 8;
+  // then the number of sections and the number of way points of the first one
+  const size_t firstCurveOffset = degreeOffset + 8 + 8 + 8 + 3 * 8 * wayPoints[0].size();
+  const size_t curveDegreeOffset = firstCurveOffset + 8 * 8;
+  const size_t curveIndexIntervalOffset = curveDegreeOffset + 8 + 2 * 8 + 8;
+
+  auto load = [&](const size_t & offset, const std::uint64_t & value) {
+      std::string corrupted = data;
+      corrupted.replace(offset, sizeof(value), reinterpret_cast<const char *>(&value), 8);
+      std::stringstream is(corrupted);
+      return romea::core::loadPath(is, hash);
+    };
+
+  auto loaded = load(degreeOffset, 3);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->getPolynomialDegree(), 3u);
+  EXPECT_FALSE(load(degreeOffset, 7).has_value());
+
+  EXPECT_TRUE(load(curveDegreeOffset, 3).has_value());
+  EXPECT_FALSE(load(curveDegreeOffset, 0).has_value());
+  EXPECT_FALSE(load(curveIndexIntervalOffset, wayPoints[0].size()).has_value());
+  EXPECT_FALSE(load(curveIndexIntervalOffset + 8, wayPoints[0].size()).has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathSerialization, loadOrBuildPathWritesThenReadsCache)
+{
+  std::string filename = ::testing::TempDir() + "romea_path_cache.bin";
+  std::remove(filename.c_str());
+
+  auto built = romea::core::loadOrBuildPath(filename, wayPoints, 3, annotations);
+  std::ifstream cache(filename, std::ios::binary);
+  ASSERT_TRUE(cache.is_open());
+  ASSERT_TRUE(romea::core::loadPath(cache, hash).has_value());
+
+  auto loaded = romea::core::loadOrBuildPath(filename, wayPoints, 3, annotations);
+  EXPECT_EQ(loaded.size(), built.size());
+  EXPECT_DOUBLE_EQ(loaded.getLength(), built.getLength());
+
+  // a stale cache is rebuilt with the new inputs
+  auto rebuilt = romea::core::loadOrBuildPath(filename, wayPoints, 2, annotations);
+  EXPECT_DOUBLE_EQ(rebuilt.getInterpolationWindowLength(), 2.);
+
+  std::remove(filename.c_str());
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
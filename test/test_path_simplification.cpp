@@ -0,0 +1,223 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_core_path/PathMatching2D.hpp"
+#include "romea_core_path/PathSimplification.hpp"
+
+// local
+#include "../test/test_helper.h"
+#include "test_utils.hpp"
+
+//-----------------------------------------------------------------------------
+// Distance between a position and a polyline
+double distanceToPolyline(
+  const Eigen::Vector2d & position,
+  const std::vector<romea::core::PathWayPoint2D> & wayPoints)
+{
+  double distance = (position - wayPoints.front().position).norm();
+  for (size_t n = 0; n + 1 < wayPoints.size(); ++n) {
+    Eigen::Vector2d a = wayPoints[n].position;
+    Eigen::Vector2d ab = wayPoints[n + 1].position - a;
+    double t = std::clamp((position - a).dot(ab) / ab.squaredNorm(), 0., 1.);
+    distance = std::min(distance, (position - a - t * ab).norm());
+  }
+  return distance;
+}
+
+//-----------------------------------------------------------------------------
+class TestPathSimplification : public ::testing::Test
+{
+public:
+  TestPathSimplification() {}
+
+  void SetUp() override
+  {
+    // 20 Hz recording at 1 m/s with a few millimetres of noise: a row, a
+    // headland turn at half speed and a row back
+    std::mt19937 generator(42);
+    std::normal_distribution<double> noise(0., 0.003);
+    auto add = [&](const Eigen::Vector2d & position, double speed) {
+        Eigen::Vector2d error(noise(generator), noise(generator));
+        wayPoints.push_back({position + error, speed});
+      };
+    for (double x = 0; x < 50.; x += 0.05) {
+      add(Eigen::Vector2d(x, 0.), 1.);
+    }
+    for (double a = -M_PI_2; a < M_PI_2; a += 0.05 / radius) {
+      add(Eigen::Vector2d(50., radius) + radius * Eigen::Vector2d(std::cos(a), std::sin(a)), 0.5);
+    }
+    for (double x = 50.; x > 0.; x -= 0.05) {
+      add(Eigen::Vector2d(x, 2. * radius), 1.);
+    }
+  }
+
+  double radius = 4.;
+  std::vector<romea::core::PathWayPoint2D> wayPoints;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathSimplification, removedWayPointsStayWithinTolerance)
+{
+  romea::core::PathSimplificationParameters parameters;
+  parameters.tolerance = 0.02;
+  auto indexes = romea::core::findSimplifiedWayPointIndexes(wayPoints, parameters);
+  auto simplifiedWayPoints = romea::core::simplifyWayPoints(wayPoints, parameters);
+  ASSERT_EQ(simplifiedWayPoints.size(), indexes.size());
+  EXPECT_LT(simplifiedWayPoints.size() * 4, wayPoints.size());
+  EXPECT_EQ(indexes.front(), 0);
+  EXPECT_EQ(indexes.back(), wayPoints.size() - 1);
+
+  for (size_t i = 0; i + 1 < indexes.size(); ++i) {
+    double spacing = 0;
+    for (size_t n = indexes[i]; n < indexes[i + 1]; ++n) {
+      spacing += (wayPoints[n + 1].position - wayPoints[n].position).norm();
+    }
+    EXPECT_LE(spacing, parameters.maximalSpacing);
+  }
+
+  for (const auto & wayPoint : wayPoints) {
+    EXPECT_LE(distanceToPolyline(wayPoint.position, simplifiedWayPoints), parameters.tolerance);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathSimplification, speedChangesAndRequiredIndexesAreKept)
+{
+  std::vector<size_t> requiredIndexes = {123, 2000};
+  auto indexes = romea::core::findSimplifiedWayPointIndexes(
+    wayPoints, romea::core::PathSimplificationParameters(), requiredIndexes);
+
+  auto isKept = [&indexes](size_t index) {
+      return std::binary_search(indexes.begin(), indexes.end(), index);
+    };
+  for (size_t n = 1; n < wayPoints.size(); ++n) {
+    if (wayPoints[n].desired_speed != wayPoints[n - 1].desired_speed) {
+      EXPECT_TRUE(isKept(n - 1));
+      EXPECT_TRUE(isKept(n));
+    }
+  }
+  EXPECT_TRUE(isKept(123));
+  EXPECT_TRUE(isKept(2000));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathSimplification, speedStepOnlyKeepsTheWayPointsAroundIt)
+{
+  std::vector<romea::core::PathWayPoint2D> lineWayPoints;
+  for (size_t n = 0; n < 1001; ++n) {
+    lineWayPoints.push_back({Eigen::Vector2d(0.05 * n, 0.), 1.});
+  }
+
+  romea::core::PathSimplificationParameters parameters;
+  size_t constantSpeedSize =
+    romea::core::findSimplifiedWayPointIndexes(lineWayPoints, parameters).size();
+
+  for (size_t n = 500; n < lineWayPoints.size(); ++n) {
+    lineWayPoints[n].desired_speed = 0.5;
+  }
+  EXPECT_LE(
+    romea::core::findSimplifiedWayPointIndexes(lineWayPoints, parameters).size(),
+    constantSpeedSize + 2);
+
+  parameters.maximalSpacing = 100.;
+  auto indexes = romea::core::findSimplifiedWayPointIndexes(lineWayPoints, parameters);
+  EXPECT_EQ(indexes, std::vector<size_t>({0, 499, 500, 1000}));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathSimplification, speedToleranceBoundsTheSpeedOfRemovedWayPoints)
+{
+  // the desired speed of this recording changes at each way point
+  auto recordedWayPoints = loadWayPoints("/path21.txt");
+  romea::core::PathSimplificationParameters parameters;
+  EXPECT_EQ(
+    romea::core::findSimplifiedWayPointIndexes(recordedWayPoints, parameters).size(),
+    recordedWayPoints.size());
+
+  parameters.speedTolerance = 0.05;
+  auto indexes = romea::core::findSimplifiedWayPointIndexes(recordedWayPoints, parameters);
+  EXPECT_LT(indexes.size() * 3, recordedWayPoints.size() * 2);
+  for (size_t i = 0; i + 1 < indexes.size(); ++i) {
+    for (size_t n = indexes[i] + 1; n < indexes[i + 1]; ++n) {
+      double speed = recordedWayPoints[n].desired_speed;
+      EXPECT_LE(std::abs(speed - recordedWayPoints[indexes[i]].desired_speed), 0.05);
+      EXPECT_LE(std::abs(speed - recordedWayPoints[indexes[i + 1]].desired_speed), 0.05);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathSimplification, simplifiedPathKeepsSectionsAnnotationsAndMatching)
+{
+  romea::core::Path2D::WayPoints pathWayPoints(3);
+  pathWayPoints[0] = loadWayPoints("/path11.txt");
+  pathWayPoints[1] = loadWayPoints("/path12.txt");
+  pathWayPoints[2] = loadWayPoints("/path13.txt");
+
+  size_t annotatedIndex = pathWayPoints[0].size() + pathWayPoints[1].size() + 42;
+  nlohmann::json data;
+  data["type"] = "zone_enter";
+  data["value"] = "headland";
+  data["point_index"] = annotatedIndex;
+  romea::core::Path2D::Annotations annotations;
+  annotations.emplace(annotatedIndex, romea::core::PathAnnotation(data));
+
+  romea::core::Path2D path(pathWayPoints, 3, annotations);
+  auto simplifiedPath = romea::core::simplifyPath(
+    pathWayPoints, romea::core::PathSimplificationParameters(), 3, annotations);
+  ASSERT_EQ(simplifiedPath.size(), path.size());
+  for (size_t i = 0; i < path.size(); ++i) {
+    EXPECT_LE(simplifiedPath.getSection(i).size(), path.getSection(i).size());
+  }
+
+  ASSERT_EQ(simplifiedPath.getAnnotations().size(), 1);
+  const auto & [index, annotation] = *simplifiedPath.getAnnotations().begin();
+  EXPECT_EQ(annotation.point_index, index);
+  const auto & section = simplifiedPath.getSection(2);
+  size_t localIndex = index - section.getInitialPointIndex();
+  EXPECT_EQ(section.getX()[localIndex], pathWayPoints[2][42].position.x());
+  EXPECT_EQ(section.getY()[localIndex], pathWayPoints[2][42].position.y());
+
+  romea::core::Pose2D vehiclePose;
+  vehiclePose.position = Eigen::Vector2d(18.3, -4);
+  vehiclePose.yaw = 0.278;
+  auto matchedPoints = romea::core::match(path, vehiclePose, 1., 0.2, 10);
+  auto simplifiedMatchedPoints = romea::core::match(simplifiedPath, vehiclePose, 1., 0.2, 10);
+  ASSERT_EQ(simplifiedMatchedPoints.size(), matchedPoints.size());
+  ASSERT_FALSE(matchedPoints.empty());
+  EXPECT_NEAR(
+    simplifiedMatchedPoints[0].frenetPose.lateralDeviation,
+    matchedPoints[0].frenetPose.lateralDeviation, 1e-2);
+  EXPECT_NEAR(
+    simplifiedMatchedPoints[0].frenetPose.curvilinearAbscissa,
+    matchedPoints[0].frenetPose.curvilinearAbscissa, 1e-2);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,169 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+// posix
+#include <sys/wait.h>
+#include <unistd.h>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_core_path/PathMatching2D.hpp"
+#include "romea_core_path/PathVersionedCache.hpp"
+
+// local
+#include "../test/test_helper.h"
+#include "test_utils.hpp"
+
+
+class TestPathVersionedCache : public ::testing::Test
+{
+public:
+  TestPathVersionedCache() {}
+
+  void SetUp() override
+  {
+    name = ::testing::TempDir() + "romea_path_cache_" + std::to_string(getpid());
+    removeFiles();
+
+    Path2D::WayPoints wayPoints(3);
+    wayPoints[0] = loadWayPoints("/path11.txt");
+    wayPoints[1] = loadWayPoints("/path12.txt");
+    wayPoints[2] = loadWayPoints("/path13.txt");
+    path = std::make_unique<Path2D>(wayPoints, 3);
+
+    Path2D::WayPoints shortWayPoints(1);
+    shortWayPoints[0] = loadWayPoints("/path11.txt");
+    shortPath = std::make_unique<Path2D>(shortWayPoints, 3);
+  }
+
+  void TearDown() override
+  {
+    removeFiles();
+  }
+
+  void removeFiles()
+  {
+    std::remove(name.c_str());
+    for (int generation = 1; generation <= 5; ++generation) {
+      std::remove((name + "." + std::to_string(generation)).c_str());
+    }
+  }
+
+  using Path2D = romea::core::Path2D;
+
+  std::string name;
+  std::unique_ptr<Path2D> path;
+  std::unique_ptr<Path2D> shortPath;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathVersionedCache, readerWaitsForTheFirstPublication)
+{
+  romea::core::PathVersionedCacheReader reader(name);
+  std::uint64_t generation = 0;
+  EXPECT_EQ(reader.getGeneration(), 0);
+  EXPECT_FALSE(reader.load(generation).has_value());
+
+  romea::core::PathVersionedCacheWriter writer(name);
+  EXPECT_EQ(reader.getGeneration(), 0);
+  EXPECT_FALSE(reader.loadIfUpdated(generation).has_value());
+
+  EXPECT_EQ(writer.publish(*path), 1);
+  auto loaded = reader.loadIfUpdated(generation);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(generation, 1);
+  EXPECT_EQ(loaded->size(), path->size());
+  EXPECT_DOUBLE_EQ(loaded->getLength(), path->getLength());
+
+  romea::core::Pose2D vehiclePose;
+  vehiclePose.position.x() = 18.3;
+  vehiclePose.position.y() = -4;
+  vehiclePose.yaw = 0.278;
+  auto matchedPoints = romea::core::match(*path, vehiclePose, 0.8, 0.2, 10);
+  auto loadedMatchedPoints = romea::core::match(*loaded, vehiclePose, 0.8, 0.2, 10);
+  ASSERT_EQ(loadedMatchedPoints.size(), matchedPoints.size());
+  ASSERT_FALSE(matchedPoints.empty());
+  EXPECT_EQ(loadedMatchedPoints[0].curveIndex, matchedPoints[0].curveIndex);
+  EXPECT_DOUBLE_EQ(loadedMatchedPoints[0].frenetPose.lateralDeviation,
+    matchedPoints[0].frenetPose.lateralDeviation);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathVersionedCache, generationCounterSwapsPaths)
+{
+  romea::core::PathVersionedCacheWriter writer(name);
+  romea::core::PathVersionedCacheReader reader(name);
+
+  std::uint64_t generation = 0;
+  writer.publish(*path);
+  ASSERT_TRUE(reader.loadIfUpdated(generation).has_value());
+  EXPECT_FALSE(reader.loadIfUpdated(generation).has_value());
+
+  EXPECT_EQ(writer.publish(*shortPath), 2);
+  auto swapped = reader.loadIfUpdated(generation);
+  ASSERT_TRUE(swapped.has_value());
+  EXPECT_EQ(generation, 2);
+  EXPECT_EQ(swapped->size(), 1);
+
+  // only the last two generations are kept
+  writer.publish(*path);
+  EXPECT_EQ(access((name + ".1").c_str(), F_OK), -1);
+  EXPECT_EQ(access((name + ".2").c_str(), F_OK), 0);
+
+  // a restarted writer goes on from the last generation
+  romea::core::PathVersionedCacheWriter restartedWriter(name);
+  EXPECT_EQ(restartedWriter.getGeneration(), 3);
+  EXPECT_EQ(restartedWriter.publish(*shortPath), 4);
+  EXPECT_EQ(reader.getGeneration(), 4);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPathVersionedCache, pathIsPublishedToAnotherProcess)
+{
+  pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    romea::core::PathVersionedCacheWriter writer(name);
+    writer.publish(*path);
+    _exit(0);
+  }
+
+  int status;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(WEXITSTATUS(status), 0);
+
+  romea::core::PathVersionedCacheReader reader(name);
+  std::uint64_t generation = 0;
+  auto loaded = reader.load(generation);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(generation, 1);
+  EXPECT_EQ(loaded->size(), path->size());
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
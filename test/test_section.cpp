@@ -14,6 +14,7 @@
 
 // std
 #include <memory>
+#include <vector>
 
 // gtest
 #include "gtest/gtest.h"
@@ -96,6 +97,71 @@ TEST_F(TestSection, testFindNearestIndex)
   EXPECT_EQ(section->findIndex(42.36, 0), 430);
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestSection, bulkAndPointByPointSectionsAreEqual)
+{
+  auto wayPoints = loadWayPoints("/section.txt");
+  romea::core::PathSection2D pointByPointSection(3, 12.5, 7);
+  for (const auto & wayPoint : wayPoints) {
+    pointByPointSection.addWayPoint(wayPoint);
+  }
+
+  std::vector<double> X, Y, speeds;
+  for (const auto & wayPoint : wayPoints) {
+    X.push_back(wayPoint.position.x());
+    Y.push_back(wayPoint.position.y());
+    speeds.push_back(wayPoint.desired_speed);
+  }
+  romea::core::PathSection2D bulkSection(3, 12.5, 7);
+  bulkSection.addWayPoints(X.data(), Y.data(), speeds.data(), X.size());
+
+  EXPECT_EQ(bulkSection.getX(), pointByPointSection.getX());
+  EXPECT_EQ(bulkSection.getY(), pointByPointSection.getY());
+  EXPECT_EQ(bulkSection.getSpeeds(), pointByPointSection.getSpeeds());
+  EXPECT_EQ(
+    bulkSection.getCurvilinearAbscissa().data(),
+    pointByPointSection.getCurvilinearAbscissa().data());
+  EXPECT_EQ(bulkSection.getLength(), pointByPointSection.getLength());
+  EXPECT_EQ(bulkSection.getUniformStep(), pointByPointSection.getUniformStep());
+  EXPECT_EQ(
+    bulkSection.getSegmentTree().getDirections(),
+    pointByPointSection.getSegmentTree().getDirections());
+  EXPECT_EQ(bulkSection.getBoundingBox().min(), pointByPointSection.getBoundingBox().min());
+  EXPECT_EQ(bulkSection.getBoundingBox().max(), pointByPointSection.getBoundingBox().max());
+  EXPECT_EQ(bulkSection.size(), pointByPointSection.size());
+  EXPECT_TRUE(
+    (bulkSection.getCurve(100).getXPolynomCoefficients() ==
+    pointByPointSection.getCurve(100).getXPolynomCoefficients()).all());
+
+  // appended to a non empty section
+  romea::core::PathSection2D appendedSection(3, 12.5, 7);
+  appendedSection.addWayPoint(wayPoints[0]);
+  appendedSection.addWayPoints(X.data() + 1, Y.data() + 1, speeds.data() + 1, X.size() - 1);
+  EXPECT_EQ(
+    appendedSection.getCurvilinearAbscissa().data(),
+    pointByPointSection.getCurvilinearAbscissa().data());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestUniformSection, bulkSectionKeepsTheUniformStep)
+{
+  std::vector<romea::core::PathWayPoint2D> wayPoints;
+  for (size_t n = 0; n < 100; ++n) {
+    wayPoints.emplace_back(Eigen::Vector2d(0.25 * n, 1.), 1.);
+  }
+  wayPoints.emplace_back(Eigen::Vector2d(24.85, 1.), 1.);
+
+  romea::core::PathSection2D section(3.);
+  section.addWayPoints(wayPoints);
+  EXPECT_EQ(section.getUniformStep(), 0.25);
+  EXPECT_EQ(section.findIndex(10.1), 41);
+
+  wayPoints.emplace_back(Eigen::Vector2d(25., 1.), 1.);
+  romea::core::PathSection2D irregularSection(3.);
+  irregularSection.addWayPoints(wayPoints);
+  EXPECT_EQ(irregularSection.getUniformStep(), 0.);
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
 {
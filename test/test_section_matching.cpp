@@ -332,6 +332,96 @@ TEST_F(TestSectionMatching, invertedRobotOrientationAtTheClosestPointNegativeSpe
   EXPECT_GT(matchedPoint->frenetPose.lateralDeviation, 1.);
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestSectionMatching, covariancePropagationCanBeSkipped)
+{
+  romea::core::Pose2D vehiclePose;
+  vehiclePose.position.x() = -8.2;
+  vehiclePose.position.y() = 16.1;
+  vehiclePose.yaw = 120 / 180. * M_PI;
+  vehiclePose.covariance = Eigen::Vector3d(0.1, 0.2, 0.05).asDiagonal();
+
+  auto matchedPoint = match(*path, vehiclePose, 0., time_horizon, maximalRadiusResearch);
+  auto lightMatchedPoint =
+    match(*path, vehiclePose, 0., time_horizon, maximalRadiusResearch, false);
+
+  ASSERT_TRUE(matchedPoint.has_value());
+  ASSERT_TRUE(lightMatchedPoint.has_value());
+  EXPECT_FALSE(matchedPoint->frenetPose.covariance.isZero());
+  EXPECT_TRUE(lightMatchedPoint->frenetPose.covariance.isZero());
+  EXPECT_NEAR(
+    matchedPoint->frenetPose.covariance.trace(), vehiclePose.covariance.trace(), 1e-12);
+
+  const size_t & curveIndex = matchedPoint->curveIndex;
+  romea::core::PathCompactFrenetPose2D frenetPose;
+  ASSERT_TRUE(
+    match(path->getCurve(curveIndex), vehiclePose, path->getSpeeds()[curveIndex], frenetPose));
+  EXPECT_DOUBLE_EQ(frenetPose.curvilinearAbscissa, matchedPoint->frenetPose.curvilinearAbscissa);
+  EXPECT_DOUBLE_EQ(frenetPose.lateralDeviation, matchedPoint->frenetPose.lateralDeviation);
+  EXPECT_DOUBLE_EQ(frenetPose.courseDeviation, matchedPoint->frenetPose.courseDeviation);
+
+  auto reversedFrenetPose = reverse(frenetPose);
+  auto expectedReversedFrenetPose = reverse(matchedPoint->frenetPose);
+  EXPECT_DOUBLE_EQ(reversedFrenetPose.lateralDeviation, expectedReversedFrenetPose.lateralDeviation);
+  EXPECT_DOUBLE_EQ(reversedFrenetPose.courseDeviation, expectedReversedFrenetPose.courseDeviation);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSectionMatching, outwardSearchFindsTheScannedCandidate)
+{
+  const auto & S = path->getCurvilinearAbscissa();
+  for (size_t n = 1; n + 1 < path->size(); n += 7) {
+    romea::core::Pose2D vehiclePose;
+    double yaw = std::atan2(
+      path->getY()[n + 1] - path->getY()[n - 1], path->getX()[n + 1] - path->getX()[n - 1]);
+    vehiclePose.position.x() = path->getX()[n] - 0.2 * std::sin(yaw);
+    vehiclePose.position.y() = path->getY()[n] + 0.2 * std::cos(yaw);
+    vehiclePose.yaw = yaw;
+
+    // the previous curve index lags a few points behind the vehicle
+    size_t previousCurveIndex = n > 3 ? n - 3 : 0;
+    romea::core::Interval<double> interval(S[n] - 5., S[n] + 5.);
+
+    auto expected = match(
+      *path, vehiclePose, 1., previousCurveIndex, interval, time_horizon, maximalRadiusResearch);
+    auto matchedPoint = match(
+      *path, vehiclePose, 1., previousCurveIndex, interval, time_horizon, maximalRadiusResearch,
+      true, true);
+
+    ASSERT_EQ(matchedPoint.has_value(), expected.has_value());
+    if (expected.has_value()) {
+      EXPECT_EQ(matchedPoint->curveIndex, expected->curveIndex);
+      EXPECT_DOUBLE_EQ(
+        matchedPoint->frenetPose.curvilinearAbscissa, expected->frenetPose.curvilinearAbscissa);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSectionMatching, outwardSearchOnUturnSkipsTheOtherLine)
+{
+  auto uturnPath = makeUturnPath(1.);
+  const auto & section = uturnPath->getSection(0);
+
+  // vehicle on the return line, the outgoing line is 2 m away
+  romea::core::Pose2D vehiclePose;
+  vehiclePose.position = Eigen::Vector2d(1.05, 2.1);
+  vehiclePose.yaw = M_PI;
+  size_t previousCurveIndex = section.size() - 12;
+  romea::core::Interval<double> interval(0., section.getLength());
+
+  auto expected = match(
+    section, vehiclePose, 1., previousCurveIndex, interval, time_horizon, maximalRadiusResearch);
+  auto matchedPoint = match(
+    section, vehiclePose, 1., previousCurveIndex, interval, time_horizon, maximalRadiusResearch,
+    true, true);
+
+  ASSERT_TRUE(expected.has_value());
+  ASSERT_TRUE(matchedPoint.has_value());
+  EXPECT_EQ(matchedPoint->curveIndex, expected->curveIndex);
+  EXPECT_NEAR(matchedPoint->pathPosture.position.y(), 2., 1e-3);
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
 {
@@ -0,0 +1,139 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <random>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// romea
+#include "romea_core_path/Path2D.hpp"
+#include "romea_core_path/PathMatching2D.hpp"
+#include "romea_core_path/PathSectionTree2D.hpp"
+
+//-----------------------------------------------------------------------------
+std::vector<size_t> findSectionsByScan(
+  const romea::core::PathSectionTree2D::Boxes & boxes,
+  const Eigen::Vector2d & position,
+  const double & researchRadius)
+{
+  std::vector<size_t> sectionIndexes;
+  for (size_t n = 0; n < boxes.size(); ++n) {
+    if (boxes[n].squaredExteriorDistance(position) < researchRadius * researchRadius) {
+      sectionIndexes.push_back(n);
+    }
+  }
+  return sectionIndexes;
+}
+
+//-----------------------------------------------------------------------------
+// Vineyard like path: parallel rows linked by short headland turns
+romea::core::Path2D::WayPoints makeRows(size_t numberOfRows)
+{
+  romea::core::Path2D::WayPoints wayPoints;
+  for (size_t row = 0; row < numberOfRows; ++row) {
+    double x = 2.5 * row;
+    bool up = row % 2 == 0;
+    wayPoints.emplace_back();
+    for (size_t n = 0; n <= 200; ++n) {
+      double y = up ? 0.5 * n : 100. - 0.5 * n;
+      wayPoints.back().emplace_back(Eigen::Vector2d(x, y), 1.);
+    }
+    wayPoints.emplace_back();
+    for (size_t n = 1; n < 10; ++n) {
+      double angle = M_PI * n / 10.;
+      double y = up ? 100. + 1.25 * std::sin(angle) : -1.25 * std::sin(angle);
+      wayPoints.back().emplace_back(
+        Eigen::Vector2d(x + 1.25 - 1.25 * std::cos(angle), y), 1.);
+    }
+  }
+  return wayPoints;
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSectionTree, sameSectionsAsScan)
+{
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> coordinate(0., 500.);
+  std::uniform_real_distribution<double> extent(0., 20.);
+
+  romea::core::PathSectionTree2D::Boxes boxes;
+  for (size_t n = 0; n < 1000; ++n) {
+    Eigen::Vector2d corner(coordinate(generator), coordinate(generator));
+    boxes.emplace_back(corner, corner + Eigen::Vector2d(extent(generator), extent(generator)));
+  }
+  boxes.emplace_back();
+
+  romea::core::PathSectionTree2D tree(boxes);
+  ASSERT_EQ(tree.size(), boxes.size());
+
+  std::vector<size_t> sectionIndexes;
+  for (size_t n = 0; n < 500; ++n) {
+    Eigen::Vector2d position(coordinate(generator), coordinate(generator));
+    double radius = n % 2 ? 1. : 30.;
+    tree.findSections(position, radius, sectionIndexes);
+    EXPECT_EQ(sectionIndexes, findSectionsByScan(boxes, position, radius));
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSectionTree, pathFindsNearbySections)
+{
+  romea::core::Path2D path(makeRows(50), 3);
+
+  std::vector<size_t> sectionIndexes;
+  path.findNearbySections(Eigen::Vector2d(25.1, 50.), 1., sectionIndexes);
+  EXPECT_EQ(sectionIndexes, std::vector<size_t>({20}));
+
+  path.findNearbySections(Eigen::Vector2d(1000., 50.), 10., sectionIndexes);
+  EXPECT_TRUE(sectionIndexes.empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSectionTree, addedSectionsAreStillFound)
+{
+  romea::core::Path2D path(makeRows(2), 3);
+  auto & section = path.addEmptySection();
+  section.addWayPoint(romea::core::PathWayPoint2D(Eigen::Vector2d(200., 0.), 1.));
+  section.addWayPoint(romea::core::PathWayPoint2D(Eigen::Vector2d(200., 1.), 1.));
+
+  std::vector<size_t> sectionIndexes;
+  path.findNearbySections(Eigen::Vector2d(200., 0.5), 1., sectionIndexes);
+  EXPECT_EQ(sectionIndexes, std::vector<size_t>({4}));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSectionTree, globalMatchingOnManyRows)
+{
+  romea::core::Path2D path(makeRows(200), 3);
+
+  romea::core::Pose2D vehiclePose;
+  vehiclePose.position = Eigen::Vector2d(2.5 * 121 + 0.1, 40.);
+  vehiclePose.yaw = -M_PI_2;
+
+  auto matchedPoints = romea::core::match(path, vehiclePose, 1., 0.2, 2.);
+  ASSERT_EQ(matchedPoints.size(), 1u);
+  EXPECT_EQ(matchedPoints.front().sectionIndex, 242u);
+  EXPECT_NEAR(matchedPoints.front().frenetPose.lateralDeviation, 0.1, 1e-6);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
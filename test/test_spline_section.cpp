@@ -0,0 +1,209 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <memory>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_core_path/PathSectionMatching2D.hpp"
+
+// local
+#include "../test/test_helper.h"
+#include "test_utils.hpp"
+
+class TestSplineSection : public ::testing::Test
+{
+public:
+  TestSplineSection()
+  : maximalRadiusResearch(10),
+    time_horizon(1)
+  {
+  }
+
+  void SetUp() override
+  {
+    auto wayPoints = loadWayPoints("/section.txt");
+    section = std::make_unique<romea::core::PathSection2D>(3);
+    section->addWayPoints(wayPoints);
+    splineSection = std::make_unique<romea::core::PathSplineSection2D>();
+    splineSection->addWayPoints(wayPoints);
+  }
+
+  std::unique_ptr<romea::core::PathSection2D> section;
+  std::unique_ptr<romea::core::PathSplineSection2D> splineSection;
+  double maximalRadiusResearch;
+  double time_horizon;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSplineSection, splineInterpolatesWayPoints)
+{
+  ASSERT_EQ(splineSection->size(), section->size());
+  EXPECT_DOUBLE_EQ(splineSection->getLength(), section->getLength());
+
+  const auto & spline = splineSection->getSpline();
+  ASSERT_EQ(spline.size(), section->size() - 1);
+
+  for (size_t n = 0; n < splineSection->size(); ++n) {
+    double s = splineSection->getCurvilinearAbscissa()[n];
+    EXPECT_DOUBLE_EQ(s, section->getCurvilinearAbscissa()[n]);
+
+    size_t segmentIndex = spline.findSegmentIndex(s, n);
+    EXPECT_EQ(segmentIndex, spline.findSegmentIndex(s));
+
+    Eigen::Vector2d position = spline.computePosition(s, segmentIndex);
+    EXPECT_NEAR(position.x(), splineSection->getX()[n], 1e-9);
+    EXPECT_NEAR(position.y(), splineSection->getY()[n], 1e-9);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSplineSection, splineIsSecondOrderContinuous)
+{
+  const auto & spline = splineSection->getSpline();
+  const auto & knots = spline.getKnots();
+
+  for (size_t i = 1; i < spline.size(); ++i) {
+    EXPECT_NEAR(
+      spline.computeTangent(knots[i], i - 1),
+      spline.computeTangent(knots[i], i), 1e-9);
+    EXPECT_NEAR(
+      spline.computeCurvature(knots[i], i - 1),
+      spline.computeCurvature(knots[i], i), 1e-6);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSplineSection, curvatureOfCircle)
+{
+  double radius = 6.;
+  romea::core::PathSplineSection2D circle;
+  for (double a = 0.; a < M_PI; a += 0.1 / radius) {
+    circle.addWayPoint({Eigen::Vector2d{radius * std::cos(a), radius * std::sin(a)}});
+  }
+
+  const auto & spline = circle.getSpline();
+  double s = radius * M_PI_2;
+  size_t segmentIndex = spline.findSegmentIndex(s);
+  EXPECT_NEAR(spline.computeCurvature(s, segmentIndex), 1 / radius, 1e-4);
+  EXPECT_NEAR(std::abs(spline.computeTangent(s, segmentIndex)), M_PI, 1e-4);
+
+  auto nearest = spline.findNearestCurvilinearAbscissa(
+    Eigen::Vector2d(0., radius + 1.),
+    romea::core::Interval<size_t>(segmentIndex - 2, segmentIndex + 2));
+  ASSERT_TRUE(nearest.has_value());
+  EXPECT_NEAR(*nearest, s, 1e-3);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSplineSection, repeatedWayPointsKeepTheSplineFinite)
+{
+  romea::core::PathSplineSection2D circle;
+  romea::core::PathSplineSection2D circleWithRepetitions;
+  for (double a = 0.; a < M_PI; a += 0.1 / 6.) {
+    romea::core::PathWayPoint2D wayPoint(Eigen::Vector2d{6. * std::cos(a), 6. * std::sin(a)});
+    circle.addWayPoint(wayPoint);
+    circleWithRepetitions.addWayPoint(wayPoint);
+    if (circleWithRepetitions.size() % 10 == 1) {
+      circleWithRepetitions.addWayPoint(wayPoint);
+      circleWithRepetitions.addWayPoint(wayPoint);
+    }
+  }
+
+  const auto & spline = circle.getSpline();
+  const auto & splineWithRepetitions = circleWithRepetitions.getSpline();
+  ASSERT_EQ(splineWithRepetitions.size(), circleWithRepetitions.size() - 1);
+  for (double s = 0.; s < circle.getLength(); s += 0.05) {
+    size_t i = spline.findSegmentIndex(s);
+    size_t j = splineWithRepetitions.findSegmentIndex(s);
+    Eigen::Vector2d position = spline.computePosition(s, i);
+    Eigen::Vector2d positionWithRepetitions = splineWithRepetitions.computePosition(s, j);
+    EXPECT_NEAR(positionWithRepetitions.x(), position.x(), 1e-9);
+    EXPECT_NEAR(positionWithRepetitions.y(), position.y(), 1e-9);
+    EXPECT_NEAR(
+      splineWithRepetitions.computeCurvature(s, j), spline.computeCurvature(s, i), 1e-9);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSplineSection, testGlobalMatchingCloseToSection)
+{
+  romea::core::Pose2D vehiclePose;
+  vehiclePose.position.x() = -8.2;
+  vehiclePose.position.y() = 16.1;
+  vehiclePose.yaw = 120 / 180. * M_PI;
+  double vehicleSpeed = 0;
+
+  auto matchedPoint = match(
+    *section, vehiclePose, vehicleSpeed, time_horizon, maximalRadiusResearch);
+  auto splineMatchedPoint = match(
+    *splineSection, vehiclePose, vehicleSpeed, time_horizon, maximalRadiusResearch);
+
+  ASSERT_EQ(matchedPoint.has_value(), true);
+  ASSERT_EQ(splineMatchedPoint.has_value(), true);
+
+  // the spline interpolates the recorded way points while the curves smooth them
+  // over the interpolation window, so the course is a bit noisier
+  EXPECT_NEAR(
+    splineMatchedPoint->pathPosture.position.x(), matchedPoint->pathPosture.position.x(), 0.01);
+  EXPECT_NEAR(
+    splineMatchedPoint->pathPosture.position.y(), matchedPoint->pathPosture.position.y(), 0.01);
+  EXPECT_NEAR(splineMatchedPoint->pathPosture.course, matchedPoint->pathPosture.course, 0.05);
+  EXPECT_NEAR(
+    splineMatchedPoint->frenetPose.curvilinearAbscissa,
+    matchedPoint->frenetPose.curvilinearAbscissa, 0.01);
+  EXPECT_NEAR(
+    splineMatchedPoint->frenetPose.lateralDeviation,
+    matchedPoint->frenetPose.lateralDeviation, 0.01);
+  EXPECT_EQ(splineMatchedPoint->curveIndex, matchedPoint->curveIndex);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSplineSection, testLocalMatchingCloseToSection)
+{
+  romea::core::Pose2D firstVehiclePose;
+  firstVehiclePose.position.x() = -8.2;
+  firstVehiclePose.position.y() = 16.1;
+  firstVehiclePose.yaw = 120 / 180. * M_PI;
+
+  romea::core::Pose2D secondVehiclePose;
+  secondVehiclePose.position.x() = -9.3;
+  secondVehiclePose.position.y() = 17.2;
+  secondVehiclePose.yaw = 130 / 180. * M_PI;
+
+  auto firstMatchedPoint = match(
+    *splineSection, firstVehiclePose, 1., time_horizon, maximalRadiusResearch);
+  ASSERT_EQ(firstMatchedPoint.has_value(), true);
+
+  auto secondMatchedPoint = match(
+    *splineSection, secondVehiclePose, 1., *firstMatchedPoint, 10.,
+    time_horizon, maximalRadiusResearch);
+
+  ASSERT_EQ(secondMatchedPoint.has_value(), true);
+  EXPECT_NEAR(secondMatchedPoint->pathPosture.position.x(), -9.41664, 0.01);
+  EXPECT_NEAR(secondMatchedPoint->pathPosture.position.y(), 16.9346, 0.01);
+  EXPECT_NEAR(secondMatchedPoint->frenetPose.curvilinearAbscissa, 18.5847, 0.01);
+  EXPECT_NEAR(secondMatchedPoint->frenetPose.lateralDeviation, -0.289936, 0.01);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,151 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// romea
+#include "romea_core_path/Path2D.hpp"
+#include "romea_core_path/PathFile.hpp"
+#include "romea_core_path/PathMatchingReplay.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+void printUsage(const char * program)
+{
+  std::cerr <<
+    "usage: " << program << " PATH_FILE POSE_LOG [options]\n"
+    "  PATH_FILE                  path file (.txt or .traj)\n"
+    "  POSE_LOG                   csv (stamp,x,y,yaw,speed) or .bin pose log\n"
+    "options:\n"
+    "  --output FILE              write the matched frenet poses as csv\n"
+    "  --window LENGTH            interpolation window length (default 3)\n"
+    "  --horizon SECONDS          time horizon of the future curvature (default 0.2)\n"
+    "  --radius DISTANCE          research radius (default 10)\n"
+    "  --repeat N                 replay the log N times (default 1)\n"
+    "  --warm-start 0|1           newton steps before the tracked match (default 1)\n"
+    "  --outward-search 0|1       search candidates outward from the previous one (default 0)\n"
+    "  --max-match-losses N       fail when more match losses are reported\n"
+    "  --max-p99-us MICROSECONDS  fail when the p99 latency is higher\n";
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  if (argc < 3) {
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  std::string pathFilename = argv[1];
+  std::string logFilename = argv[2];
+  std::string outputFilename;
+  double interpolationWindowLength = 3;
+  size_t repeat = 1;
+  size_t maximalMatchLosses = std::numeric_limits<size_t>::max();
+  double maximalP99Microseconds = std::numeric_limits<double>::infinity();
+  romea::core::MatchingReplayParameters parameters;
+
+  try {
+    for (int i = 3; i < argc; ++i) {
+      std::string option = argv[i];
+      if (i + 1 == argc) {
+        throw std::invalid_argument("missing value for " + option);
+      }
+
+      std::string value = argv[++i];
+      if (option == "--output") {
+        outputFilename = value;
+      } else if (option == "--window") {
+        interpolationWindowLength = std::stod(value);
+      } else if (option == "--horizon") {
+        parameters.timeHorizon = std::stod(value);
+      } else if (option == "--radius") {
+        parameters.researchRadius = std::stod(value);
+      } else if (option == "--warm-start") {
+        parameters.newtonWarmStart = std::stoi(value) != 0;
+      } else if (option == "--outward-search") {
+        parameters.outwardCandidateSearch = std::stoi(value) != 0;
+      } else if (option == "--repeat") {
+        repeat = std::stoul(value);
+      } else if (option == "--max-match-losses") {
+        maximalMatchLosses = std::stoul(value);
+      } else if (option == "--max-p99-us") {
+        maximalP99Microseconds = std::stod(value);
+      } else {
+        throw std::invalid_argument("unknown option " + option);
+      }
+    }
+  } catch (const std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  try {
+    romea::core::Path2D path(
+      romea::core::PathFile(pathFilename), interpolationWindowLength);
+    romea::core::PoseLog log = romea::core::loadPoseLog(logFilename);
+
+    romea::core::MatchingReplayResult result;
+    for (size_t n = 0; n < repeat; ++n) {
+      auto replay = romea::core::replayMatching(path, log, parameters);
+      result.latencyNanoseconds.insert(
+        result.latencyNanoseconds.end(),
+        replay.latencyNanoseconds.begin(),
+        replay.latencyNanoseconds.end());
+      result.matchedPoints = std::move(replay.matchedPoints);
+      result.matchLosses = std::move(replay.matchLosses);
+    }
+
+    auto statistics = romea::core::computeStatistics(result);
+    std::cout << "poses: " << log.size() << " x " << repeat << "\n";
+    std::cout << "throughput: " << statistics.matchesPerSecond << " matches/s\n";
+    std::cout << "latency p50: " << statistics.p50Nanoseconds / 1000. << " us\n";
+    std::cout << "latency p99: " << statistics.p99Nanoseconds / 1000. << " us\n";
+    std::cout << "latency max: " << statistics.maximalNanoseconds / 1000. << " us\n";
+    std::cout << "match losses: " << statistics.numberOfMatchLosses << "\n";
+    for (const auto & index : result.matchLosses) {
+      std::cout << "  lost at stamp " << log[index].stamp << " (record " << index << ")\n";
+    }
+
+    if (!outputFilename.empty()) {
+      romea::core::saveMatchedFrenetPoses(outputFilename, log, result);
+    }
+
+    if (statistics.numberOfMatchLosses > maximalMatchLosses) {
+      std::cerr << "too many match losses" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (statistics.p99Nanoseconds / 1000. > maximalP99Microseconds) {
+      std::cerr << "p99 latency above " << maximalP99Microseconds << " us" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch (const std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}